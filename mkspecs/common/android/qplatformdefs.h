@@ -79,6 +79,7 @@
 #define QT_STAT                 ::stat
 #define QT_FSTAT                ::fstat
 #define QT_LSTAT                ::lstat
+#define QT_FSTATAT              ::fstatat
 #define QT_OPEN                 ::open
 #define QT_TRUNCATE             ::truncate
 #define QT_FTRUNCATE            ::ftruncate
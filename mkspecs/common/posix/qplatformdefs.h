@@ -56,6 +56,7 @@
 
 #define QT_STAT                 ::stat64
 #define QT_LSTAT                ::lstat64
+#define QT_FSTATAT              ::fstatat64
 #define QT_TRUNCATE             ::truncate64
 
 // File I/O
@@ -81,6 +82,7 @@
 
 #define QT_STAT                 ::stat
 #define QT_LSTAT                ::lstat
+#define QT_FSTATAT              ::fstatat
 #define QT_TRUNCATE             ::truncate
 
 // File I/O
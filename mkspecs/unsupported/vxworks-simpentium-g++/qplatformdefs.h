@@ -56,6 +56,7 @@
 #undef QT_SOCKET_CONNECT
 
 #define QT_LSTAT                QT_STAT
+#define QT_FSTATAT              ::fstatat
 #define QT_MKDIR(dir, perm)     ::mkdir(dir)
 
 #define QT_READ(fd, buf, len)   ::read(fd, (char*) buf, len)
@@ -85,6 +85,7 @@
 #define QT_STAT                 ::stat64
 #define QT_FSTAT                ::fstat64
 #define QT_LSTAT                ::lstat64
+#define QT_FSTATAT              ::fstatat64
 #define QT_OPEN                 ::open64
 #define QT_TRUNCATE             ::truncate64
 #define QT_FTRUNCATE            ::ftruncate64
@@ -95,6 +96,7 @@
 #define QT_STAT                 ::stat
 #define QT_FSTAT                ::fstat
 #define QT_LSTAT                ::lstat
+#define QT_FSTATAT              ::fstatat
 #define QT_OPEN                 ::open
 #define QT_TRUNCATE             ::truncate
 #define QT_FTRUNCATE            ::ftruncate
@@ -181,6 +181,27 @@ std::filesystem::copy(
 "# FIXME: qmake: CONFIG += c++17
 )
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"
+#include <sys/epoll.h>
+
+int main(int argc, char **argv)
+{
+    (void)argc; (void)argv;
+    /* BEGIN TEST: */
+struct epoll_event ev = {};
+ev.events = EPOLLIN;
+int fd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # eventfd
 qt_config_compile_test(eventfd
     LABEL "eventfd"
@@ -307,6 +328,29 @@ inotify_rm_watch(0, 1);
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(int argc, char **argv)
+{
+    (void)argc; (void)argv;
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+int fd = syscall(__NR_io_uring_setup, 8, &params);
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_READ;
+syscall(__NR_io_uring_enter, fd, 1, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # ipc_sysv
 qt_config_compile_test(ipc_sysv
     LABEL "SysV IPC"
@@ -561,6 +605,10 @@ qt_feature("cxx17_filesystem" PUBLIC
     LABEL "C++17 <filesystem>"
     CONDITION TEST_cxx17_filesystem
 )
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("eventfd" PUBLIC
     LABEL "eventfd"
     CONDITION NOT WASM AND TEST_eventfd
@@ -603,6 +651,10 @@ qt_feature("inotify" PUBLIC PRIVATE
     CONDITION TEST_inotify
 )
 qt_feature_definition("inotify" "QT_NO_INOTIFY" NEGATE VALUE "1")
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND TEST_io_uring
+)
 qt_feature("ipc_posix"
     LABEL "Using POSIX IPC"
     AUTODETECT NOT WIN32
@@ -83,3 +83,19 @@ void printError(const char* msg)
 //! [4]
 CONFIG += console
 //! [4]
+
+
+//! [5]
+QList<QFile *> files;
+for (const QString &fileName : fileNames) {
+    auto file = new QFile(fileName, this);
+    if (file->open(QIODevice::ReadOnly))
+        files.append(file);
+}
+
+auto watcher = new QFutureWatcher<QByteArray>(this);
+connect(watcher, &QFutureWatcher<QByteArray>::resultReadyAt, this, [=](int index) {
+    loadAsset(files.at(index)->fileName(), watcher->resultAt(index));
+});
+watcher->setFuture(QFile::readAllAsync(files));
+//! [5]
@@ -355,4 +355,22 @@ QString wildcard = QRegularExpression::wildcardToRegularExpression("*.jpeg");
     ("", "day", "month", "year", "", "name")
 //! [33]
 
+{
+//! [34]
+// the status code of each line of an access log
+QRegularExpression re("\" (\\d{3}) ");
+QList<QStringView> lines = ...;
+QList<qsizetype> starts(lines.size() * 2);
+QList<qsizetype> lengths(lines.size() * 2);
+re.matchBatch(lines.constData(), lines.size(), starts.data(), lengths.data(), 2,
+              QRegularExpression::NoMatchOption, QThreadPool::globalInstance());
+for (qsizetype i = 0; i < lines.size(); ++i) {
+    if (starts[i * 2 + 1] != -1) {
+        QStringView status = lines[i].mid(starts[i * 2 + 1], lengths[i * 2 + 1]);
+        // ...
+    }
+}
+//! [34]
+}
+
 }
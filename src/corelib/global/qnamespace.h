@@ -1305,7 +1305,8 @@ namespace Qt {
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
-        UniqueConnection =  0x80
+        UniqueConnection =  0x80,
+        BatchedConnection = 0x100
     };
 
     enum ShortcutContext {
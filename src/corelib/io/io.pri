@@ -105,6 +105,11 @@ qtConfig(filesystemwatcher) {
     }
 }
 
+qtConfig(future) {
+    SOURCES += io/qasyncfileio.cpp
+    HEADERS += io/qasyncfileio_p.h
+}
+
 qtConfig(processenvironment) {
     SOURCES += \
         io/qprocess.cpp
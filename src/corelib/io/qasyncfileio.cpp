@@ -0,0 +1,629 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qasyncfileio_p.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthreadpool.h>
+
+#include <private/qthread_p.h>
+#ifdef Q_OS_UNIX
+#include <private/qcore_unix_p.h>
+#endif
+
+#if QT_CONFIG(io_uring)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// Neither pread() nor io_uring transfer more than this in one go
+static constexpr qint64 MaxChunkSize = qint64(1) << 30;
+
+namespace {
+
+// One read or write. The backend that runs it calls finish() and then
+// deletes it.
+class QAsyncFileOp
+{
+public:
+    explicit QAsyncFileOp(QAsyncFileIO::Request &&request)
+        : fd(request.fd), fileName(std::move(request.fileName)),
+          offset(request.offset), size(request.size), buffer(std::move(request.data))
+    {
+    }
+    virtual ~QAsyncFileOp()
+    {
+#ifdef Q_OS_UNIX
+        if (fd != -1)
+            qt_safe_close(fd);
+#endif
+    }
+
+    virtual bool isWrite() const = 0;
+    virtual void finish(bool ok) = 0;
+
+    int fd;
+    QString fileName;
+    qint64 offset;
+    qint64 size;
+    qint64 transferred = 0;
+    QByteArray buffer;
+    char *ptr = nullptr;
+};
+
+struct QAsyncReadBatch
+{
+    QFutureInterface<QByteArray> future;
+    QAtomicInteger<qsizetype> remaining;
+};
+
+class QAsyncReadOp : public QAsyncFileOp
+{
+public:
+    QAsyncReadOp(QAsyncFileIO::Request &&request, const QSharedPointer<QAsyncReadBatch> &batch,
+                 qsizetype index)
+        : QAsyncFileOp(std::move(request)), batch(batch), index(index)
+    {
+        if (size > 0) {
+            buffer = QByteArray(size, Qt::Uninitialized);
+            ptr = buffer.data();
+        }
+    }
+
+    bool isWrite() const override { return false; }
+
+    void finish(bool ok) override
+    {
+        // a null array reports an error, an empty one the end of the file
+        QByteArray result;
+        if (ok && transferred) {
+            buffer.truncate(transferred);
+            result = std::move(buffer);
+        } else if (ok) {
+            result = QByteArray("");
+        }
+        batch->future.reportResult(std::move(result), int(index));
+        if (--batch->remaining == 0)
+            batch->future.reportFinished();
+    }
+
+private:
+    QSharedPointer<QAsyncReadBatch> batch;
+    qsizetype index;
+};
+
+class QAsyncWriteOp : public QAsyncFileOp
+{
+public:
+    QAsyncWriteOp(QAsyncFileIO::Request &&request, const QFutureInterface<qint64> &future)
+        : QAsyncFileOp(std::move(request)), future(future)
+    {
+        if (size >= 0)
+            size = buffer.size();
+        ptr = const_cast<char *>(buffer.constData());
+    }
+
+    bool isWrite() const override { return true; }
+
+    void finish(bool ok) override
+    {
+        future.reportResult(ok ? transferred : qint64(-1));
+        future.reportFinished();
+    }
+
+private:
+    QFutureInterface<qint64> future;
+};
+
+} // unnamed namespace
+
+static bool performBlocking(QAsyncFileOp *op)
+{
+#ifdef Q_OS_UNIX
+    if (op->fd != -1) {
+        while (op->transferred < op->size) {
+            const size_t chunk = size_t(qMin(op->size - op->transferred, MaxChunkSize));
+            char *ptr = op->ptr + op->transferred;
+            const QT_OFF_T offset = QT_OFF_T(op->offset + op->transferred);
+            ssize_t result;
+            if (op->isWrite())
+                EINTR_LOOP(result, ::pwrite(op->fd, ptr, chunk, offset));
+            else
+                EINTR_LOOP(result, ::pread(op->fd, ptr, chunk, offset));
+            if (result < 0)
+                return false;
+            if (result == 0)
+                break;
+            op->transferred += result;
+        }
+        return true;
+    }
+#endif
+
+    QFile file(op->fileName);
+    if (!file.open(op->isWrite() ? QIODevice::ReadWrite : QIODevice::ReadOnly)
+            || !file.seek(op->offset)) {
+        return false;
+    }
+    const qint64 result = op->isWrite() ? file.write(op->ptr, op->size)
+                                        : file.read(op->ptr, op->size);
+    if (result < 0)
+        return false;
+    op->transferred = result;
+    return true;
+}
+
+static void runInThreadPool(const QList<QAsyncFileOp *> &ops)
+{
+    // small files are cheap to read; keep the per-task overhead low
+    constexpr qsizetype ChunkSize = 16;
+    for (qsizetype i = 0; i < ops.size(); i += ChunkSize) {
+        const QList<QAsyncFileOp *> chunk = ops.mid(i, ChunkSize);
+        QThreadPool::globalInstance()->start([chunk]() {
+            for (QAsyncFileOp *op : chunk) {
+                op->finish(performBlocking(op));
+                delete op;
+            }
+        });
+    }
+}
+
+#if QT_CONFIG(io_uring)
+
+class QIoUringThread : public QDaemonThread
+{
+public:
+    explicit QIoUringThread(QIoUring *ring) : ring(ring) { }
+
+protected:
+    void run() override;
+
+private:
+    QIoUring *ring;
+};
+
+/*
+    A submission/completion ring shared by all users of a QAsyncFileIO.
+    Any thread may submit; a helper thread waits for completions, resubmits
+    short transfers and reports the results.
+
+    At most cqEntries operations are in flight, so the completion queue can
+    never overflow. Further operations wait in a backlog and are submitted
+    as completions come in.
+*/
+class QIoUring
+{
+public:
+    ~QIoUring();
+
+    static std::unique_ptr<QIoUring> create();
+
+    void submit(const QList<QAsyncFileOp *> &ops);
+    void run();
+
+private:
+    using Finished = QList<std::pair<QAsyncFileOp *, bool>>;
+
+    QIoUring() = default;
+    bool setup(unsigned entries);
+    void flushBacklog(Finished *failed);
+    static void finish(const Finished &finished);
+
+    int ringFd = -1;
+    void *sqRing = nullptr;
+    void *cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned cqMask = 0;
+    unsigned cqEntries = 0;
+
+    QMutex mutex;
+    QList<QAsyncFileOp *> backlog;
+    unsigned inFlight = 0;
+    bool stopping = false;
+    std::unique_ptr<QIoUringThread> thread;
+};
+
+static int ioUringSetup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+void QIoUringThread::run()
+{
+    ring->run();
+}
+
+std::unique_ptr<QIoUring> QIoUring::create()
+{
+    std::unique_ptr<QIoUring> ring(new QIoUring);
+    if (!ring->setup(256))
+        return nullptr;
+    ring->thread.reset(new QIoUringThread(ring.get()));
+    ring->thread->start();
+    return ring;
+}
+
+bool QIoUring::setup(unsigned entries)
+{
+    io_uring_params params = {};
+    ringFd = ioUringSetup(entries, &params);
+    if (ringFd < 0)
+        return false;
+
+    // IORING_OP_READ and IORING_OP_WRITE came with this feature, in Linux 5.6
+    if (!(params.features & IORING_FEAT_RW_CUR_POS))
+        return false;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        return false;
+    }
+    if (singleMmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            return false;
+        }
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqesMemory = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqesMemory == MAP_FAILED)
+        return false;
+    sqes = static_cast<io_uring_sqe *>(sqesMemory);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqEntries = params.cq_entries;
+    return true;
+}
+
+QIoUring::~QIoUring()
+{
+    if (thread) {
+        {
+            // wake the completion thread up with a no-op; it exits once
+            // everything in flight has completed
+            QMutexLocker locker(&mutex);
+            stopping = true;
+            const unsigned tail = *sqTail;
+            const unsigned index = tail & sqMask;
+            memset(sqes + index, 0, sizeof(io_uring_sqe));
+            sqes[index].opcode = IORING_OP_NOP;
+            sqArray[index] = index;
+            __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+            Finished failed;
+            flushBacklog(&failed);
+            locker.unlock();
+            finish(failed);
+        }
+        thread->wait();
+    }
+
+    if (sqes)
+        ::munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing)
+        ::munmap(cqRing, cqRingSize);
+    if (sqRing)
+        ::munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+void QIoUring::submit(const QList<QAsyncFileOp *> &ops)
+{
+    Finished failed;
+    {
+        QMutexLocker locker(&mutex);
+        backlog.append(ops);
+        flushBacklog(&failed);
+    }
+    // reporting a result may run continuations, which may submit again
+    finish(failed);
+}
+
+// Moves operations from the backlog into the submission queue and hands
+// everything that is queued to the kernel in one system call. Must be
+// called with the mutex held.
+void QIoUring::flushBacklog(Finished *failed)
+{
+    unsigned tail = *sqTail;
+    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    while (!backlog.isEmpty() && inFlight < cqEntries && tail - head < sqEntries) {
+        QAsyncFileOp *op = backlog.takeFirst();
+        const unsigned index = tail & sqMask;
+        io_uring_sqe *sqe = sqes + index;
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = op->isWrite() ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe->fd = op->fd;
+        sqe->off = quint64(op->offset + op->transferred);
+        sqe->addr = quint64(quintptr(op->ptr + op->transferred));
+        sqe->len = unsigned(qMin(op->size - op->transferred, MaxChunkSize));
+        sqe->user_data = quint64(quintptr(op));
+        sqArray[index] = index;
+        ++tail;
+        ++inFlight;
+    }
+    __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+    while (tail != head) {
+        const int result = ioUringEnter(ringFd, tail - head, 0, 0);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0) {
+            // the kernel did not take these; fail them instead of leaving
+            // them queued without anything to flush them later
+            for (; head != tail; ++head) {
+                const io_uring_sqe &sqe = sqes[sqArray[head & sqMask]];
+                if (auto op = reinterpret_cast<QAsyncFileOp *>(quintptr(sqe.user_data))) {
+                    --inFlight;
+                    failed->append({ op, false });
+                }
+            }
+            __atomic_store_n(sqTail, tail = *sqHead, __ATOMIC_RELEASE);
+            break;
+        }
+        head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    }
+}
+
+void QIoUring::finish(const Finished &finished)
+{
+    for (const auto &entry : finished) {
+        entry.first->finish(entry.second);
+        delete entry.first;
+    }
+}
+
+void QIoUring::run()
+{
+    Finished finished;
+    forever {
+        if (ioUringEnter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            qErrnoWarning("QAsyncFileIO: waiting for completions failed");
+            return;
+        }
+
+        QMutexLocker locker(&mutex);
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            auto op = reinterpret_cast<QAsyncFileOp *>(quintptr(cqe.user_data));
+            if (!op)
+                continue;
+            --inFlight;
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                backlog.prepend(op);
+            } else if (cqe.res < 0) {
+                finished.append({ op, false });
+            } else {
+                op->transferred += cqe.res;
+                // continue a short transfer where it stopped
+                if (cqe.res == 0 || op->transferred >= op->size)
+                    finished.append({ op, true });
+                else
+                    backlog.prepend(op);
+            }
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        flushBacklog(&finished);
+        const bool done = stopping && inFlight == 0 && backlog.isEmpty();
+        locker.unlock();
+
+        finish(finished);
+        finished.clear();
+        if (done)
+            return;
+    }
+}
+
+#else
+
+class QIoUring
+{
+};
+
+#endif // QT_CONFIG(io_uring)
+
+static void dispatch(QIoUring *ring, QList<QAsyncFileOp *> ops)
+{
+#if QT_CONFIG(io_uring)
+    if (ring) {
+        // the ring can only be handed file descriptors
+        const auto byName = std::stable_partition(ops.begin(), ops.end(), [](QAsyncFileOp *op) {
+            return op->fd != -1;
+        });
+        const qsizetype count = byName - ops.begin();
+        ring->submit(ops.first(count));
+        ops.remove(0, count);
+    }
+#else
+    Q_UNUSED(ring);
+#endif
+    runInThreadPool(ops);
+}
+
+/*!
+    \internal
+    \class QAsyncFileIO
+    \inmodule QtCore
+
+    \brief The QAsyncFileIO class runs file reads and writes without
+    blocking the calling thread.
+
+    On Linux, requests are submitted to an io_uring instance, many of them
+    with a single system call. Elsewhere, or if io_uring is not available,
+    or if the \c QT_NO_IO_URING environment variable is set, they run on
+    QThreadPool::globalInstance().
+
+    Requests carrying a file descriptor are transferred with positional
+    reads and writes; the others open \c fileName with QFile.
+*/
+
+QAsyncFileIO::QAsyncFileIO(Backend preferredBackend)
+{
+#if QT_CONFIG(io_uring)
+    if (preferredBackend == IoUringBackend && !qEnvironmentVariableIsSet("QT_NO_IO_URING"))
+        ring = QIoUring::create();
+#else
+    Q_UNUSED(preferredBackend);
+#endif
+}
+
+QAsyncFileIO::~QAsyncFileIO() = default;
+
+Q_GLOBAL_STATIC(QAsyncFileIO, asyncFileIO)
+
+/*!
+    \internal
+    Returns the instance shared by QFile.
+*/
+QAsyncFileIO *QAsyncFileIO::instance()
+{
+    return asyncFileIO();
+}
+
+QAsyncFileIO::Backend QAsyncFileIO::backend() const
+{
+    return ring ? IoUringBackend : ThreadPoolBackend;
+}
+
+/*!
+    \internal
+    Reads all \a requests. The result at index \c i of the returned future
+    holds the data of request \c i, an empty array if the request started
+    at or after the end of the file, or a null array if it failed.
+*/
+QFuture<QByteArray> QAsyncFileIO::read(QList<Request> requests)
+{
+    auto batch = QSharedPointer<QAsyncReadBatch>::create();
+    batch->future.reportStarted();
+    QFuture<QByteArray> future = batch->future.future();
+    if (requests.isEmpty()) {
+        batch->future.reportFinished();
+        return future;
+    }
+
+    batch->remaining.storeRelaxed(requests.size());
+    QList<QAsyncFileOp *> ops;
+    ops.reserve(requests.size());
+    for (qsizetype i = 0; i < requests.size(); ++i) {
+        auto op = new QAsyncReadOp(std::move(requests[i]), batch, i);
+        if (op->size > 0) {
+            ops.append(op);
+        } else {
+            op->finish(op->size == 0);
+            delete op;
+        }
+    }
+    dispatch(ring.get(), std::move(ops));
+    return future;
+}
+
+/*!
+    \internal
+    Writes the data of \a request. The returned future holds the number of
+    bytes written, or -1 if the write failed.
+*/
+QFuture<qint64> QAsyncFileIO::write(Request request)
+{
+    QFutureInterface<qint64> futureInterface;
+    futureInterface.reportStarted();
+    auto op = new QAsyncWriteOp(std::move(request), futureInterface);
+    if (op->size > 0) {
+        dispatch(ring.get(), { op });
+    } else {
+        op->finish(op->size == 0);
+        delete op;
+    }
+    return futureInterface.future();
+}
+
+QT_END_NAMESPACE
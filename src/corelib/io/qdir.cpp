@@ -349,11 +349,19 @@ inline void QDirPrivate::sortFileList(QDir::SortFlags sort, QFileInfoList &l,
         }
     }
 }
+// Sorting by time or size needs the metadata of every entry
+static QDirIterator::IteratorFlags iteratorFlagsForSort(QDir::SortFlags sort)
+{
+    const int sortBy = sort & QDir::SortByMask;
+    return sortBy == QDir::Time || sortBy == QDir::Size ? QDirIterator::PrefetchMetadata
+                                                        : QDirIterator::NoIteratorFlags;
+}
+
 inline void QDirPrivate::initFileLists(const QDir &dir) const
 {
     if (!fileListsInitialized) {
         QFileInfoList l;
-        QDirIterator it(dir);
+        QDirIterator it(dir, iteratorFlagsForSort(sort));
         while (it.hasNext()) {
             it.next();
             l.append(it.fileInfo());
@@ -1411,7 +1419,7 @@ QStringList QDir::entryList(const QStringList &nameFilters, Filters filters,
     }
 
     QFileInfoList l;
-    QDirIterator it(d->dirEntry.filePath(), nameFilters, filters);
+    QDirIterator it(d->dirEntry.filePath(), nameFilters, filters, iteratorFlagsForSort(sort));
     while (it.hasNext()) {
         it.next();
         l.append(it.fileInfo());
@@ -1453,7 +1461,7 @@ QFileInfoList QDir::entryInfoList(const QStringList &nameFilters, Filters filter
     }
 
     QFileInfoList l;
-    QDirIterator it(d->dirEntry.filePath(), nameFilters, filters);
+    QDirIterator it(d->dirEntry.filePath(), nameFilters, filters, iteratorFlagsForSort(sort));
     while (it.hasNext()) {
         it.next();
         l.append(it.fileInfo());
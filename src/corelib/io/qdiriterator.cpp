@@ -87,6 +87,14 @@
     enables iterating through all subdirectories of the assigned path,
     following all symbolic links. Symbolic link loops (e.g., "link" => "." or
     "link" => "..") are automatically detected and ignored.
+
+    \value PrefetchMetadata Since Qt 6.1, fetches the size, times and
+    permissions of each returned entry while its directory is being read, so
+    that fileInfo() answers without further file system calls. On Unix, the
+    lookups are relative to the open directory, which is cheaper than the
+    full-path lookups QFileInfo would do later. Use this when most entries'
+    metadata will be needed; without it, iterating only needs file types,
+    which the directory listing already provides on most file systems.
 */
 
 #include "qdiriterator.h"
@@ -267,8 +275,18 @@ void QDirIteratorPrivate::advance()
             while (it = nativeIterators.top(), it->advance(nextEntry, nextMetaData)) {
                 QFileInfo info(new QFileInfoPrivate(nextEntry, nextMetaData));
 
-                if (entryMatches(nextEntry.fileName(), info))
+                if (entryMatches(nextEntry.fileName(), info)) {
+#if !defined(Q_OS_WIN)
+                    // stat only what is returned, while its directory is open
+                    const QFileInfoPrivate *infoPrivate = info.d_ptr.constData();
+                    QFileSystemMetaData &metaData = infoPrivate->metaData;
+                    if ((iteratorFlags & QDirIterator::PrefetchMetadata) && !infoPrivate->fileEngine
+                            && !metaData.hasFlags(QFileSystemMetaData::PosixStatFlags)) {
+                        it->fillMetaData(metaData);
+                    }
+#endif
                     return;
+                }
                 nextMetaData = QFileSystemMetaData();
             }
 
@@ -57,6 +57,14 @@
 
 #include <private/qmemory_p.h>
 
+#if QT_CONFIG(future)
+#include "qfuture.h"
+#include "private/qasyncfileio_p.h"
+#endif
+#ifdef Q_OS_UNIX
+#include "private/qcore_unix_p.h"
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -1183,6 +1191,138 @@ qint64 QFile::size() const
     return QFileDevice::size(); // for now
 }
 
+#if QT_CONFIG(future)
+// Describes a transfer on the open \a file for QAsyncFileIO, which must not
+// depend on the QFile staying alive or open.
+static QAsyncFileIO::Request asyncRequest(QFile *file, const char *function,
+                                          QIODevice::OpenModeFlag mode)
+{
+    QAsyncFileIO::Request request;
+    request.size = -1;
+    if (!file->isOpen()) {
+        qWarning("QFile::%s: File (%ls) not open", function, qUtf16Printable(file->fileName()));
+        return request;
+    }
+    if (!(file->openMode() & mode)) {
+        qWarning("QFile::%s: File (%ls) not open for %s", function,
+                 qUtf16Printable(file->fileName()),
+                 mode == QIODevice::ReadOnly ? "reading" : "writing");
+        return request;
+    }
+    // make what was written through the QFile visible to the transfer
+    if (file->isWritable())
+        file->flush();
+
+#ifdef Q_OS_UNIX
+    if (file->handle() != -1) {
+        request.fd = qt_safe_dup(file->handle());
+        if (request.fd == -1) {
+            qErrnoWarning("QFile::%s: Cannot duplicate the file handle", function);
+            return request;
+        }
+    }
+#endif
+    if (request.fd == -1)
+        request.fileName = file->fileName();
+    request.size = 0;
+    return request;
+}
+
+/*!
+    \since 6.1
+
+    Starts reading at most \a maxSize bytes from position \a offset in the
+    file and returns a QFuture that delivers them, without blocking the
+    calling thread. The result is empty if \a offset is at or past the end
+    of the file, and a null QByteArray if reading fails.
+
+    The file must be open for reading. The current position is neither used
+    nor changed, and the file may be closed or destroyed while the read is
+    in progress. Data written to the file before the call is flushed and
+    will be read; the outcome of writing to the same range while the read
+    is in progress is undefined.
+
+    On Linux, reads are submitted to the kernel through io_uring where
+    available; elsewhere they run on QThreadPool::globalInstance(). To read
+    many files, use readAllAsync(), which submits all reads at once.
+
+    \sa writeAsync(), readAllAsync(), QFutureWatcher
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize)
+{
+    QAsyncFileIO::Request request = asyncRequest(this, "readAsync", ReadOnly);
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFile::readAsync: Called with offset %lld and maxSize %lld", offset, maxSize);
+        request.size = -1;
+    }
+    if (request.size == 0) {
+        // don't allocate more than the file can deliver; sizes of zero
+        // are not trusted, as for readAll()
+        const qint64 fileSize = size();
+        if (fileSize > 0 && !isSequential())
+            maxSize = qMin(maxSize, qMax(fileSize - offset, qint64(0)));
+        request.offset = offset;
+        request.size = maxSize;
+    }
+    return QAsyncFileIO::instance()->read({ std::move(request) });
+}
+
+/*!
+    \since 6.1
+
+    Starts writing \a data at position \a offset in the file and returns a
+    QFuture that delivers the number of bytes written, or -1 if writing
+    fails, without blocking the calling thread.
+
+    The file must be open for writing. The current position is neither used
+    nor changed, and the file may be closed or destroyed while the write is
+    in progress. Pending buffered data is flushed first.
+
+    \sa readAsync()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    QAsyncFileIO::Request request = asyncRequest(this, "writeAsync", WriteOnly);
+    if (offset < 0) {
+        qWarning("QFile::writeAsync: Called with offset %lld", offset);
+        request.size = -1;
+    }
+    request.offset = offset;
+    request.data = data;
+    return QAsyncFileIO::instance()->write(std::move(request));
+}
+
+/*!
+    \since 6.1
+
+    Starts reading the contents of all \a files, which must be open for
+    reading, and returns a QFuture with one result per file, in the same
+    order. A result is a null QByteArray if reading the corresponding file
+    fails. The reads are submitted together: on Linux with io_uring,
+    loading thousands of small files costs a handful of system calls.
+
+    Each file is read from its beginning up to the size() it has when this
+    function is called. As with readAsync(), the files may be closed or
+    destroyed while the reads are in progress.
+
+    \snippet code/src_corelib_io_qfile.cpp 5
+
+    \sa readAsync()
+*/
+QFuture<QByteArray> QFile::readAllAsync(const QList<QFile *> &files)
+{
+    QList<QAsyncFileIO::Request> requests;
+    requests.reserve(files.size());
+    for (QFile *file : files) {
+        QAsyncFileIO::Request request = asyncRequest(file, "readAllAsync", ReadOnly);
+        if (request.size == 0)
+            request.size = file->size();
+        requests.append(std::move(request));
+    }
+    return QAsyncFileIO::instance()->read(std::move(requests));
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \fn QFile::QFile(const std::filesystem::path &name)
     \since 6.0
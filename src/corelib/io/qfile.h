@@ -85,6 +85,9 @@ using ForceFilesystemPath = typename std::enable_if_t<std::is_same_v<std::filesy
 
 class QTemporaryFile;
 class QFilePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 class Q_CORE_EXPORT QFile : public QFileDevice
 {
@@ -243,6 +246,12 @@ public:
     }
 #endif // QT_CONFIG(cxx17_filesystem)
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+    static QFuture<QByteArray> readAllAsync(const QList<QFile *> &files);
+#endif
+
 protected:
 #ifdef QT_NO_QOBJECT
     QFile(QFilePrivate &dd);
@@ -330,6 +330,11 @@ static int qt_fstatx(int fd, struct statx *statxBuffer)
     return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer);
 }
 
+static int qt_statxat(int dirfd, const char *name, int flags, struct statx *statxBuffer)
+{
+    return qt_real_statx(dirfd, name, flags, statxBuffer);
+}
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
 {
     // Permissions
@@ -396,6 +401,9 @@ static int qt_lstatx(const char *, struct statx *)
 static int qt_fstatx(int, struct statx *)
 { return -ENOSYS; }
 
+static int qt_statxat(int, const char *, int, struct statx *)
+{ return -ENOSYS; }
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &)
 { }
 #endif
@@ -428,6 +436,61 @@ bool QFileSystemEngine::fillMetaData(int fd, QFileSystemMetaData &data)
     return false;
 }
 
+/*!
+    \internal
+
+    Fills the LinkType, ExistsAttribute and PosixStatFlags of the entry \a name
+    in the directory \a dirfd, like fillMetaData() does from a full path, but
+    with lookups relative to the directory. A LinkType already known from the
+    directory entry saves the lstat(2).
+*/
+bool QFileSystemEngine::fillMetaDataAt(int dirfd, const char *name, QFileSystemMetaData &data)
+{
+    const QFileSystemMetaData::MetaDataFlags what = QFileSystemMetaData::LinkType
+            | QFileSystemMetaData::ExistsAttribute | QFileSystemMetaData::PosixStatFlags;
+
+    union {
+        QT_STATBUF statBuffer;
+        struct statx statxBuffer;
+    } buffer;
+    // 1 if statx(2) filled statxBuffer, 0 if fstatat(2) filled statBuffer, -1 on failure
+    auto statAt = [&](int flags) {
+        const int ret = qt_statxat(dirfd, name, flags, &buffer.statxBuffer);
+        if (ret == -ENOSYS)
+            return QT_FSTATAT(dirfd, name, &buffer.statBuffer, flags) == 0 ? 0 : -1;
+        return ret == 0 ? 1 : -1;
+    };
+
+    bool isLink = data.hasFlags(QFileSystemMetaData::LinkType) && data.isLink();
+    int statResult = -1;
+    if (!isLink) {
+        statResult = statAt(AT_SYMLINK_NOFOLLOW);
+        if (statResult >= 0)
+            isLink = S_ISLNK(statResult ? buffer.statxBuffer.stx_mode : buffer.statBuffer.st_mode);
+    }
+    if (isLink)
+        statResult = statAt(0);
+
+    data.entryFlags &= ~what;
+    if (isLink)
+        data.entryFlags |= QFileSystemMetaData::LinkType;
+    if (statResult == 1) {
+        data.fillFromStatxBuf(buffer.statxBuffer);
+    } else if (statResult == 0) {
+        data.fillFromStatBuf(buffer.statBuffer);
+    } else {
+        data.birthTime_ = 0;
+        data.metadataChangeTime_ = 0;
+        data.modificationTime_ = 0;
+        data.accessTime_ = 0;
+        data.size_ = 0;
+        data.userId_ = (uint) -2;
+        data.groupId_ = (uint) -2;
+    }
+    data.knownFlagsMask |= what;
+    return statResult >= 0;
+}
+
 #if defined(_DEXTRA_FIRST)
 static void fillStat64fromStat32(struct stat64 *statBuf64, const struct stat &statBuf32)
 {
@@ -546,9 +609,17 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
     }
 #elif defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
     // BSD4 includes OS X and iOS
+    fillFromDirEntType(entry.d_type);
+#else
+    Q_UNUSED(entry);
+#endif
+}
 
+void QFileSystemMetaData::fillFromDirEntType(unsigned char type)
+{
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
     // ### This will clear all entry flags and knownFlagsMask
-    switch (entry.d_type)
+    switch (type)
     {
     case DT_DIR:
         knownFlagsMask = QFileSystemMetaData::LinkType
@@ -615,7 +686,8 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
         clear();
     }
 #else
-    Q_UNUSED(entry);
+    Q_UNUSED(type);
+    clear();
 #endif
 }
 
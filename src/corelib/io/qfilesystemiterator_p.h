@@ -66,6 +66,9 @@
 #if !defined(Q_OS_WIN)
 #include <QtCore/qscopedpointer.h>
 #endif
+#if defined(Q_OS_LINUX)
+#include <memory>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -78,6 +81,9 @@ public:
     ~QFileSystemIterator();
 
     bool advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData);
+#if !defined(Q_OS_WIN)
+    bool fillMetaData(QFileSystemMetaData &metaData) const;
+#endif
 
 private:
     QFileSystemEntry::NativePath nativePath;
@@ -90,6 +96,13 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(Q_OS_LINUX)
+    int dirFd;
+    std::unique_ptr<char[]> buffer;     // filled by getdents64(2)
+    int bufferSize;
+    int bufferPos;
+    const char *entryName;
+    int lastError;
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
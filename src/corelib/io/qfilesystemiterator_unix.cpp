@@ -40,6 +40,7 @@
 #include "qplatformdefs.h"
 #include "qfilesystemiterator_p.h"
 
+#include <private/qfilesystemengine_p.h>
 #include <private/qstringconverter_p.h>
 
 #ifndef QT_NO_FILESYSTEMITERATOR
@@ -49,6 +50,11 @@
 #include <stdlib.h>
 #include <errno.h>
 
+#ifdef Q_OS_LINUX
+#include <private/qcore_unix_p.h>
+#include <sys/syscall.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 static bool checkNameDecodable(const char *d_name, qsizetype len)
@@ -59,6 +65,96 @@ static bool checkNameDecodable(const char *d_name, qsizetype len)
     return QUtf8::isValidUtf8(d_name, len).isValidUtf8;
 }
 
+#ifdef Q_OS_LINUX
+// getdents64(2) fills its buffer with these; d_name is NUL-terminated
+struct QLinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+// the same size as glibc's readdir() uses
+static constexpr int DirentBufferSize = 32 * 1024;
+
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
+                                         const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
+    : nativePath(entry.nativeFilePath())
+    , dirFd(-1)
+    , bufferSize(0)
+    , bufferPos(0)
+    , entryName(nullptr)
+    , lastError(0)
+{
+    Q_UNUSED(filters);
+    Q_UNUSED(nameFilters);
+    Q_UNUSED(flags);
+
+    if ((dirFd = qt_safe_open(nativePath.constData(), O_RDONLY | O_DIRECTORY)) == -1) {
+        lastError = errno;
+    } else {
+        if (!nativePath.endsWith('/'))
+            nativePath.append('/');
+    }
+}
+
+QFileSystemIterator::~QFileSystemIterator()
+{
+    if (dirFd != -1)
+        qt_safe_close(dirFd);
+}
+
+bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
+{
+    if (dirFd == -1)
+        return false;
+
+    for (;;) {
+        if (bufferPos == bufferSize) {
+            // one system call returns the entries of a whole buffer, with
+            // their types; no stat(2) is needed to tell files from directories
+            if (!buffer)
+                buffer.reset(new char[DirentBufferSize]);
+            const long read = syscall(SYS_getdents64, dirFd, buffer.get(), DirentBufferSize);
+            if (read <= 0) {
+                lastError = read < 0 ? errno : 0;
+                entryName = nullptr;
+                return false;
+            }
+            bufferSize = int(read);
+            bufferPos = 0;
+        }
+
+        const auto dirent = reinterpret_cast<const QLinuxDirent64 *>(buffer.get() + bufferPos);
+        bufferPos += dirent->d_reclen;
+
+        qsizetype len = strlen(dirent->d_name);
+        if (checkNameDecodable(dirent->d_name, len)) {
+            entryName = dirent->d_name;
+            fileEntry = QFileSystemEntry(nativePath + QByteArray(entryName, len), QFileSystemEntry::FromNativePath());
+            metaData.fillFromDirEntType(dirent->d_type);
+            return true;
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Fills the stat(2) information of the entry last returned by advance()
+    into \a metaData, looking it up relative to the open directory.
+*/
+bool QFileSystemIterator::fillMetaData(QFileSystemMetaData &metaData) const
+{
+    if (!entryName)
+        return false;
+    return QFileSystemEngine::fillMetaDataAt(dirFd, entryName, metaData);
+}
+
+#else
+
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
                                          const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
     : nativePath(entry.nativeFilePath())
@@ -108,6 +204,21 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
     return false;
 }
 
+/*!
+    \internal
+
+    Fills the stat(2) information of the entry last returned by advance()
+    into \a metaData, looking it up relative to the open directory.
+*/
+bool QFileSystemIterator::fillMetaData(QFileSystemMetaData &metaData) const
+{
+    if (!dirEntry)
+        return false;
+    return QFileSystemEngine::fillMetaDataAt(dirfd(dir), dirEntry->d_name, metaData);
+}
+
+#endif // Q_OS_LINUX
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_FILESYSTEMITERATOR
@@ -44,8 +44,12 @@
 #include <qdatetime.h>
 #include <qpair.h>
 #include <qstringlist.h>
+#if QT_CONFIG(thread)
+#include <qthreadpool.h>
+#endif
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
+#include <private/qcollator_p.h>
 
 #include <algorithm>
 
@@ -170,6 +174,7 @@ public:
     Qt::CaseSensitivity sort_casesensitivity;
     int sort_role;
     bool sort_localeaware;
+    bool sort_keys_cached;
 
     int filter_column;
     int filter_role;
@@ -258,6 +263,8 @@ public:
     void sort();
     bool update_source_sort_column();
     int find_source_sort_column() const;
+    bool sort_source_rows_by_keys(QList<int> &source_rows,
+                                  const QModelIndex &source_parent) const;
     void sort_source_rows(QList<int> &source_rows,
                           const QModelIndex &source_parent) const;
     QList<QPair<int, QList<int>>> proxy_intervals_for_source_items_to_add(
@@ -576,6 +583,60 @@ int QSortFilterProxyModelPrivate::find_source_sort_column() const
     return -1;
 }
 
+/*!
+  \internal
+
+  Sorts the given \a source_rows the way sort_source_rows() does, but
+  collating each string only once, into a QCollatorSortKey, instead of in
+  every call to lessThan(). Returns \c false, without sorting, if that
+  doesn't give the same order as the default lessThan(), i.e. unless the
+  sort is locale aware and all the sort data are strings.
+*/
+bool QSortFilterProxyModelPrivate::sort_source_rows_by_keys(
+    QList<int> &source_rows, const QModelIndex &source_parent) const
+{
+    if (!sort_localeaware || source_rows.size() < 2)
+        return false;
+
+    QStringList strings;
+    strings.reserve(source_rows.size());
+    for (int source_row : qAsConst(source_rows)) {
+        const QModelIndex index = model->index(source_row, source_sort_column, source_parent);
+        const QVariant value = model->data(index, sort_role);
+        // QAbstractItemModelPrivate::isVariantLessThan() doesn't compare these as strings
+        switch (value.userType()) {
+        case QMetaType::UnknownType:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Float:
+        case QMetaType::Double:
+        case QMetaType::QChar:
+        case QMetaType::QDate:
+        case QMetaType::QTime:
+        case QMetaType::QDateTime:
+            return false;
+        default:
+            strings.append(value.toString());
+            break;
+        }
+    }
+
+#if QT_CONFIG(thread)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+#else
+    QThreadPool *threadPool = nullptr;
+#endif
+    // with the collator QString::localeAwareCompare() uses
+    const QList<qsizetype> order = qt_collatorSortOrder(QCollator(), strings, sort_order,
+                                                        threadPool);
+    const QList<int> unsorted = source_rows;
+    for (qsizetype i = 0; i < order.size(); ++i)
+        source_rows[i] = unsorted.at(order.at(i));
+    return true;
+}
+
 /*!
   \internal
 
@@ -586,6 +647,8 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
+        if (sort_keys_cached && sort_source_rows_by_keys(source_rows, source_parent))
+            return;
         if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
@@ -1902,6 +1965,7 @@ QSortFilterProxyModel::QSortFilterProxyModel(QObject *parent)
     d->sort_casesensitivity = Qt::CaseSensitive;
     d->sort_role = Qt::DisplayRole;
     d->sort_localeaware = false;
+    d->sort_keys_cached = false;
     d->filter_column = 0;
     d->filter_role = Qt::DisplayRole;
     d->filter_recursive = false;
@@ -2637,6 +2701,54 @@ void QSortFilterProxyModel::setSortLocaleAware(bool on)
     emit sortLocaleAwareChanged(on);
 }
 
+/*!
+    \since 6.1
+    \property QSortFilterProxyModel::sortKeyCachingEnabled
+    \brief whether locale aware sorting collates each string only once
+
+    Comparing two strings in a locale aware way is expensive, and sorting
+    \c n rows compares their data about \c{n * log(n)} times. If this
+    property is true, and \l{isSortLocaleAware}{sorting is locale aware},
+    sorting instead computes a QCollatorSortKey for the data of each row,
+    using QCollator::sortKeys() and the threads of
+    QThreadPool::globalInstance(), and then compares the keys, which is a lot
+    cheaper.
+
+    This only applies to sorts where the data of all the rows are strings,
+    and does not call lessThan(): it must only be enabled if lessThan() is
+    not reimplemented, or is reimplemented to compare strings the same way
+    the default implementation does.
+
+    The default value is false.
+
+    \sa isSortLocaleAware, QCollator::sortKeys()
+*/
+
+/*!
+    \since 6.1
+    \fn void QSortFilterProxyModel::sortKeyCachingEnabledChanged(bool sortKeyCachingEnabled)
+
+    \brief This signal is emitted when the value of the \a sortKeyCachingEnabled property is changed.
+
+    \sa sortKeyCachingEnabled
+*/
+bool QSortFilterProxyModel::isSortKeyCachingEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->sort_keys_cached;
+}
+
+void QSortFilterProxyModel::setSortKeyCachingEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    if (d->sort_keys_cached == enable)
+        return;
+
+    // the order doesn't change, so there's no need to sort again
+    d->sort_keys_cached = enable;
+    emit sortKeyCachingEnabledChanged(enable);
+}
+
 #if QT_CONFIG(regularexpression)
 /*!
     \since 5.12
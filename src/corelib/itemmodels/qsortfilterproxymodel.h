@@ -69,6 +69,7 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
     Q_PROPERTY(Qt::CaseSensitivity filterCaseSensitivity READ filterCaseSensitivity WRITE setFilterCaseSensitivity NOTIFY filterCaseSensitivityChanged)
     Q_PROPERTY(Qt::CaseSensitivity sortCaseSensitivity READ sortCaseSensitivity WRITE setSortCaseSensitivity NOTIFY sortCaseSensitivityChanged)
     Q_PROPERTY(bool isSortLocaleAware READ isSortLocaleAware WRITE setSortLocaleAware NOTIFY sortLocaleAwareChanged)
+    Q_PROPERTY(bool sortKeyCachingEnabled READ isSortKeyCachingEnabled WRITE setSortKeyCachingEnabled NOTIFY sortKeyCachingEnabledChanged)
     Q_PROPERTY(int sortRole READ sortRole WRITE setSortRole NOTIFY sortRoleChanged)
     Q_PROPERTY(int filterRole READ filterRole WRITE setFilterRole NOTIFY filterRoleChanged)
     Q_PROPERTY(bool recursiveFilteringEnabled READ isRecursiveFilteringEnabled WRITE setRecursiveFilteringEnabled NOTIFY recursiveFilteringEnabledChanged)
@@ -102,6 +103,9 @@ public:
     bool isSortLocaleAware() const;
     void setSortLocaleAware(bool on);
 
+    bool isSortKeyCachingEnabled() const;
+    void setSortKeyCachingEnabled(bool enable);
+
     int sortColumn() const;
     Qt::SortOrder sortOrder() const;
 
@@ -185,6 +189,7 @@ Q_SIGNALS:
     void filterCaseSensitivityChanged(Qt::CaseSensitivity filterCaseSensitivity);
     void sortCaseSensitivityChanged(Qt::CaseSensitivity sortCaseSensitivity);
     void sortLocaleAwareChanged(bool sortLocaleAware);
+    void sortKeyCachingEnabledChanged(bool sortKeyCachingEnabled);
     void sortRoleChanged(int sortRole);
     void filterRoleChanged(int filterRole);
     void recursiveFilteringEnabledChanged(bool recursiveFilteringEnabled);
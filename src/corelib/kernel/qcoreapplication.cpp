@@ -1519,6 +1519,24 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // events for objects living in other threads are queued without locking,
+    // the receiving thread sorts and compresses them when it takes the lock.
+    // DeferredDelete events need the state of the receiving thread.
+    if (event->type() != QEvent::DeferredDelete) {
+        QThreadData *data = receiver->d_func()->threadData.loadAcquire();
+        if (data && data->threadId.loadRelaxed() != QThread::currentThreadId()) {
+            QPostEventNode *node = new QPostEventNode{ QPostEvent(receiver, event, priority), nullptr };
+            Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+            event->posted = true;
+            data->postEventList.pushIncoming(node);
+
+            QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+            if (dispatcher)
+                dispatcher->wakeUp();
+            return;
+        }
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1528,6 +1546,10 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the events posted earlier ahead of this one
+    if (data->postEventList.hasIncoming())
+        QCoreApplicationPrivate::takeIncomingPostedEvents(data);
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1576,6 +1598,59 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+  \internal
+  Moves the events that other threads posted to \a data without locking
+  into its list of posted events, compressing them like postEvent() does.
+  Events for objects that have moved to another thread in the meantime are
+  passed on to that thread.
+
+  The mutex of the list must be locked.
+*/
+void QCoreApplicationPrivate::takeIncomingPostedEvents(QThreadData *data)
+{
+    QPostEventNode *node = data->postEventList.takeIncoming();
+    while (node) {
+        QPostEventNode *current = node;
+        node = node->next;
+
+        QObject *receiver = current->event.receiver;
+        QEvent *event = current->event.event;
+
+        // synchronizes with the storeRelease in QObject::moveToThread
+        QThreadData *receiverData = receiver->d_func()->threadData.loadAcquire();
+        if (receiverData != data) {
+            if (!receiverData) {
+                // destruction in progress
+                event->posted = false;
+                delete event;
+                delete current;
+                continue;
+            }
+            receiverData->postEventList.pushIncoming(current);
+            if (QAbstractEventDispatcher *dispatcher = receiverData->eventDispatcher.loadAcquire())
+                dispatcher->wakeUp();
+            continue;
+        }
+
+        QScopedPointer<QPostEventNode> nodeDeleter(current);
+        event->posted = false;
+        if (receiver->d_func()->postedEvents
+            && QCoreApplication::self
+            && QCoreApplication::self->compressEvent(event, receiver, &data->postEventList)) {
+            Q_TRACE(QCoreApplication_postEvent_event_compressed, receiver, event);
+            continue;
+        }
+
+        QScopedPointer<QEvent> eventDeleter(event);
+        data->postEventList.addEvent(current->event);
+        eventDeleter.take();
+        event->posted = true;
+        ++receiver->d_func()->postedEvents;
+        data->canWait = false;
+    }
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1674,6 +1749,9 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
 
+    if (data->postEventList.hasIncoming())
+        takeIncomingPostedEvents(data);
+
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
     // events, canWait will be set to false.
@@ -1828,6 +1906,9 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
 
+    if (data->postEventList.hasIncoming())
+        QCoreApplicationPrivate::takeIncomingPostedEvents(data);
+
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
     // and when we get here, we may not have any more posted events
@@ -1891,6 +1972,9 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
 
+    if (data->postEventList.hasIncoming())
+        takeIncomingPostedEvents(data);
+
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
         qDebug("QCoreApplication::removePostedEvent: Internal error: %p %d is posted",
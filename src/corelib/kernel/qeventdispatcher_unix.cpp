@@ -52,6 +52,7 @@
 #include <private/qcore_unix_p.h>
 
 #include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -59,6 +60,10 @@
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -89,6 +94,43 @@ static const char *socketType(QSocketNotifier::Type type)
     Q_UNREACHABLE();
 }
 
+#if QT_CONFIG(epoll)
+static uint32_t epollEventsFromPollEvents(short events)
+{
+    uint32_t result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static short pollEventsFromEpollEvents(uint32_t events)
+{
+    short result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    return result;
+}
+
+static int epollTimeout(const timespec &tm)
+{
+    // round up, so that we don't wake up before the next timer is due
+    const qint64 msecs = qint64(tm.tv_sec) * 1000 + (tm.tv_nsec + 999999) / 1000000;
+    return int(qMin(msecs, qint64(INT_MAX)));
+}
+#endif
+
 QThreadPipe::QThreadPipe()
 {
     fds[0] = -1;
@@ -226,10 +268,23 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_TIMER_WHEEL") > 0)
+        timerList.enableTimerWheel();
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0 && !initEpoll())
+        qErrnoWarning("QEventDispatcherUNIXPrivate(): Unable to create epoll instance, falling back to poll()");
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     qDeleteAll(timerList);
 }
@@ -258,35 +313,39 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         auto it = socketNotifiers.find(pfd.fd);
         Q_ASSERT(it != socketNotifiers.end());
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
-
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
-
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+        markPendingSocketNotifier(it.key(), it.value(), pfd.revents);
+    }
 
-            if (!notifier)
-                continue;
+    pollfds.clear();
+}
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifier(int fd, const QSocketNotifierSetUNIX &sn_set,
+                                                            short revents)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+
+        if (!notifier)
+            continue;
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     fd, socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -308,6 +367,114 @@ int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
     return n_activated;
 }
 
+#if QT_CONFIG(epoll)
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+        return false;
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int fd, short oldEvents, short newEvents)
+{
+    if (epollFd < 0 || oldEvents == newEvents)
+        return;
+
+    if (epollUnsupportedFds.contains(fd)) {
+        if (!newEvents)
+            epollUnsupportedFds.removeOne(fd);
+        return;
+    }
+
+    const int op = !oldEvents ? EPOLL_CTL_ADD : !newEvents ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+    epoll_event ev = {};
+    ev.events = epollEventsFromPollEvents(newEvents);
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, op, fd, &ev) == 0)
+        return;
+
+    switch (errno) {
+    case ENOENT:
+        // the file was closed while its notifiers were still registered,
+        // which silently dropped it from the interest set
+        if (op == EPOLL_CTL_DEL || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+            return;
+        break;
+    case EEXIST:
+        // the descriptor was reused without its previous notifiers being
+        // unregistered first
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0)
+            return;
+        break;
+    case EBADF:
+        if (op == EPOLL_CTL_DEL)
+            return;
+        break;
+    case EPERM:
+        // regular files and directories can't be watched by epoll(7),
+        // poll(2) reports them as always ready
+        epollUnsupportedFds.append(fd);
+        return;
+    }
+
+    qErrnoWarning("QSocketNotifier: Unable to update epoll interest for socket %d", fd);
+}
+
+int QEventDispatcherUNIXPrivate::processEpollEvents(const timespec *tm)
+{
+    int timeout = -1;
+    if (!epollUnsupportedFds.isEmpty())
+        timeout = 0;
+    else if (tm)
+        timeout = epollTimeout(*tm);
+
+    epoll_event events[256];
+    int nready = epoll_wait(epollFd, events, int(sizeof(events) / sizeof(events[0])), timeout);
+    if (nready == -1) {
+        if (errno != EINTR)
+            perror("epoll_wait");
+        nready = 0;
+    }
+
+    int nevents = 0;
+
+    for (int i = 0; i < nready; ++i) {
+        const int fd = events[i].data.fd;
+        const short revents = pollEventsFromEpollEvents(events[i].events);
+
+        if (fd == threadPipe.fds[0]) {
+            pollfd pfd = qt_make_pollfd(fd, POLLIN);
+            pfd.revents = revents;
+            nevents += threadPipe.check(pfd);
+            continue;
+        }
+
+        auto it = socketNotifiers.constFind(fd);
+        if (it != socketNotifiers.cend())
+            markPendingSocketNotifier(fd, it.value(), revents);
+    }
+
+    for (int fd : qAsConst(epollUnsupportedFds)) {
+        auto it = socketNotifiers.constFind(fd);
+        if (it != socketNotifiers.cend())
+            markPendingSocketNotifier(fd, it.value(), it.value().events() & (POLLIN | POLLOUT));
+    }
+
+    return nevents + activateSocketNotifiers();
+}
+#endif
+
 QEventDispatcherUNIX::QEventDispatcherUNIX(QObject *parent)
     : QAbstractEventDispatcher(*new QEventDispatcherUNIXPrivate, parent)
 { }
@@ -411,7 +578,15 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    d->updateEpollInterest(sockfd, oldEvents, sn_set.events());
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -450,8 +625,16 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    d->updateEpollInterest(sockfd, oldEvents, sn_set.events());
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -487,29 +670,36 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
-    d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
-
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
-
-    // This must be last, as it's popped off the end below
-    d->pollfds.append(d->threadPipe.prepare());
-
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
-    case -1:
-        perror("qt_safe_poll");
-        break;
-    case 0:
-        break;
-    default:
-        nevents += d->threadPipe.check(d->pollfds.takeLast());
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && include_notifiers) {
+        nevents += d->processEpollEvents(tm);
+    } else
+#endif
+    {
+        d->pollfds.clear();
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
         if (include_notifiers)
-            nevents += d->activateSocketNotifiers();
-        break;
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+
+        // This must be last, as it's popped off the end below
+        d->pollfds.append(d->threadPipe.prepare());
+
+        switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(d->pollfds.takeLast());
+            if (include_notifiers)
+                nevents += d->activateSocketNotifiers();
+            break;
+        }
     }
 
     if (include_timers)
@@ -137,15 +137,32 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifier(int fd, const QSocketNotifierSetUNIX &sn_set, short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollInterest(int fd, short oldEvents, short newEvents);
+    int processEpollEvents(const timespec *tm);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
 
+#if QT_CONFIG(epoll)
+    // if epollFd is -1, the poll(2) backend is in use; otherwise the kernel
+    // interest set mirrors socketNotifiers and is only touched when a
+    // notifier is registered or unregistered
+    int epollFd = -1;
+    // fds that epoll(7) refuses (e.g. regular files); like poll(2), we
+    // consider them always ready
+    QList<int> epollUnsupportedFds;
+#endif
+
     QTimerInfoList timerList;
     QAtomicInt interrupt; // bool
 };
@@ -2329,7 +2329,7 @@ bool QMetaMethod::invoke(QObject *object,
                 }
             }
             if (types[i] != QMetaType::UnknownType) {
-                args[i] = QMetaType::create(types[i], param[i]);
+                args[i] = event->createArgument(types[i], param[i]);
                 ++argIndex;
             }
         }
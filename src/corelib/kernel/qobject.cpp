@@ -220,7 +220,7 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (postedEvents || thisThreadData->postEventList.hasIncoming())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     thisThreadData->deref();
@@ -590,7 +590,11 @@ QMetaCallEvent::~QMetaCallEvent()
     if (d.nargs_) {
         int *typeIDs = types();
         for (int i = 0; i < d.nargs_; ++i) {
-            if (typeIDs[i] && d.args_[i])
+            if (!typeIDs[i] || !d.args_[i])
+                continue;
+            if (isInlineArgument(d.args_[i]))
+                QMetaType(typeIDs[i]).destruct(d.args_[i]);
+            else
                 QMetaType::destroy(typeIDs[i], d.args_[i]);
         }
         if (reinterpret_cast<void*>(d.args_) != reinterpret_cast<void*>(prealloc_))
@@ -600,6 +604,38 @@ QMetaCallEvent::~QMetaCallEvent()
         d.slotObj_->destroyIfLastRef();
 }
 
+/*!
+    \internal
+ */
+inline bool QMetaCallEvent::isInlineArgument(const void *arg) const
+{
+    const quintptr begin = quintptr(arguments_);
+    return quintptr(arg) >= begin && quintptr(arg) < begin + sizeof(arguments_);
+}
+
+/*!
+    \internal
+
+    Returns a copy of \a copy, of type \a type, for use as an argument of
+    a queued call. Small arguments are constructed in the event itself, so
+    that queueing them doesn't allocate memory; others are created on the
+    heap. Either way, the event destroys them.
+ */
+void *QMetaCallEvent::createArgument(int type, const void *copy)
+{
+    const QMetaType metaType(type);
+    const uint size = uint(metaType.sizeOf());
+    const uint alignment = uint(metaType.alignOf());
+    if (size && alignment && alignment <= alignof(std::max_align_t)) {
+        const uint offset = (argumentsUsed_ + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= sizeof(arguments_)) {
+            argumentsUsed_ = offset + size;
+            return metaType.construct(arguments_ + offset, copy);
+        }
+    }
+    return QMetaType::create(type, copy);
+}
+
 /*!
     \internal
  */
@@ -615,6 +651,147 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+ */
+QMetaCallBatch::~QMetaCallBatch()
+{
+    Q_ASSERT(!pending);
+    for (const Chunk &chunk : spareChunks)
+        delete [] chunk.data;
+}
+
+/*!
+    \internal
+
+    Creates an event that calls the slot of the batched connection \a c once
+    for each call append()ed to it. The event keeps \a c alive.
+ */
+QMetaCallBatchEvent::QMetaCallBatchEvent(QObjectPrivate::Connection *c,
+                                         const QObject *sender, int signalId,
+                                         const int *argumentTypes, int nargs)
+    : QAbstractMetaCallEvent(sender, signalId),
+      connection(c),
+      slotObj(c->isSlotObject ? c->slotObj : nullptr),
+      callFunction(c->isSlotObject ? nullptr : c->callFunction),
+      argumentTypes(argumentTypes),
+      nargs(nargs),
+      method_offset(c->method_offset),
+      method_relative(c->method_relative)
+{
+    Q_ASSERT(c->batch);
+    c->ref();
+    if (slotObj)
+        slotObj->ref();
+}
+
+/*!
+    \internal
+ */
+QMetaCallBatchEvent::~QMetaCallBatchEvent()
+{
+    for (void **args : calls) {
+        for (int n = 1; n < nargs; ++n)
+            QMetaType(argumentTypes[n - 1]).destruct(args[n]);
+    }
+
+    QMetaCallBatch *batch = connection->batch;
+    {
+        QBasicMutexLocker locker(&batch->mutex);
+        if (batch->pending == this)
+            batch->pending = nullptr;
+        for (const QMetaCallBatch::Chunk &chunk : chunks) {
+            if (chunk.size == QMetaCallBatch::ChunkSize
+                    && batch->spareChunks.size() < QMetaCallBatch::MaxSpareChunks) {
+                batch->spareChunks.push_back(chunk);
+            } else {
+                delete [] chunk.data;
+            }
+        }
+    }
+
+    if (slotObj)
+        slotObj->destroyIfLastRef();
+    connection->deref();
+}
+
+/*!
+    \internal
+
+    Returns \a size bytes aligned to \a alignment from the chunks of this
+    event, taking a new chunk from the batch if needed.
+ */
+void *QMetaCallBatchEvent::allocate(size_t size, size_t alignment)
+{
+    if (!chunks.empty()) {
+        const QMetaCallBatch::Chunk &chunk = chunks.back();
+        const quintptr begin = quintptr(chunk.data);
+        const quintptr p = (begin + used + alignment - 1) & ~quintptr(alignment - 1);
+        if (p + size <= begin + chunk.size) {
+            used = p + size - begin;
+            return reinterpret_cast<void *>(p);
+        }
+    }
+
+    QMetaCallBatch *batch = connection->batch;
+    QMetaCallBatch::Chunk chunk;
+    if (size + alignment <= QMetaCallBatch::ChunkSize && !batch->spareChunks.empty()) {
+        chunk = batch->spareChunks.back();
+        batch->spareChunks.pop_back();
+    } else {
+        chunk.size = qMax(size_t(QMetaCallBatch::ChunkSize), size + alignment);
+        chunk.data = new char[chunk.size];
+    }
+    chunks.push_back(chunk);
+    used = 0;
+    return allocate(size, alignment);
+}
+
+/*!
+    \internal
+
+    Adds a call with the arguments \a argv of a signal emission.
+ */
+void QMetaCallBatchEvent::append(void **argv)
+{
+    void **args = static_cast<void **>(allocate(nargs * sizeof(void *), alignof(void *)));
+    args[0] = nullptr; // return value
+    for (int n = 1; n < nargs; ++n) {
+        const QMetaType type(argumentTypes[n - 1]);
+        void *where = allocate(size_t(type.sizeOf()), size_t(qMax(type.alignOf(), 1)));
+        args[n] = type.construct(where, argv[n]);
+    }
+    calls.push_back(args);
+}
+
+/*!
+    \internal
+ */
+void QMetaCallBatchEvent::placeMetaCall(QObject *object)
+{
+    {
+        // emissions from now on go to a new event
+        QMetaCallBatch *batch = connection->batch;
+        QBasicMutexLocker locker(&batch->mutex);
+        if (batch->pending == this)
+            batch->pending = nullptr;
+    }
+
+    QPointer<QObject> guard(object);
+    for (void **args : calls) {
+        if (slotObj) {
+            slotObj->call(object, args);
+        } else if (callFunction && method_offset <= object->metaObject()->methodOffset()) {
+            callFunction(object, QMetaObject::InvokeMetaMethod, method_relative, args);
+        } else {
+            QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod,
+                                  method_offset + method_relative, args);
+        }
+        if (!guard)
+            break; // a slot deleted the receiver
+    }
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -1089,6 +1266,7 @@ QObjectPrivate::Connection::~Connection()
     }
     if (isSlotObject)
         slotObj->destroyIfLastRef();
+    delete batch;
 }
 
 
@@ -1567,6 +1745,10 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // events posted without locking are moved below, like the others
+    if (currentData->postEventList.hasIncoming())
+        QCoreApplicationPrivate::takeIncomingPostedEvents(currentData);
+
     // move the object
     d_func()->setThreadData_helper(currentData, targetData);
 
@@ -2816,7 +2998,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     }
 
     int *types = nullptr;
-    if ((type == Qt::QueuedConnection)
+    if (((type & ~Qt::BatchedConnection) == Qt::QueuedConnection)
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(nullptr);
     }
@@ -2897,7 +3079,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = nullptr;
-    if ((type == Qt::QueuedConnection)
+    if (((type & ~Qt::BatchedConnection) == Qt::QueuedConnection)
             && !(types = queuedConnectionTypes(signal.parameterTypes())))
         return QMetaObject::Connection(nullptr);
 
@@ -3363,6 +3545,10 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->receiverThreadData.storeRelaxed(td);
     c->method_relative = method_index;
     c->method_offset = method_offset;
+    if (type & Qt::BatchedConnection) {
+        c->batch = new QMetaCallBatch;
+        type &= ~Qt::BatchedConnection;
+    }
     c->connectionType = type;
     c->isSlotObject = false;
     c->argumentTypes.storeRelaxed(types);
@@ -3632,6 +3818,56 @@ void QMetaObject::connectSlotsByName(QObject *o)
     }
 }
 
+/*!
+    \internal
+
+    Adds the emission to the pending event of the batched connection \a c,
+    or posts a new one.
+*/
+static void batched_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                             void **argv, const int *argumentTypes, int nargs)
+{
+    QMetaCallBatch *batch = c->batch;
+    {
+        QBasicMutexLocker batchLocker(&batch->mutex);
+        if (QMetaCallBatchEvent *pending = batch->pending) {
+            pending->append(argv);
+            return;
+        }
+    }
+
+    QBasicMutexLocker locker(signalSlotLock(c->receiver.loadRelaxed()));
+    if (!c->receiver.loadRelaxed()) {
+        // the connection has been disconnected before we got the lock
+        return;
+    }
+    QMetaCallBatchEvent *ev = new QMetaCallBatchEvent(c, sender, signal, argumentTypes, nargs);
+    locker.unlock();
+
+    {
+        QBasicMutexLocker batchLocker(&batch->mutex);
+        if (QMetaCallBatchEvent *pending = batch->pending) {
+            // another thread posted one in the meantime
+            pending->append(argv);
+            batchLocker.unlock();
+            delete ev;
+            return;
+        }
+        ev->append(argv);
+        batch->pending = ev;
+    }
+
+    locker.relock();
+    if (!c->receiver.loadRelaxed()) {
+        // the connection has been disconnected while we were unlocked
+        locker.unlock();
+        delete ev;
+        return;
+    }
+
+    QCoreApplication::postEvent(c->receiver.loadRelaxed(), ev);
+}
+
 /*!
     \internal
 
@@ -3657,6 +3893,11 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     while (argumentTypes[nargs-1])
         ++nargs;
 
+    if (c->batch) {
+        batched_activate(sender, signal, c, argv, argumentTypes, nargs);
+        return;
+    }
+
     QBasicMutexLocker locker(signalSlotLock(c->receiver.loadRelaxed()));
     if (!c->receiver.loadRelaxed()) {
         // the connection has been disconnected before we got the lock
@@ -3681,7 +3922,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
             types[n] = argumentTypes[n-1];
 
         for (int n = 1; n < nargs; ++n)
-            args[n] = QMetaType::create(types[n], argv[n]);
+            args[n] = ev->createArgument(types[n], argv[n]);
     }
 
     locker.relock();
@@ -4928,6 +5169,10 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     c->receiverThreadData.storeRelaxed(td);
     c->receiver.storeRelaxed(r);
     c->slotObj = slotObj;
+    if (type & Qt::BatchedConnection) {
+        c->batch = new QMetaCallBatch;
+        type = static_cast<Qt::ConnectionType>(type & ~Qt::BatchedConnection);
+    }
     c->connectionType = type;
     c->isSlotObject = true;
     if (types) {
@@ -55,17 +55,21 @@
 #include <QtCore/private/qglobal_p.h>
 #include "QtCore/qcoreevent.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qmutex.h"
 #include "QtCore/qobject.h"
 #include "QtCore/qpointer.h"
 #include "QtCore/qreadwritelock.h"
 #include "QtCore/qsharedpointer.h"
 #include "QtCore/qvariant.h"
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallBatch;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -148,6 +152,7 @@ public:
             QtPrivate::QSlotObjectBase *slotObj;
         };
         QAtomicPointer<const int> argumentTypes;
+        QMetaCallBatch *batch = nullptr; // for Qt::BatchedConnection
         QAtomicInt ref_;
         uint id = 0;
         ushort method_offset;
@@ -551,10 +556,14 @@ public:
     inline const int *types() const { return reinterpret_cast<int*>(d.args_ + d.nargs_); }
     inline int *types() { return reinterpret_cast<int*>(d.args_ + d.nargs_); }
 
+    // queued - copies an argument into the event, without allocating if it is small
+    void *createArgument(int type, const void *copy);
+
     virtual void placeMetaCall(QObject *object) override;
 
 private:
     inline void allocArgs();
+    inline bool isInlineArgument(const void *arg) const;
 
     struct Data {
         QtPrivate::QSlotObjectBase *slotObj_;
@@ -566,6 +575,58 @@ private:
     } d;
     // preallocate enough space for three arguments
     char prealloc_[3*(sizeof(void*) + sizeof(int))];
+    // and for the values of small arguments
+    uint argumentsUsed_ = 0;
+    alignas(std::max_align_t) char arguments_[32];
+};
+
+class QMetaCallBatchEvent;
+
+// the state shared by the emissions through a Qt::BatchedConnection
+class QMetaCallBatch
+{
+public:
+    struct Chunk {
+        char *data;
+        size_t size;
+    };
+    enum { ChunkSize = 4096, MaxSpareChunks = 16 };
+
+    ~QMetaCallBatch();
+
+    QBasicMutex mutex;
+    // the posted event that still takes calls, if any
+    QMetaCallBatchEvent *pending = nullptr;
+    // argument storage left by delivered events, reused by the next ones
+    std::vector<Chunk> spareChunks;
+};
+
+class QMetaCallBatchEvent : public QAbstractMetaCallEvent
+{
+public:
+    QMetaCallBatchEvent(QObjectPrivate::Connection *c, const QObject *sender, int signalId,
+                        const int *argumentTypes, int nargs);
+    ~QMetaCallBatchEvent() override;
+
+    // must be called with the batch mutex locked
+    void append(void **argv);
+    inline int count() const { return int(calls.size()); }
+
+    virtual void placeMetaCall(QObject *object) override;
+
+private:
+    void *allocate(size_t size, size_t alignment);
+
+    QObjectPrivate::Connection *connection;
+    QtPrivate::QSlotObjectBase *slotObj;
+    QObjectPrivate::StaticMetaCallFunction callFunction;
+    const int *argumentTypes; // owned by the connection
+    int nargs;
+    ushort method_offset;
+    ushort method_relative;
+    std::vector<void **> calls;
+    std::vector<QMetaCallBatch::Chunk> chunks;
+    size_t used = 0; // in chunks.back()
 };
 
 class QBoolBlocker
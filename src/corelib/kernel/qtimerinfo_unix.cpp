@@ -53,10 +53,232 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
 
+/*
+  Returns the distance from \a from to the next set bit in the circular
+  bitmap \a words, or -1 if no bit is set.
+*/
+static int nextSetBit(const quint64 *words, int wordCount, int from)
+{
+    const int bits = wordCount * 64;
+    for (int offset = 0; offset < bits; ) {
+        const int pos = (from + offset) % bits;
+        const quint64 word = words[pos / 64] >> (pos % 64);
+        if (word)
+            return offset + int(qCountTrailingZeroBits(word));
+        offset += 64 - pos % 64;
+    }
+    return -1;
+}
+
+QTimerWheel::QTimerWheel(qint64 tick)
+    : currentTick(tick), expired(nullptr)
+{
+    std::fill_n(root, int(RootSize), nullptr);
+    std::fill_n(&levels[0][0], int(Levels * LevelSize), nullptr);
+    std::fill_n(rootBitmap, int(RootSize / 64), 0);
+    std::fill_n(levelBitmaps, int(Levels), 0);
+}
+
+qint64 QTimerWheel::tickForTimeout(const timespec &timeout)
+{
+    // round up, so that timers never fire early
+    return qint64(timeout.tv_sec) * 1000 + (timeout.tv_nsec + 999999) / 1000000;
+}
+
+qint64 QTimerWheel::tickForCurrentTime(const timespec &currentTime)
+{
+    return qint64(currentTime.tv_sec) * 1000 + currentTime.tv_nsec / 1000000;
+}
+
+timespec QTimerWheel::timeoutForTick(qint64 tick)
+{
+    timespec ts;
+    ts.tv_sec = tick / 1000;
+    ts.tv_nsec = tick % 1000 * 1000 * 1000;
+    return ts;
+}
+
+void QTimerWheel::link(QTimerInfo **slot, QTimerInfo *t)
+{
+    t->wheelNext = *slot;
+    if (t->wheelNext)
+        t->wheelNext->wheelPrev = &t->wheelNext;
+    t->wheelPrev = slot;
+    *slot = t;
+}
+
+void QTimerWheel::insert(QTimerInfo *t)
+{
+    const qint64 maxDelta = (Q_INT64_C(1) << levelShift(Levels)) - 1;
+    qint64 tick = tickForTimeout(t->timeout);
+    qint64 delta = tick - currentTick;
+    if (delta < 0) {
+        // overdue, fire on the next advance()
+        tick = currentTick;
+        delta = 0;
+    } else if (delta > maxDelta) {
+        // refiled with the real timeout when the last slot cascades
+        tick = currentTick + maxDelta;
+        delta = maxDelta;
+    }
+
+    if (delta < RootSize) {
+        const int index = int(tick & (RootSize - 1));
+        link(&root[index], t);
+        rootBitmap[index / 64] |= Q_UINT64_C(1) << (index % 64);
+        return;
+    }
+
+    int level = 0;
+    while (delta >= (Q_INT64_C(1) << levelShift(level + 1)))
+        ++level;
+    const int index = int((tick >> levelShift(level)) & (LevelSize - 1));
+    link(&levels[level][index], t);
+    levelBitmaps[level] |= Q_UINT64_C(1) << index;
+}
+
+void QTimerWheel::remove(QTimerInfo *t)
+{
+    QTimerInfo **slot = t->wheelPrev;
+    if (!slot)
+        return;
+
+    *slot = t->wheelNext;
+    if (t->wheelNext)
+        t->wheelNext->wheelPrev = slot;
+    t->wheelNext = nullptr;
+    t->wheelPrev = nullptr;
+
+    if (!*slot)
+        slotEmptied(slot);
+}
+
+/*
+  Clears the bitmap bit of \a slot, if it is one of the wheel's slots
+  rather than the expired list or the link of the previous timer.
+*/
+void QTimerWheel::slotEmptied(QTimerInfo **slot)
+{
+    const std::less<QTimerInfo **> less;
+    if (!less(slot, root) && less(slot, root + RootSize)) {
+        const int index = int(slot - root);
+        rootBitmap[index / 64] &= ~(Q_UINT64_C(1) << (index % 64));
+        return;
+    }
+
+    QTimerInfo **first = &levels[0][0];
+    if (!less(slot, first) && less(slot, first + Levels * LevelSize)) {
+        const int index = int(slot - first);
+        levelBitmaps[index / LevelSize] &= ~(Q_UINT64_C(1) << (index % LevelSize));
+    }
+}
+
+void QTimerWheel::cascade(int level, int index)
+{
+    QTimerInfo *t = levels[level][index];
+    if (!t)
+        return;
+
+    levels[level][index] = nullptr;
+    levelBitmaps[level] &= ~(Q_UINT64_C(1) << index);
+
+    while (t) {
+        QTimerInfo *next = t->wheelNext;
+        t->wheelNext = nullptr;
+        t->wheelPrev = nullptr;
+        insert(t);
+        t = next;
+    }
+}
+
+void QTimerWheel::expire(int index)
+{
+    while (QTimerInfo *t = root[index]) {
+        remove(t);
+        link(&expired, t);
+    }
+}
+
+void QTimerWheel::advance(qint64 tick)
+{
+    qint64 next;
+    while (nextSlotTick(&next) && next <= tick) {
+        // nothing happens in the ticks we skip
+        currentTick = next;
+
+        const int index = int(currentTick & (RootSize - 1));
+        if (index == 0) {
+            for (int level = 0; level < Levels; ++level) {
+                const int levelIndex = int((currentTick >> levelShift(level)) & (LevelSize - 1));
+                cascade(level, levelIndex);
+                if (levelIndex)
+                    break;
+            }
+        }
+        expire(index);
+        ++currentTick;
+    }
+
+    if (currentTick <= tick)
+        currentTick = tick + 1;
+}
+
+QTimerInfo *QTimerWheel::takeExpired()
+{
+    QTimerInfo *t = expired;
+    if (t)
+        remove(t);
+    return t;
+}
+
+/*
+  Returns the first tick at which advance() has something to do: either a
+  first level slot becomes due, or a higher level slot cascades.
+*/
+bool QTimerWheel::nextSlotTick(qint64 *tick) const
+{
+    bool found = false;
+
+    const int rootOffset = nextSetBit(rootBitmap, RootSize / 64, int(currentTick & (RootSize - 1)));
+    if (rootOffset >= 0) {
+        *tick = currentTick + rootOffset;
+        found = true;
+    }
+
+    for (int level = 0; level < Levels; ++level) {
+        if (!levelBitmaps[level])
+            continue;
+
+        // the first slot boundary we haven't processed yet
+        const int shift = levelShift(level);
+        const qint64 base = (currentTick + (Q_INT64_C(1) << shift) - 1) >> shift;
+        const int offset = nextSetBit(&levelBitmaps[level], 1, int(base & (LevelSize - 1)));
+        const qint64 cascadeTick = (base + offset) << shift;
+        if (!found || cascadeTick < *tick) {
+            *tick = cascadeTick;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+bool QTimerWheel::nextTick(qint64 *tick) const
+{
+    if (expired) {
+        *tick = currentTick - 1;
+        return true;
+    }
+    return nextSlotTick(tick);
+}
+
 /*
  * Internal functions for manipulating timer data structures.  The
  * timerBitVec array is used for keeping track of timer identifiers.
@@ -86,6 +308,28 @@ QTimerInfoList::QTimerInfoList()
     firstTimerInfo = nullptr;
 }
 
+QTimerInfoList::~QTimerInfoList()
+{
+    // the dispatchers delete the timers in the list, the wheel's are ours
+    qDeleteAll(wheelTimers);
+}
+
+/*
+  Keeps coarse and very coarse timers in a QTimerWheel from now on, so
+  that registering, unregistering and firing them doesn't depend on the
+  number of timers. Only possible while no timers are registered.
+*/
+bool QTimerInfoList::enableTimerWheel()
+{
+    if (wheel)
+        return true;
+    if (!QElapsedTimer::isMonotonic() || !isEmpty())
+        return false;
+
+    wheel.reset(new QTimerWheel(QTimerWheel::tickForCurrentTime(updateCurrentTime())));
+    return true;
+}
+
 timespec QTimerInfoList::updateCurrentTime()
 {
     return (currentTime = qt_gettime());
@@ -389,20 +633,28 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
+    const timespec *timeout = nullptr;
     for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
         if (!(*it)->activateRef) {
-            t = *it;
+            timeout = &(*it)->timeout;
             break;
         }
     }
 
-    if (!t)
+    timespec wheelTimeout;
+    qint64 wheelTick;
+    if (wheel && wheel->nextTick(&wheelTick)) {
+        wheelTimeout = QTimerWheel::timeoutForTick(wheelTick);
+        if (!timeout || wheelTimeout < *timeout)
+            timeout = &wheelTimeout;
+    }
+
+    if (!timeout)
       return false;
 
-    if (currentTime < t->timeout) {
+    if (currentTime < *timeout) {
         // time to wait
-        tm = roundToMillisecond(t->timeout - currentTime);
+        tm = roundToMillisecond(*timeout - currentTime);
     } else {
         // no time to wait
         tm.tv_sec  = 0;
@@ -423,16 +675,19 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    QTimerInfo *t = wheelTimers.value(timerId);
+    for (int i = 0; !t && i < count(); ++i) {
+        if (at(i)->id == timerId)
+            t = at(i);
+    }
+
+    if (t) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -451,6 +706,8 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     t->timerType = timerType;
     t->obj = object;
     t->activateRef = nullptr;
+    t->wheelNext = nullptr;
+    t->wheelPrev = nullptr;
 
     timespec expected = updateCurrentTime() + interval;
 
@@ -493,7 +750,11 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
             ++t->timeout.tv_sec;
     }
 
-    timerInsert(t);
+    if (wheel && t->timerType != Qt::PreciseTimer) {
+        insertWheelTimer(t);
+    } else {
+        timerInsert(t);
+    }
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -505,8 +766,45 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 #endif
 }
 
+void QTimerInfoList::insertWheelTimer(QTimerInfo *t)
+{
+    wheel->insert(t);
+    wheelTimers.insert(t->id, t);
+
+    QTimerInfo *&first = wheelTimersByObject[t->obj];
+    t->objectNext = first;
+    t->objectPrev = nullptr;
+    if (first)
+        first->objectPrev = t;
+    first = t;
+}
+
+void QTimerInfoList::removeWheelTimer(QTimerInfo *t)
+{
+    wheel->remove(t);
+    wheelTimers.remove(t->id);
+
+    if (t->objectNext)
+        t->objectNext->objectPrev = t->objectPrev;
+    if (t->objectPrev)
+        t->objectPrev->objectNext = t->objectNext;
+    else if (t->objectNext)
+        wheelTimersByObject.insert(t->obj, t->objectNext);
+    else
+        wheelTimersByObject.remove(t->obj);
+
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+}
+
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
+    if (QTimerInfo *t = wheelTimers.value(timerId)) {
+        removeWheelTimer(t);
+        return true;
+    }
+
     // set timer inactive
     for (int i = 0; i < count(); ++i) {
         QTimerInfo *t = at(i);
@@ -527,8 +825,10 @@ bool QTimerInfoList::unregisterTimer(int timerId)
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
-    if (isEmpty())
+    if (isEmpty() && wheelTimers.isEmpty())
         return false;
+    while (QTimerInfo *t = wheelTimersByObject.value(object))
+        removeWheelTimer(t);
     for (int i = 0; i < count(); ++i) {
         QTimerInfo *t = at(i);
         if (t->obj == object) {
@@ -559,6 +859,13 @@ QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObj
                                                         t->timerType);
         }
     }
+    for (const QTimerInfo *t = wheelTimersByObject.value(object); t; t = t->objectNext) {
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
+    }
     return list;
 }
 
@@ -567,7 +874,7 @@ QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObj
 */
 int QTimerInfoList::activateTimers()
 {
-    if (qt_disable_lowpriority_timers || isEmpty())
+    if (qt_disable_lowpriority_timers || (isEmpty() && wheelTimers.isEmpty()))
         return 0; // nothing to do
 
     int n_act = 0, maxCount = 0;
@@ -648,8 +955,41 @@ int QTimerInfoList::activateTimers()
     }
 
     firstTimerInfo = nullptr;
+
+    n_act += activateWheelTimers(currentTime);
+
     // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
 
+int QTimerInfoList::activateWheelTimers(timespec currentTime)
+{
+    if (!wheel)
+        return 0;
+
+    int n_act = 0;
+    wheel->advance(QTimerWheel::tickForCurrentTime(currentTime));
+
+    // timers are refiled before being sent, so none of them fires twice
+    while (QTimerInfo *currentTimerInfo = wheel->takeExpired()) {
+        calculateNextTimeout(currentTimerInfo, currentTime);
+        wheel->insert(currentTimerInfo);
+        if (currentTimerInfo->interval > 0)
+            n_act++;
+
+        if (!currentTimerInfo->activateRef) {
+            // send event, but don't allow it to recurse
+            currentTimerInfo->activateRef = &currentTimerInfo;
+
+            QTimerEvent e(currentTimerInfo->id);
+            QCoreApplication::sendEvent(currentTimerInfo->obj, &e);
+
+            if (currentTimerInfo)
+                currentTimerInfo->activateRef = nullptr;
+        }
+    }
+
+    return n_act;
+}
+
 QT_END_NAMESPACE
@@ -56,6 +56,8 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
+#include "qscopedpointer.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +71,10 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    QTimerInfo *wheelNext;  // - next timer in the same QTimerWheel slot
+    QTimerInfo **wheelPrev; // - link pointing to this timer in its QTimerWheel slot
+    QTimerInfo *objectNext; // - next wheel timer of the same object
+    QTimerInfo *objectPrev; // - previous wheel timer of the same object
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,6 +83,55 @@ struct QTimerInfo {
 #endif
 };
 
+// Hierarchical timing wheel with millisecond ticks.
+// The first level has 256 one-tick slots, each of the four following levels
+// has 64 slots that cover the whole span of the level below, so timeouts up
+// to 2^32 ms (about 49 days) ahead are stored exactly; later ones are parked
+// in the last slot and re-filed when they cascade down. Insertion and removal
+// are O(1); advance() only visits the ticks at which something is due.
+class QTimerWheel
+{
+public:
+    explicit QTimerWheel(qint64 tick);
+
+    static qint64 tickForTimeout(const timespec &timeout);
+    static qint64 tickForCurrentTime(const timespec &currentTime);
+    static timespec timeoutForTick(qint64 tick);
+
+    void insert(QTimerInfo *t);
+    void remove(QTimerInfo *t);
+
+    // move all timers due at or before tick to the expired list
+    void advance(qint64 tick);
+    QTimerInfo *takeExpired();
+
+    bool nextTick(qint64 *tick) const;
+
+private:
+    enum {
+        RootBits = 8,
+        RootSize = 1 << RootBits,
+        LevelBits = 6,
+        LevelSize = 1 << LevelBits,
+        Levels = 4
+    };
+
+    static int levelShift(int level) { return RootBits + level * LevelBits; }
+
+    void link(QTimerInfo **slot, QTimerInfo *t);
+    void slotEmptied(QTimerInfo **slot);
+    bool nextSlotTick(qint64 *tick) const;
+    void cascade(int level, int index);
+    void expire(int index);
+
+    qint64 currentTick; // next tick to process
+    QTimerInfo *expired;
+    QTimerInfo *root[RootSize];
+    QTimerInfo *levels[Levels][LevelSize];
+    quint64 rootBitmap[RootSize / 64];
+    quint64 levelBitmaps[Levels];
+};
+
 class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
@@ -92,8 +147,22 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // coarse timers, if enabled; precise ones always stay in the sorted list
+    QScopedPointer<QTimerWheel> wheel;
+    QHash<int, QTimerInfo *> wheelTimers;
+    QHash<QObject *, QTimerInfo *> wheelTimersByObject; // first of each object's timers
+
+    void insertWheelTimer(QTimerInfo *t);
+    void removeWheelTimer(QTimerInfo *t);
+    int activateWheelTimers(timespec currentTime);
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
+
+    // only for dispatchers that exclusively use the functions below, as
+    // the QList part then no longer holds all timers
+    bool enableTimerWheel();
 
     timespec currentTime;
     timespec updateCurrentTime();
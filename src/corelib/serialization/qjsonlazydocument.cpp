@@ -0,0 +1,704 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonlazydocument_p.h"
+#include "qjsonparser_p.h"
+#include "qjson_p.h"
+
+#include <qfile.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonLazyDocument
+    \inmodule QtCore
+    \internal
+    \since 6.1
+
+    \brief The QJsonLazyDocument class provides read-only access to a JSON
+    document without converting all of it.
+
+    QJsonDocument::fromJson() converts every object and array of a document
+    when it is parsed. QJsonLazyDocument instead keeps the UTF-8 source,
+    either a QByteArray or a memory-mapped file, and only checks its
+    structure when it is created. Values are converted when they are
+    accessed through QJsonLazyValue, using the same code as the parser of
+    QJsonDocument, so the memory used grows with the parts of the document
+    that are read rather than with its size.
+
+    Errors inside strings and numbers, such as invalid escape sequences or
+    numbers that do not fit into a double, are only found when the value is
+    read, in which case it reads as undefined. All other errors are
+    reported by fromJson() and fromFile() with the same code and offset
+    QJsonDocument::fromJson() reports.
+
+    \sa QJsonLazyValue, QJsonDocument
+*/
+
+/*!
+    \class QJsonLazyValue
+    \inmodule QtCore
+    \internal
+    \since 6.1
+
+    \brief The QJsonLazyValue class refers to a value in a QJsonLazyDocument.
+
+    The accessors mirror the ones of QJsonValue. Looking up a key that does
+    not exist, or an index out of range, returns an undefined value.
+    Objects and arrays remember the positions of their members after the
+    first lookup, so repeated lookups in the same object do not scan the
+    document again.
+*/
+
+static const int nestingLimit = 1024;
+
+class QJsonLazyDocumentPrivate : public QSharedData
+{
+public:
+    // the direct children of an array, or of an object sorted by key
+    struct Container
+    {
+        QStringList keys;
+        QList<qsizetype> values;
+    };
+
+    const char *data() const { return json.constData(); }
+    qsizetype size() const { return json.size(); }
+
+    bool validate();
+    Container container(qsizetype offset);
+    qsizetype containerEnd(qsizetype offset) const;
+    QCborValue scalarAt(qsizetype offset) const;
+
+    // must outlive json, which refers to the mapped memory
+    std::unique_ptr<QFile> file;
+    QByteArray json;
+    qsizetype rootOffset = -1;
+
+private:
+    Container scanContainer(qsizetype offset) const;
+    QString keyAt(const char *quote, const char *close) const;
+
+    QMutex mutex;
+    QHash<qsizetype, Container> containers;
+};
+
+static inline bool isDelimiterAfterScalar(char c)
+{
+    switch (c) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case ',':
+    case ']':
+    case '}':
+        return true;
+    }
+    return false;
+}
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Accepts the same numbers and literals as the parser, up to the conversion
+// of the number.
+static bool isValidScalar(const char *json, const char *end)
+{
+    const auto literal = [&](const char *text, qsizetype length) {
+        if (end - json <= length || memcmp(json, text, length) != 0)
+            return false;
+        json += length;
+        return true;
+    };
+
+    switch (*json) {
+    case 'n':
+        if (!literal("null", 4))
+            return false;
+        break;
+    case 't':
+        if (!literal("true", 4))
+            return false;
+        break;
+    case 'f':
+        if (!literal("false", 5))
+            return false;
+        break;
+    default:
+        if (json < end && *json == '-')
+            ++json;
+        if (json < end && *json == '0') {
+            ++json;
+        } else {
+            while (json < end && isDigit(*json))
+                ++json;
+        }
+        if (json < end && *json == '.') {
+            ++json;
+            while (json < end && isDigit(*json))
+                ++json;
+        }
+        if (json < end && (*json == 'e' || *json == 'E')) {
+            ++json;
+            if (json < end && (*json == '-' || *json == '+'))
+                ++json;
+            while (json < end && isDigit(*json))
+                ++json;
+        }
+        break;
+    }
+    return json < end && isDelimiterAfterScalar(*json);
+}
+
+bool QJsonLazyDocumentPrivate::validate()
+{
+    enum Expect { Value, ValueOrEnd, Key, KeyOrEnd, Colon, SeparatorOrEnd };
+
+    const char *begin = data();
+    const char *end = begin + size();
+    if (end - begin > 3 && uchar(begin[0]) == 0xef && uchar(begin[1]) == 0xbb
+            && uchar(begin[2]) == 0xbf) {
+        begin += 3;
+    }
+
+    QJsonPrivate::StructuralIndex index(begin, end);
+    const char *token = index.next();
+    if (!token || (*token != '[' && *token != '{'))
+        return false;
+    rootOffset = token - data();
+
+    QVarLengthArray<char, 64> open;
+    open.append(*token == '[' ? ']' : '}');
+    Expect expect = *token == '[' ? ValueOrEnd : KeyOrEnd;
+    while (!open.isEmpty()) {
+        token = index.next();
+        if (!token)
+            return false;
+
+        switch (expect) {
+        case KeyOrEnd:
+            if (*token == '}') {
+                open.removeLast();
+                expect = SeparatorOrEnd;
+                break;
+            }
+            Q_FALLTHROUGH();
+        case Key:
+            if (*token != '"' || !index.next())
+                return false;
+            expect = Colon;
+            break;
+        case Colon:
+            if (*token != ':')
+                return false;
+            expect = Value;
+            break;
+        case ValueOrEnd:
+            if (*token == ']') {
+                open.removeLast();
+                expect = SeparatorOrEnd;
+                break;
+            }
+            Q_FALLTHROUGH();
+        case Value:
+            switch (*token) {
+            case '[':
+            case '{':
+                if (open.size() >= nestingLimit)
+                    return false;
+                open.append(*token == '[' ? ']' : '}');
+                expect = *token == '[' ? ValueOrEnd : KeyOrEnd;
+                break;
+            case '"':
+                if (!index.next())
+                    return false;
+                expect = SeparatorOrEnd;
+                break;
+            case ']':
+            case '}':
+            case ':':
+            case ',':
+                return false;
+            default:
+                if (!isValidScalar(token, end))
+                    return false;
+                expect = SeparatorOrEnd;
+                break;
+            }
+            break;
+        case SeparatorOrEnd:
+            if (*token == ',') {
+                expect = open.last() == ']' ? Value : Key;
+            } else if (*token == open.last()) {
+                open.removeLast();
+            } else {
+                return false;
+            }
+            break;
+        }
+    }
+
+    // anything after the root would have been indexed
+    return !index.next() && index.atEnd();
+}
+
+QString QJsonLazyDocumentPrivate::keyAt(const char *quote, const char *close) const
+{
+    const char *key = quote + 1;
+    if (!memchr(key, '\\', close - key))
+        return QString::fromUtf8(key, close - key);
+
+    const char *end = data() + size();
+    return QJsonPrivate::Parser(quote, int(end - quote)).parseScalar().toString();
+}
+
+QJsonLazyDocumentPrivate::Container QJsonLazyDocumentPrivate::scanContainer(qsizetype offset) const
+{
+    const char *begin = data();
+    const bool isObject = begin[offset] == '{';
+    QJsonPrivate::StructuralIndex index(begin + offset + 1, begin + size());
+
+    QList<std::pair<QString, qsizetype>> members;
+    Container result;
+    QString key;
+    bool expectKey = isObject;
+    bool expectValue = !isObject;
+    int depth = 0;
+    while (const char *token = index.next()) {
+        if (depth == 0 && expectValue && *token != ']' && *token != '}') {
+            if (isObject)
+                members.append({ key, token - begin });
+            else
+                result.values.append(token - begin);
+            expectValue = false;
+        }
+
+        switch (*token) {
+        case '[':
+        case '{':
+            ++depth;
+            break;
+        case ']':
+        case '}':
+            --depth;
+            break;
+        case '"': {
+            const char *close = index.next();
+            if (depth == 0 && expectKey) {
+                key = keyAt(token, close);
+                expectKey = false;
+            }
+            break;
+        }
+        case ':':
+            expectValue = depth == 0;
+            break;
+        case ',':
+            if (depth == 0) {
+                expectKey = isObject;
+                expectValue = !isObject;
+            }
+            break;
+        }
+        if (depth < 0)
+            break;
+    }
+
+    if (isObject) {
+        // same as QJsonObject: sorted by key, keeping the last of duplicates
+        std::stable_sort(members.begin(), members.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        result.keys.reserve(members.size());
+        result.values.reserve(members.size());
+        for (qsizetype i = 0; i < members.size(); ++i) {
+            if (i + 1 < members.size() && members.at(i + 1).first == members.at(i).first)
+                continue;
+            result.keys.append(members.at(i).first);
+            result.values.append(members.at(i).second);
+        }
+    }
+    return result;
+}
+
+QJsonLazyDocumentPrivate::Container QJsonLazyDocumentPrivate::container(qsizetype offset)
+{
+    QMutexLocker locker(&mutex);
+    auto it = containers.constFind(offset);
+    if (it != containers.constEnd())
+        return *it;
+    locker.unlock();
+
+    Container result = scanContainer(offset);
+
+    locker.relock();
+    containers.insert(offset, result);
+    return result;
+}
+
+qsizetype QJsonLazyDocumentPrivate::containerEnd(qsizetype offset) const
+{
+    const char *begin = data();
+    QJsonPrivate::StructuralIndex index(begin + offset, begin + size());
+    int depth = 0;
+    while (const char *token = index.next()) {
+        switch (*token) {
+        case '[':
+        case '{':
+            ++depth;
+            break;
+        case ']':
+        case '}':
+            if (--depth == 0)
+                return token + 1 - begin;
+            break;
+        case '"':
+            index.next();
+            break;
+        }
+    }
+    Q_UNREACHABLE(); // the document was validated
+    return size();
+}
+
+QCborValue QJsonLazyDocumentPrivate::scalarAt(qsizetype offset) const
+{
+    return QJsonPrivate::Parser(data() + offset, int(size() - offset)).parseScalar();
+}
+
+/*!
+    Constructs an undefined value.
+*/
+QJsonLazyValue::QJsonLazyValue() = default;
+
+QJsonLazyValue::QJsonLazyValue(QJsonLazyDocumentPrivate *d, qsizetype offset)
+    : d(d), offset(offset)
+{
+}
+
+QJsonLazyValue::QJsonLazyValue(const QJsonLazyValue &other) = default;
+
+QJsonLazyValue::QJsonLazyValue(QJsonLazyValue &&other) noexcept
+    : d(std::move(other.d)), offset(std::exchange(other.offset, -1))
+{
+}
+
+QJsonLazyValue &QJsonLazyValue::operator=(const QJsonLazyValue &other) = default;
+QJsonLazyValue::~QJsonLazyValue() = default;
+
+/*!
+    Returns the type of the value, without converting it. Numbers are of
+    type QJsonValue::Double, like in QJsonValue.
+*/
+QJsonValue::Type QJsonLazyValue::type() const
+{
+    if (!d || offset < 0)
+        return QJsonValue::Undefined;
+    switch (d->data()[offset]) {
+    case '{':
+        return QJsonValue::Object;
+    case '[':
+        return QJsonValue::Array;
+    case '"':
+        return QJsonValue::String;
+    case 't':
+    case 'f':
+        return QJsonValue::Bool;
+    case 'n':
+        return QJsonValue::Null;
+    default:
+        return QJsonValue::Double;
+    }
+}
+
+/*!
+    Returns the value as a bool, or \a defaultValue if it is not a bool.
+*/
+bool QJsonLazyValue::toBool(bool defaultValue) const
+{
+    return isBool() ? d->data()[offset] == 't' : defaultValue;
+}
+
+/*!
+    Returns the value as an int, or \a defaultValue if it is not an integral
+    number that fits into an int.
+
+    \sa QJsonValue::toInt()
+*/
+int QJsonLazyValue::toInt(int defaultValue) const
+{
+    return isDouble() ? toJsonValue().toInt(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns the value as a 64-bit integer, or \a defaultValue if it is not
+    an integral number that fits.
+
+    \sa QJsonValue::toInteger()
+*/
+qint64 QJsonLazyValue::toInteger(qint64 defaultValue) const
+{
+    return isDouble() ? toJsonValue().toInteger(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns the value as a double, or \a defaultValue if it is not a number.
+*/
+double QJsonLazyValue::toDouble(double defaultValue) const
+{
+    return isDouble() ? toJsonValue().toDouble(defaultValue) : defaultValue;
+}
+
+/*!
+    Returns the value as a string, or a null string if it is not a string.
+*/
+QString QJsonLazyValue::toString() const
+{
+    return isString() ? toJsonValue().toString() : QString();
+}
+
+/*!
+    \overload
+
+    Returns \a defaultValue if the value is not a string.
+*/
+QString QJsonLazyValue::toString(const QString &defaultValue) const
+{
+    return isString() ? toJsonValue().toString(defaultValue) : defaultValue;
+}
+
+/*!
+    Converts the value, and for arrays and objects everything they contain,
+    to a QJsonValue.
+*/
+QJsonValue QJsonLazyValue::toJsonValue() const
+{
+    switch (type()) {
+    case QJsonValue::Undefined:
+        return QJsonValue(QJsonValue::Undefined);
+    case QJsonValue::Array:
+    case QJsonValue::Object: {
+        const qsizetype length = d->containerEnd(offset) - offset;
+        QJsonPrivate::Parser parser(d->data() + offset, int(length));
+        QJsonParseError error;
+        const QCborValue value = parser.parse(&error);
+        if (error.error != QJsonParseError::NoError)
+            return QJsonValue(QJsonValue::Undefined);
+        return QJsonPrivate::Value::fromTrustedCbor(value);
+    }
+    default:
+        return QJsonPrivate::Value::fromTrustedCbor(d->scalarAt(offset));
+    }
+}
+
+/*!
+    Returns the number of elements of an array or members of an object, or
+    0 for other values.
+*/
+qsizetype QJsonLazyValue::size() const
+{
+    if (!isArray() && !isObject())
+        return 0;
+    return d->container(offset).values.size();
+}
+
+/*!
+    Returns the sorted keys of an object, or an empty list for other values.
+*/
+QStringList QJsonLazyValue::keys() const
+{
+    if (!isObject())
+        return QStringList();
+    return d->container(offset).keys;
+}
+
+/*!
+    Returns \c true if this is an object containing \a key.
+*/
+bool QJsonLazyValue::contains(const QString &key) const
+{
+    return !value(key).isUndefined();
+}
+
+/*!
+    Returns the value of \a key in an object, or an undefined value if this
+    is not an object or it does not contain \a key.
+*/
+QJsonLazyValue QJsonLazyValue::value(const QString &key) const
+{
+    if (!isObject())
+        return QJsonLazyValue();
+    const QJsonLazyDocumentPrivate::Container c = d->container(offset);
+    const auto it = std::lower_bound(c.keys.cbegin(), c.keys.cend(), key);
+    if (it == c.keys.cend() || *it != key)
+        return QJsonLazyValue();
+    return QJsonLazyValue(d.data(), c.values.at(it - c.keys.cbegin()));
+}
+
+/*!
+    Returns element \a i of an array, or an undefined value if this is not
+    an array or \a i is out of range.
+*/
+QJsonLazyValue QJsonLazyValue::at(qsizetype i) const
+{
+    if (!isArray())
+        return QJsonLazyValue();
+    const QJsonLazyDocumentPrivate::Container c = d->container(offset);
+    if (i < 0 || i >= c.values.size())
+        return QJsonLazyValue();
+    return QJsonLazyValue(d.data(), c.values.at(i));
+}
+
+/*!
+    Constructs a null document.
+*/
+QJsonLazyDocument::QJsonLazyDocument() = default;
+QJsonLazyDocument::QJsonLazyDocument(const QJsonLazyDocument &other) = default;
+QJsonLazyDocument::QJsonLazyDocument(QJsonLazyDocument &&other) noexcept = default;
+QJsonLazyDocument &QJsonLazyDocument::operator=(const QJsonLazyDocument &other) = default;
+QJsonLazyDocument::~QJsonLazyDocument() = default;
+
+QJsonLazyDocument QJsonLazyDocument::create(QJsonLazyDocumentPrivate *d, QJsonParseError *error)
+{
+    QJsonLazyDocument result;
+    result.d = d;
+
+    QJsonParseError parseError;
+    parseError.offset = 0;
+    parseError.error = QJsonParseError::NoError;
+    if (d->size() > std::numeric_limits<int>::max()) {
+        parseError.error = QJsonParseError::DocumentTooLarge;
+    } else if (!d->validate()) {
+        // let the parser find out what and where the error is
+        QJsonPrivate::Parser parser(d->data(), int(d->size()));
+        parser.parse(&parseError, QJsonPrivate::Parser::Strategy::Sequential);
+        if (parseError.error == QJsonParseError::NoError)
+            parseError.error = QJsonParseError::IllegalValue;
+    }
+
+    if (parseError.error != QJsonParseError::NoError)
+        result.d.reset();
+    if (error)
+        *error = parseError;
+    return result;
+}
+
+/*!
+    Checks the structure of the UTF-8 encoded JSON document \a json and
+    returns a document that refers to it. The bytes are not copied if \a json
+    was created with QByteArray::fromRawData(), in which case they must
+    remain valid for the lifetime of the document and its values.
+
+    If the document is not valid, returns a null document and, if \a error
+    is not null, sets it to the same error QJsonDocument::fromJson() reports.
+*/
+QJsonLazyDocument QJsonLazyDocument::fromJson(const QByteArray &json, QJsonParseError *error)
+{
+    auto d = new QJsonLazyDocumentPrivate;
+    d->json = json;
+    return create(d, error);
+}
+
+/*!
+    Memory-maps the file \a fileName and returns a document that refers to
+    it, like fromJson(). The file is read into memory if it cannot be mapped.
+    A file that cannot be opened is reported like an empty document.
+*/
+QJsonLazyDocument QJsonLazyDocument::fromFile(const QString &fileName, QJsonParseError *error)
+{
+    auto d = new QJsonLazyDocumentPrivate;
+    d->file.reset(new QFile(fileName));
+    if (d->file->open(QIODevice::ReadOnly)) {
+        const qint64 size = d->file->size();
+        if (uchar *mapped = size > 0 ? d->file->map(0, size) : nullptr)
+            d->json = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size);
+        else
+            d->json = d->file->readAll();
+    }
+    return create(d, error);
+}
+
+/*!
+    Returns \c true if this document is null, that is, default-constructed
+    or the result of an error.
+*/
+bool QJsonLazyDocument::isNull() const
+{
+    return !d;
+}
+
+/*!
+    Returns \c true if the root of the document is an array.
+*/
+bool QJsonLazyDocument::isArray() const
+{
+    return root().isArray();
+}
+
+/*!
+    Returns \c true if the root of the document is an object.
+*/
+bool QJsonLazyDocument::isObject() const
+{
+    return root().isObject();
+}
+
+/*!
+    Returns the root array or object of the document, or an undefined value
+    if the document is null.
+*/
+QJsonLazyValue QJsonLazyDocument::root() const
+{
+    if (!d)
+        return QJsonLazyValue();
+    return QJsonLazyValue(d.data(), d->rootOffset);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,158 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QJSONLAZYDOCUMENT_P_H
+#define QJSONLAZYDOCUMENT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonLazyDocumentPrivate;
+
+class Q_CORE_EXPORT QJsonLazyValue
+{
+public:
+    QJsonLazyValue();
+    QJsonLazyValue(const QJsonLazyValue &other);
+    QJsonLazyValue &operator=(const QJsonLazyValue &other);
+    ~QJsonLazyValue();
+
+    QJsonLazyValue(QJsonLazyValue &&other) noexcept;
+    QJsonLazyValue &operator=(QJsonLazyValue &&other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(QJsonLazyValue &other) noexcept
+    {
+        qSwap(d, other.d);
+        qSwap(offset, other.offset);
+    }
+
+    QJsonValue::Type type() const;
+    bool isNull() const { return type() == QJsonValue::Null; }
+    bool isBool() const { return type() == QJsonValue::Bool; }
+    bool isDouble() const { return type() == QJsonValue::Double; }
+    bool isString() const { return type() == QJsonValue::String; }
+    bool isArray() const { return type() == QJsonValue::Array; }
+    bool isObject() const { return type() == QJsonValue::Object; }
+    bool isUndefined() const { return type() == QJsonValue::Undefined; }
+
+    bool toBool(bool defaultValue = false) const;
+    int toInt(int defaultValue = 0) const;
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    double toDouble(double defaultValue = 0) const;
+    QString toString() const;
+    QString toString(const QString &defaultValue) const;
+    QJsonValue toJsonValue() const;
+
+    qsizetype size() const;
+    QStringList keys() const;
+    bool contains(const QString &key) const;
+    QJsonLazyValue value(const QString &key) const;
+    QJsonLazyValue at(qsizetype i) const;
+    QJsonLazyValue operator[](const QString &key) const { return value(key); }
+    QJsonLazyValue operator[](qsizetype i) const { return at(i); }
+
+private:
+    friend class QJsonLazyDocument;
+    QJsonLazyValue(QJsonLazyDocumentPrivate *d, qsizetype offset);
+
+    QExplicitlySharedDataPointer<QJsonLazyDocumentPrivate> d;
+    qsizetype offset = -1;
+};
+
+class Q_CORE_EXPORT QJsonLazyDocument
+{
+public:
+    QJsonLazyDocument();
+    QJsonLazyDocument(const QJsonLazyDocument &other);
+    QJsonLazyDocument &operator=(const QJsonLazyDocument &other);
+    ~QJsonLazyDocument();
+
+    QJsonLazyDocument(QJsonLazyDocument &&other) noexcept;
+    QJsonLazyDocument &operator=(QJsonLazyDocument &&other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(QJsonLazyDocument &other) noexcept { qSwap(d, other.d); }
+
+    static QJsonLazyDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+    static QJsonLazyDocument fromFile(const QString &fileName, QJsonParseError *error = nullptr);
+
+    bool isNull() const;
+    bool isArray() const;
+    bool isObject() const;
+
+    QJsonLazyValue root() const;
+    QJsonLazyValue operator[](const QString &key) const { return root().value(key); }
+    QJsonLazyValue operator[](qsizetype i) const { return root().at(i); }
+
+private:
+    static QJsonLazyDocument create(QJsonLazyDocumentPrivate *d, QJsonParseError *error);
+
+    QExplicitlySharedDataPointer<QJsonLazyDocumentPrivate> d;
+};
+
+Q_DECLARE_SHARED(QJsonLazyValue)
+Q_DECLARE_SHARED(QJsonLazyDocument)
+
+QT_END_NAMESPACE
+
+#endif // QJSONLAZYDOCUMENT_P_H
@@ -47,6 +47,8 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
+#include <qscopeguard.h>
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -223,13 +225,15 @@ private:
 };
 
 Parser::Parser(const char *json, int length)
-    : head(json), json(json)
+    : head(json), json(json), index(nullptr)
     , nestingLevel(0)
     , lastError(QJsonParseError::NoError)
 {
     end = json + length;
 }
 
+Parser::~Parser() = default;
+
 
 
 /*
@@ -272,6 +276,234 @@ enum {
     Quote = 0x22
 };
 
+/*
+    The indexed parser works in two stages. The first one classifies the
+    input 64 bytes at a time with SIMD instructions and produces the offsets
+    of all structural characters: the six JSON operators outside of strings,
+    both quotes of every string and the first character of every other
+    scalar (numbers and literals). It also validates the UTF-8 of every
+    block that contains non-ASCII bytes, so that the second stage can copy
+    strings without escape sequences without looking at their contents.
+
+    The second stage walks the offsets and builds the container tree the
+    same way the sequential parser does. The index is produced on demand, a
+    few kilobytes at a time, so its memory use does not depend on the size
+    of the document.
+
+    If the indexed parser finds any kind of error, the document is parsed
+    again by the sequential parser, which produces the error code and the
+    offset.
+*/
+namespace {
+struct BlockMasks
+{
+    quint64 quote = 0;
+    quint64 backslash = 0;
+    quint64 whitespace = 0;
+    quint64 op = 0;
+    quint64 nonAscii = 0;
+};
+}
+
+#if defined(__ARM_NEON__)
+static inline quint64 neonMovemask(uint8x16_t v)
+{
+    const uint8x16_t bits = { 1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7,
+                              1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7 };
+    const uint8x16_t masked = vandq_u8(v, bits);
+    uint8x8_t low = vget_low_u8(masked);
+    uint8x8_t high = vget_high_u8(masked);
+    low = vpadd_u8(low, low);
+    low = vpadd_u8(low, low);
+    low = vpadd_u8(low, low);
+    high = vpadd_u8(high, high);
+    high = vpadd_u8(high, high);
+    high = vpadd_u8(high, high);
+    return vget_lane_u8(low, 0) | (uint(vget_lane_u8(high, 0)) << 8);
+}
+#endif
+
+static inline void classifyBlock(const uchar *p, BlockMasks *m)
+{
+#if defined(__AVX2__)
+    for (int i = 0; i < 64; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        const auto match = [v](char c) {
+            return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+        };
+        const auto bits = [](__m256i r) { return quint64(uint(_mm256_movemask_epi8(r))); };
+        const __m256i ws = _mm256_or_si256(_mm256_or_si256(match(Space), match(Tab)),
+                                           _mm256_or_si256(match(LineFeed), match(Return)));
+        const __m256i op = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_or_si256(match(BeginArray), match(EndArray)),
+                                    _mm256_or_si256(match(BeginObject), match(EndObject))),
+                    _mm256_or_si256(match(NameSeparator), match(ValueSeparator)));
+        m->quote |= bits(match(Quote)) << i;
+        m->backslash |= bits(match('\\')) << i;
+        m->whitespace |= bits(ws) << i;
+        m->op |= bits(op) << i;
+        m->nonAscii |= bits(v) << i;
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < 64; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const auto match = [v](char c) {
+            return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+        };
+        const auto bits = [](__m128i r) { return quint64(uint(_mm_movemask_epi8(r))); };
+        const __m128i ws = _mm_or_si128(_mm_or_si128(match(Space), match(Tab)),
+                                        _mm_or_si128(match(LineFeed), match(Return)));
+        const __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_or_si128(match(BeginArray), match(EndArray)),
+                                 _mm_or_si128(match(BeginObject), match(EndObject))),
+                    _mm_or_si128(match(NameSeparator), match(ValueSeparator)));
+        m->quote |= bits(match(Quote)) << i;
+        m->backslash |= bits(match('\\')) << i;
+        m->whitespace |= bits(ws) << i;
+        m->op |= bits(op) << i;
+        m->nonAscii |= bits(v) << i;
+    }
+#elif defined(__ARM_NEON__)
+    for (int i = 0; i < 64; i += 16) {
+        const uint8x16_t v = vld1q_u8(p + i);
+        const auto match = [v](uchar c) { return vceqq_u8(v, vdupq_n_u8(c)); };
+        const uint8x16_t ws = vorrq_u8(vorrq_u8(match(Space), match(Tab)),
+                                       vorrq_u8(match(LineFeed), match(Return)));
+        const uint8x16_t op = vorrq_u8(
+                    vorrq_u8(vorrq_u8(match(BeginArray), match(EndArray)),
+                             vorrq_u8(match(BeginObject), match(EndObject))),
+                    vorrq_u8(match(NameSeparator), match(ValueSeparator)));
+        m->quote |= neonMovemask(match(Quote)) << i;
+        m->backslash |= neonMovemask(match('\\')) << i;
+        m->whitespace |= neonMovemask(ws) << i;
+        m->op |= neonMovemask(op) << i;
+        m->nonAscii |= neonMovemask(vcgeq_u8(v, vdupq_n_u8(0x80))) << i;
+    }
+#else
+    for (int i = 0; i < 64; ++i) {
+        const quint64 bit = Q_UINT64_C(1) << i;
+        switch (p[i]) {
+        case Quote:
+            m->quote |= bit;
+            break;
+        case '\\':
+            m->backslash |= bit;
+            break;
+        case Space:
+        case Tab:
+        case LineFeed:
+        case Return:
+            m->whitespace |= bit;
+            break;
+        case BeginArray:
+        case EndArray:
+        case BeginObject:
+        case EndObject:
+        case NameSeparator:
+        case ValueSeparator:
+            m->op |= bit;
+            break;
+        default:
+            if (p[i] >= 0x80)
+                m->nonAscii |= bit;
+            break;
+        }
+    }
+#endif
+}
+
+// Returns a mask with all bits set from each set bit of \a x (inclusive)
+// to the next one (exclusive).
+static inline quint64 prefixXor(quint64 x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+namespace QJsonPrivate {
+
+bool StructuralIndex::validateUtf8(const uchar *block, quint64 nonAscii)
+{
+    while (nonAscii) {
+        const uchar *src = block + qCountTrailingZeroBits(nonAscii);
+        nonAscii &= nonAscii - 1;
+        if (src < checked)
+            continue; // a continuation byte of a sequence decoded earlier
+        uint ch;
+        uint *dst = &ch;
+        const uchar b = *src++;
+        if (QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end) < 0)
+            return false;
+        checked = src;
+    }
+    return true;
+}
+
+bool StructuralIndex::fill()
+{
+    const qsizetype length = end - begin;
+    const quint64 EvenBits = Q_UINT64_C(0x5555555555555555);
+
+    position = count = 0;
+    while (count == 0) {
+        if (invalid || offset >= length)
+            return false;
+
+        for (int blocks = 0; blocks < BlocksPerFill && offset < length; ++blocks, offset += 64) {
+            const uchar *block = begin + offset;
+            BlockMasks m;
+            if (length - offset >= 64) {
+                classifyBlock(block, &m);
+            } else {
+                uchar padded[64];
+                memset(padded, Space, sizeof(padded));
+                memcpy(padded, block, length - offset);
+                classifyBlock(padded, &m);
+            }
+
+            if (m.nonAscii && !validateUtf8(block, m.nonAscii)) {
+                invalid = true;
+                return false;
+            }
+
+            // Find the characters escaped by an odd-length run of backslashes.
+            const quint64 backslash = m.backslash & ~prevEscaped;
+            const quint64 followsEscape = (backslash << 1) | prevEscaped;
+            const quint64 oddStarts = backslash & ~EvenBits & ~followsEscape;
+            quint64 evenSequences;
+            prevEscaped = add_overflow(oddStarts, backslash, &evenSequences);
+            const quint64 escaped = (EvenBits ^ (evenSequences << 1)) & followsEscape;
+
+            const quint64 quote = m.quote & ~escaped;
+            const quint64 inString = prefixXor(quote) ^ prevInString;
+            prevInString = quint64(qint64(inString) >> 63);
+
+            // Numbers and literals are indexed at their first character only.
+            const quint64 scalar = ~(m.op | m.whitespace | quote);
+            const quint64 followsScalar = (scalar << 1) | prevScalar;
+            prevScalar = scalar >> 63;
+            const quint64 scalarStart = scalar & ~followsScalar;
+
+            quint64 structurals = ((m.op | scalarStart) & ~inString) | quote;
+            const quint32 base = quint32(offset);
+            quint32 *out = indices.data() + count;
+            while (structurals) {
+                *out++ = base + qCountTrailingZeroBits(structurals);
+                structurals &= structurals - 1;
+            }
+            count = out - indices.data();
+        }
+    }
+    return true;
+}
+
+} // namespace QJsonPrivate
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -322,17 +554,34 @@ char Parser::nextToken()
 /*
     JSON-text = object / array
 */
-QCborValue Parser::parse(QJsonParseError *error)
+QCborValue Parser::parse(QJsonParseError *error, Strategy strategy)
 {
 #ifdef PARSER_DEBUG
     indent = 0;
     qDebug(">>>>> parser begin");
 #endif
     eatBOM();
-    char token = nextToken();
 
     QCborValue data;
 
+    if (strategy == Strategy::Indexed) {
+        const char *start = json;
+        if (parseIndexed(&data)) {
+            if (error) {
+                error->offset = 0;
+                error->error = QJsonParseError::NoError;
+            }
+            return data;
+        }
+
+        // start over to find out what and where the error is
+        json = start;
+        nestingLevel = 0;
+        container.reset();
+    }
+
+    char token = nextToken();
+
     DEBUG << Qt::hex << (uint)token;
     if (token == BeginArray) {
         container = new QCborContainerPrivate;
@@ -380,6 +629,44 @@ error:
 }
 
 
+/*
+    Parses the string, number or literal at the current position, without
+    requiring it to be inside an array or object. Returns an undefined value
+    on error. If \a error is not null, its offset is set to where parsing
+    stopped, on success too.
+*/
+QCborValue Parser::parseScalar(QJsonParseError *error)
+{
+    container = new QCborContainerPrivate;
+    bool ok = false;
+    if (eatSpace()) {
+        switch (*json) {
+        case BeginArray:
+        case BeginObject:
+            break;
+        case Quote:
+            ++json;
+            ok = parseString();
+            break;
+        default:
+            ok = parseValue();
+            break;
+        }
+    }
+
+    QCborValue result = ok ? container->valueAt(0) : QCborValue();
+    container.reset();
+    if (error) {
+        error->offset = json - head;
+        error->error = QJsonParseError::NoError;
+        if (!ok && lastError == QJsonParseError::NoError)
+            error->error = QJsonParseError::IllegalValue;
+        else if (!ok)
+            error->error = lastError;
+    }
+    return result;
+}
+
 
 static void sortContainer(QCborContainerPrivate *container)
 {
@@ -937,4 +1224,288 @@ bool Parser::parseString()
     return true;
 }
 
+/*
+    The indexed parser. It accepts exactly the documents the sequential
+    parser accepts and builds the same containers, but it takes the tokens
+    from the structural index instead of scanning for them. On error, it
+    simply returns false and the caller starts over with the sequential
+    parser to report the error.
+*/
+
+static inline bool isDelimiterAfterScalar(char c)
+{
+    switch (c) {
+    case Space:
+    case Tab:
+    case LineFeed:
+    case Return:
+    case ValueSeparator:
+    case EndArray:
+    case EndObject:
+        return true;
+    }
+    return false;
+}
+
+// Scans [begin, end) for backslashes and non-ASCII characters.
+static inline void scanStringContents(const char *begin, const char *end,
+                                      bool *hasEscapes, bool *isAscii)
+{
+    *hasEscapes = false;
+    *isAscii = true;
+    const char *p = begin;
+#ifdef __SSE2__
+    const __m128i backslash = _mm_set1_epi8('\\');
+    uint nonAscii = 0;
+    for ( ; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash))) {
+            *hasEscapes = true;
+            return;
+        }
+        nonAscii |= _mm_movemask_epi8(v);
+    }
+    *isAscii = !nonAscii;
+#endif
+    for ( ; p < end; ++p) {
+        if (*p == '\\') {
+            *hasEscapes = true;
+            return;
+        }
+        if (uchar(*p) >= 0x80)
+            *isAscii = false;
+    }
+}
+
+bool Parser::parseIndexed(QCborValue *data)
+{
+    StructuralIndex structuralIndex(json, end);
+    index = &structuralIndex;
+    const auto cleanup = qScopeGuard([this] { index = nullptr; });
+
+    const char token = nextIndexedToken();
+    if (token == BeginArray) {
+        container = new QCborContainerPrivate;
+        if (!parseIndexedArray())
+            return false;
+        *data = QCborContainerPrivate::makeValue(QCborValue::Array, -1, container.take(),
+                                                 QCborContainerPrivate::MoveContainer);
+    } else if (token == BeginObject) {
+        container = new QCborContainerPrivate;
+        if (!parseIndexedObject())
+            return false;
+        *data = QCborContainerPrivate::makeValue(QCborValue::Map, -1, container.take(),
+                                                 QCborContainerPrivate::MoveContainer);
+    } else {
+        return false;
+    }
+
+    // anything after the top-level value would have been indexed
+    return !index->next() && index->atEnd();
+}
+
+char Parser::nextIndexedToken()
+{
+    const char *token = index->next();
+    if (!token)
+        return 0;
+    json = token + 1;
+    return *token;
+}
+
+bool Parser::parseIndexedObject()
+{
+    if (++nestingLevel > nestingLimit)
+        return false;
+
+    char token = nextIndexedToken();
+    while (token == Quote) {
+        if (!container)
+            container = new QCborContainerPrivate;
+        if (!parseIndexedString())
+            return false;
+        if (nextIndexedToken() != NameSeparator)
+            return false;
+        if (!parseIndexedValue())
+            return false;
+        token = nextIndexedToken();
+        if (token != ValueSeparator)
+            break;
+        token = nextIndexedToken();
+        if (token != Quote)
+            return false;
+    }
+
+    if (token != EndObject)
+        return false;
+
+    --nestingLevel;
+
+    if (container)
+        sortContainer(container.data());
+    return true;
+}
+
+bool Parser::parseIndexedArray()
+{
+    if (++nestingLevel > nestingLimit)
+        return false;
+
+    const char *token = index->peek();
+    if (!token)
+        return false;
+    if (*token == EndArray) {
+        nextIndexedToken();
+    } else {
+        while (true) {
+            if (!container)
+                container = new QCborContainerPrivate;
+            if (!parseIndexedValue())
+                return false;
+            const char separator = nextIndexedToken();
+            if (separator == EndArray)
+                break;
+            if (separator != ValueSeparator)
+                return false;
+        }
+    }
+
+    --nestingLevel;
+
+    return true;
+}
+
+bool Parser::parseIndexedValue()
+{
+    switch (nextIndexedToken()) {
+    case Quote:
+        return parseIndexedString();
+    case BeginArray: {
+        StashedContainer stashedContainer(&container, QCborValue::Array);
+        return parseIndexedArray();
+    }
+    case BeginObject: {
+        StashedContainer stashedContainer(&container, QCborValue::Map);
+        return parseIndexedObject();
+    }
+    case 0:
+    case ValueSeparator:
+    case NameSeparator:
+    case EndObject:
+    case EndArray:
+        return false;
+    default:
+        --json;
+        return parseIndexedScalar();
+    }
+}
+
+bool Parser::parseIndexedScalar()
+{
+    const auto literal = [this](const char *text, qsizetype length) {
+        if (end - json <= length || memcmp(json, text, length) != 0)
+            return false;
+        json += length;
+        return true;
+    };
+
+    switch (*json) {
+    case 'n':
+        if (!literal("null", 4))
+            return false;
+        container->elements.append(QtCbor::Element(qint64(0), QCborValue::Null));
+        break;
+    case 't':
+        if (!literal("true", 4))
+            return false;
+        container->elements.append(QtCbor::Element(qint64(0), QCborValue::True));
+        break;
+    case 'f':
+        if (!literal("false", 5))
+            return false;
+        container->elements.append(QtCbor::Element(qint64(0), QCborValue::False));
+        break;
+    default: {
+        // Integers of up to 18 digits are the common case and cannot
+        // overflow, so convert them here instead of going through QByteArray.
+        const char *p = json;
+        const bool negative = *p == '-';
+        if (negative)
+            ++p;
+        const char *digits = p;
+        quint64 n = 0;
+        while (p < end && p - digits < 18 && uint(*p - '0') < 10)
+            n = n * 10 + uint(*p++ - '0');
+        if (p > digits && (*digits != '0' || p - digits == 1)
+                && p < end && isDelimiterAfterScalar(*p)) {
+            const qint64 value = negative ? -qint64(n) : qint64(n);
+            container->elements.append(QtCbor::Element(value, QCborValue::Integer));
+            json = p;
+            return true;
+        }
+        if (!parseNumber())
+            return false;
+        break;
+    }
+    }
+
+    // Characters following a scalar are not in the index, so make sure
+    // there are none.
+    return json < end && isDelimiterAfterScalar(*json);
+}
+
+bool Parser::parseIndexedString()
+{
+    // the opening quote has been consumed, the closing one is next
+    const char *start = json;
+    const char *close = index->next();
+    if (!close || *close != Quote || end - close < 2)
+        return false;
+
+    bool hasEscapes;
+    bool isAscii;
+    scanStringContents(start, close, &hasEscapes, &isAscii);
+    json = close + 1;
+
+    // the UTF-8 was validated while indexing
+    if (!hasEscapes) {
+        if (isAscii)
+            container->appendAsciiString(start, close - start);
+        else
+            container->appendUtf8String(start, close - start);
+        return true;
+    }
+
+    // Same as the second loop of parseString(), but copying runs of ASCII
+    // characters at once.
+    QString ucs4;
+    ucs4.reserve(close - start);
+    const char *p = start;
+    while (p < close) {
+        const char *run = p;
+        while (p < close && uchar(*p) < 0x80 && *p != '\\')
+            ++p;
+        if (p != run)
+            ucs4.append(QLatin1String(run, p - run));
+        if (p == close)
+            break;
+
+        uint ch = 0;
+        if (*p == '\\') {
+            if (!scanEscapeSequence(p, end, &ch))
+                return false;
+        } else {
+            if (!scanUtf8Char(p, end, &ch))
+                return false;
+        }
+        ucs4.append(QChar::fromUcs4(ch));
+    }
+    if (p != close)
+        return false;
+
+    container->appendByteData(reinterpret_cast<const char *>(ucs4.utf16()), ucs4.size() * 2,
+                              QCborValue::String, QtCbor::Element::StringIsUtf16);
+    return true;
+}
+
 QT_END_NAMESPACE
@@ -55,16 +55,77 @@
 #include <QtCore/private/qcborvalue_p.h>
 #include <QtCore/qjsondocument.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
-class Parser
+// Produces the offsets of the structural characters of a JSON document,
+// a few kilobytes at a time. See qjsonparser.cpp for the details.
+class StructuralIndex
 {
 public:
+    StructuralIndex(const char *json, const char *end)
+        : begin(reinterpret_cast<const uchar *>(json)),
+          end(reinterpret_cast<const uchar *>(end)),
+          checked(begin)
+    {
+        // every byte is at most one structural character
+        indices.resize(size_t(qMin<qsizetype>(BlocksPerFill * 64, end - json)));
+    }
+
+    // Returns the next structural character, or nullptr at the end of the
+    // document or after an encoding error.
+    const char *next()
+    {
+        if (position == count && !fill())
+            return nullptr;
+        return reinterpret_cast<const char *>(begin) + indices[position++];
+    }
+
+    const char *peek()
+    {
+        if (position == count && !fill())
+            return nullptr;
+        return reinterpret_cast<const char *>(begin) + indices[position];
+    }
+
+    // True if next() returned nullptr because the document was exhausted.
+    bool atEnd() const { return !invalid && position == count && offset >= end - begin; }
+
+private:
+    enum { BlocksPerFill = 64 };
+
+    bool fill();
+    bool validateUtf8(const uchar *block, quint64 nonAscii);
+
+    const uchar *begin;
+    const uchar *end;
+    const uchar *checked;
+    qsizetype offset = 0;
+    std::vector<quint32> indices;
+    size_t position = 0;
+    size_t count = 0;
+    quint64 prevEscaped = 0;
+    quint64 prevInString = 0;
+    quint64 prevScalar = 0;
+    bool invalid = false;
+};
+
+class Q_CORE_EXPORT Parser
+{
+public:
+    enum class Strategy {
+        Indexed,
+        Sequential
+    };
+
     Parser(const char *json, int length);
+    ~Parser();
 
-    QCborValue parse(QJsonParseError *error);
+    QCborValue parse(QJsonParseError *error, Strategy strategy = Strategy::Indexed);
+    QCborValue parseScalar(QJsonParseError *error = nullptr);
 
 private:
     inline void eatBOM();
@@ -77,9 +138,19 @@ private:
     bool parseString();
     bool parseValue();
     bool parseNumber();
+
+    bool parseIndexed(QCborValue *data);
+    inline char nextIndexedToken();
+    bool parseIndexedObject();
+    bool parseIndexedArray();
+    bool parseIndexedValue();
+    bool parseIndexedString();
+    bool parseIndexedScalar();
+
     const char *head;
     const char *json;
     const char *end;
+    StructuralIndex *index;
 
     int nestingLevel;
     QJsonParseError::ParseError lastError;
@@ -0,0 +1,640 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamreader.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include "qjson_p.h"
+#include "qjsonparser_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.1
+
+    \brief The QJsonStreamReader class is a simple JSON parser that reads one
+    token at a time.
+
+    QJsonStreamReader reads JSON incrementally from a QIODevice or from data
+    added with addData(), so that arbitrarily large streams can be parsed
+    with constant memory use. Each call to readNext() returns the next token:
+    the start or end of an array or object, the name of an object member, or
+    a string, number, bool or null value. Strings and numbers are decoded
+    exactly like QJsonDocument::fromJson() does.
+
+    The stream may contain any number of top-level values separated by
+    whitespace, as in newline-delimited JSON:
+
+    \snippet code/src_corelib_serialization_qjsonstreamreader.cpp 0
+
+    If the data available is not enough to read the next token, readNext()
+    returns \l Incomplete. Parsing continues from the same place on the next
+    call to readNext(), once more data has been added or can be read from the
+    device, for example after QIODevice::readyRead() was emitted.
+
+    A number or literal is only complete once the character following it has
+    been read. At the very end of the stream that is only known if the
+    device is closed or, for random-access devices, at its end. Data added
+    with addData() should therefore end in whitespace or a closing bracket.
+
+    When an error is found, readNext() returns \l Invalid and keeps doing so
+    until clear() is called. error() and errorString() describe the error
+    and currentOffset() tells where in the stream it happened.
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum describes the tokens returned by readNext().
+
+    \value NoToken      Nothing has been read yet, or the end of the data was
+                        reached between two top-level values.
+    \value Invalid      An error occurred, see error().
+    \value Incomplete   More data is needed to read the next token.
+    \value StartArray   The beginning of an array.
+    \value EndArray     The end of an array.
+    \value StartObject  The beginning of an object.
+    \value EndObject    The end of an object.
+    \value Name         The name of an object member, see text().
+    \value String       A string value, see text().
+    \value Number       A number, see toDouble() and toInteger().
+    \value Bool         \c true or \c false, see toBool().
+    \value Null         \c null.
+*/
+
+static const int nestingLimit = 1024;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum : qsizetype { ReadSize = 16 * 1024 };
+
+    enum Expect {
+        TopLevelValue,
+        Value,
+        ValueOrEnd,
+        Key,
+        KeyOrEnd,
+        NameSeparator,
+        SeparatorOrEnd
+    };
+
+    bool fill();
+    bool endOfData() const;
+    bool skipSpace();
+    QJsonStreamReader::TokenType readContainerToken(char c);
+    QJsonStreamReader::TokenType readScalar(QJsonStreamReader::TokenType type);
+    QJsonStreamReader::TokenType setError(QJsonParseError::ParseError error, qsizetype at);
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;
+    qint64 bufferOffset = 0;
+    // how far the search for the end of the current token got
+    qsizetype scanned = 0;
+    bool stringClosed = false;
+
+    QVarLengthArray<char, 32> containers;
+    Expect expect = TopLevelValue;
+
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    qint64 tokenOffset = 0;
+    QCborValue value;
+    QJsonParseError::ParseError error = QJsonParseError::NoError;
+};
+
+bool QJsonStreamReaderPrivate::fill()
+{
+    if (!device || !device->isReadable())
+        return false;
+
+    // drop what has been consumed, so that memory use only depends on the
+    // size of the current token
+    if (pos) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        scanned = qMax<qsizetype>(scanned - pos, 0);
+        pos = 0;
+    }
+
+    const qsizetype size = buffer.size();
+    buffer.resize(size + ReadSize);
+    const qint64 n = device->read(buffer.data() + size, ReadSize);
+    buffer.resize(size + qMax<qint64>(n, 0));
+    return n > 0;
+}
+
+// Returns true if the device will not provide more data, which ends a
+// number or literal at the end of the stream. Without a device, more data
+// may always be added.
+bool QJsonStreamReaderPrivate::endOfData() const
+{
+    if (!device)
+        return false;
+    return !device->isOpen() || (!device->isSequential() && device->atEnd());
+}
+
+bool QJsonStreamReaderPrivate::skipSpace()
+{
+    while (true) {
+        const char *p = buffer.constData() + pos;
+        const char *end = buffer.constData() + buffer.size();
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+            ++p;
+        pos = p - buffer.constData();
+        if (p < end)
+            return true;
+        if (!fill())
+            return false;
+    }
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::setError(QJsonParseError::ParseError e,
+                                                                qsizetype at)
+{
+    error = e;
+    tokenOffset = bufferOffset + at;
+    value = QCborValue();
+    return type = QJsonStreamReader::Invalid;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readContainerToken(char c)
+{
+    tokenOffset = bufferOffset + pos;
+    value = QCborValue();
+    ++pos;
+    switch (c) {
+    case '[':
+    case '{':
+        if (containers.size() >= nestingLimit)
+            return setError(QJsonParseError::DeepNesting, pos - 1);
+        containers.append(c);
+        expect = c == '[' ? ValueOrEnd : KeyOrEnd;
+        return type = c == '[' ? QJsonStreamReader::StartArray : QJsonStreamReader::StartObject;
+    default:
+        containers.removeLast();
+        expect = containers.isEmpty() ? TopLevelValue : SeparatorOrEnd;
+        return type = c == ']' ? QJsonStreamReader::EndArray : QJsonStreamReader::EndObject;
+    }
+}
+
+/*
+    Reads a string (also for names), number or literal. The token is first
+    located in the buffer, reading more data as needed, and then decoded by
+    the parser of QJsonDocument.
+*/
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readScalar(QJsonStreamReader::TokenType t)
+{
+    qsizetype tokenEnd;
+    bool atEndOfData = false;
+    if (buffer.at(pos) == '"') {
+        // find the closing quote; the parser also looks at the character
+        // after it, which is padded below if it is not there yet
+        scanned = qMax(scanned, pos + 1);
+        while (true) {
+            while (!stringClosed) {
+                const char *begin = buffer.constData();
+                const char *quote = static_cast<const char *>(
+                            memchr(begin + scanned, '"', buffer.size() - scanned));
+                if (!quote) {
+                    scanned = buffer.size();
+                    break;
+                }
+                qsizetype backslashes = 0;
+                while (quote[-1 - backslashes] == '\\')
+                    ++backslashes;
+                scanned = quote + 1 - begin;
+                stringClosed = backslashes % 2 == 0;
+            }
+            if (stringClosed && scanned < buffer.size())
+                break;
+            if (!fill()) {
+                if (!stringClosed)
+                    return QJsonStreamReader::Incomplete;
+                atEndOfData = true;
+                break;
+            }
+        }
+        tokenEnd = scanned;
+    } else {
+        scanned = qMax(scanned, pos);
+        while (true) {
+            const char *begin = buffer.constData();
+            const char *p = begin + scanned;
+            const char *end = begin + buffer.size();
+            while (p < end && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r'
+                   && *p != ',' && *p != ']' && *p != '}' && *p != ':'
+                   && *p != '[' && *p != '{' && *p != '"') {
+                ++p;
+            }
+            scanned = p - begin;
+            if (p < end)
+                break;
+            if (!fill()) {
+                if (!endOfData())
+                    return QJsonStreamReader::Incomplete;
+                atEndOfData = true;
+                break;
+            }
+        }
+        tokenEnd = scanned;
+    }
+    scanned = 0;
+    stringClosed = false;
+
+    // The parser needs one more character after the token; if there is none
+    // yet, supply it.
+    QByteArray padded;
+    const char *json = buffer.constData() + pos;
+    const qsizetype length = tokenEnd - pos;
+    if (atEndOfData) {
+        padded = QByteArray(json, length) + ' ';
+        json = padded.constData();
+    }
+
+    QJsonParseError parseError;
+    QJsonPrivate::Parser parser(json, int(length + 1));
+    QCborValue v = parser.parseScalar(&parseError);
+    if (parseError.error != QJsonParseError::NoError)
+        return setError(parseError.error, pos + parseError.offset);
+    if (parseError.offset != length) {
+        return setError(t == QJsonStreamReader::Number ? QJsonParseError::IllegalNumber
+                                                       : QJsonParseError::IllegalValue,
+                        pos + parseError.offset);
+    }
+
+    tokenOffset = bufferOffset + pos;
+    pos = tokenEnd;
+    value = std::move(v);
+    if (t == QJsonStreamReader::Number) {
+        if (value.isTrue() || value.isFalse())
+            t = QJsonStreamReader::Bool;
+        else if (value.isNull())
+            t = QJsonStreamReader::Null;
+    }
+    return type = t;
+}
+
+/*!
+    Constructs a QJsonStreamReader without data. Use addData() or
+    setDevice() to provide some.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a QJsonStreamReader that reads from \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    d->buffer = data;
+}
+
+/*!
+    Constructs a QJsonStreamReader that reads from \a device, which must be
+    open for reading.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    d->device = device;
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader() = default;
+
+/*!
+    Makes the reader read from \a device from now on. Data that was already
+    read from the previous device, or added with addData(), is parsed first.
+
+    \sa device()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->device = device;
+}
+
+/*!
+    Returns the device being read from, or \nullptr.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds \a data to the data to parse.
+
+    This can be used without a device to feed the reader with data as it
+    becomes available.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    if (d->pos) {
+        d->buffer.remove(0, d->pos);
+        d->bufferOffset += d->pos;
+        d->scanned = qMax<qsizetype>(d->scanned - d->pos, 0);
+        d->pos = 0;
+    }
+    d->buffer += data;
+}
+
+/*!
+    Discards all buffered data and the parsing state, including any error.
+    The device, if any, is kept.
+*/
+void QJsonStreamReader::clear()
+{
+    QIODevice *device = d->device;
+    d.reset(new QJsonStreamReaderPrivate);
+    d->device = device;
+}
+
+/*!
+    Returns \c true if the reader is between two top-level values, no more
+    data is buffered and none will come, or if an error occurred.
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    if (d->type == Invalid)
+        return true;
+    return d->expect == QJsonStreamReaderPrivate::TopLevelValue && d->type != Incomplete
+            && d->pos == d->buffer.size() && (!d->device || d->endOfData());
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    \sa tokenType()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    using P = QJsonStreamReaderPrivate;
+
+    if (d->type == Invalid)
+        return Invalid;
+
+    while (true) {
+        if (!d->skipSpace()) {
+            if (d->expect == P::TopLevelValue && (!d->device || d->endOfData()))
+                return d->type = NoToken;
+            return d->type = Incomplete;
+        }
+
+        const char c = d->buffer.at(d->pos);
+        switch (d->expect) {
+        case P::SeparatorOrEnd:
+            if (c == ',') {
+                ++d->pos;
+                d->expect = d->containers.last() == '[' ? P::Value : P::Key;
+                continue;
+            }
+            if (c == (d->containers.last() == '[' ? ']' : '}'))
+                return d->readContainerToken(c);
+            return d->setError(d->containers.last() == '['
+                               ? QJsonParseError::MissingValueSeparator
+                               : QJsonParseError::UnterminatedObject, d->pos);
+
+        case P::NameSeparator:
+            if (c != ':')
+                return d->setError(QJsonParseError::MissingNameSeparator, d->pos);
+            ++d->pos;
+            d->expect = P::Value;
+            continue;
+
+        case P::KeyOrEnd:
+            if (c == '}')
+                return d->readContainerToken(c);
+            Q_FALLTHROUGH();
+        case P::Key: {
+            if (c != '"') {
+                return d->setError(c == '}' ? QJsonParseError::MissingObject
+                                            : QJsonParseError::UnterminatedObject, d->pos);
+            }
+            const TokenType t = d->readScalar(Name);
+            if (t == Name)
+                d->expect = P::NameSeparator;
+            return t;
+        }
+
+        case P::ValueOrEnd:
+            if (c == ']')
+                return d->readContainerToken(c);
+            Q_FALLTHROUGH();
+        case P::Value:
+        case P::TopLevelValue: {
+            TokenType t;
+            switch (c) {
+            case '[':
+            case '{':
+                return d->readContainerToken(c);
+            case ']':
+            case '}':
+                return d->setError(QJsonParseError::MissingObject, d->pos);
+            case ',':
+            case ':':
+                return d->setError(QJsonParseError::IllegalValue, d->pos);
+            case '"':
+                t = d->readScalar(String);
+                break;
+            default:
+                t = d->readScalar(Number);
+                break;
+            }
+            if (t != Incomplete && t != Invalid)
+                d->expect = d->containers.isEmpty() ? P::TopLevelValue : P::SeparatorOrEnd;
+            return t;
+        }
+        }
+    }
+}
+
+/*!
+    Returns the type of the last token read.
+
+    \sa readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->type;
+}
+
+/*!
+    Returns the number of arrays and objects the current token is inside
+    of. A StartArray or StartObject token counts its own container, an
+    EndArray or EndObject token does not.
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return d->containers.size();
+}
+
+/*!
+    Returns the offset in the stream of the current token, or of the error
+    if one occurred.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->tokenOffset;
+}
+
+/*!
+    Returns the object member name for a \l Name token, or the string for a
+    \l String token. Returns a null string otherwise.
+*/
+QString QJsonStreamReader::text() const
+{
+    if (d->type != Name && d->type != String)
+        return QString();
+    return d->value.toString();
+}
+
+/*!
+    Returns \c true if the current token is a number that was read as an
+    integer, the same way QJsonValue stores integers.
+
+    \sa toInteger()
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return d->type == Number && d->value.isInteger();
+}
+
+/*!
+    Returns the current number as an integer, or 0 if the current token
+    is not a number.
+
+    \sa isInteger(), toDouble()
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    if (d->type != Number)
+        return 0;
+    return d->value.isInteger() ? d->value.toInteger() : qint64(d->value.toDouble());
+}
+
+/*!
+    Returns the current number as a double, or 0 if the current token is not
+    a number.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    if (d->type != Number)
+        return 0;
+    return d->value.toDouble();
+}
+
+/*!
+    Returns the value of a \l Bool token, or \c false for other tokens.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return d->type == Bool && d->value.isTrue();
+}
+
+/*!
+    Returns the current string, number, bool or null as a QJsonValue, or
+    QJsonValue::Undefined for other tokens, including names.
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    switch (d->type) {
+    case String:
+    case Number:
+    case Bool:
+    case Null:
+        return QJsonPrivate::Value::fromTrustedCbor(d->value);
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    Returns \c true if an error occurred.
+
+    \sa error(), errorString()
+*/
+bool QJsonStreamReader::hasError() const
+{
+    return d->error != QJsonParseError::NoError;
+}
+
+/*!
+    Returns the error that occurred, or QJsonParseError::NoError.
+
+    \sa errorString(), currentOffset()
+*/
+QJsonParseError::ParseError QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    Returns a human-readable description of the error that occurred.
+
+    \sa error()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    QJsonParseError parseError;
+    parseError.error = d->error;
+    return parseError.errorString();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,365 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamwriter.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include "qcborvalue_p.h"
+#include "qjsonwriter_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.1
+
+    \brief The QJsonStreamWriter class writes compact JSON one value at a
+    time.
+
+    QJsonStreamWriter is the counterpart of QJsonStreamReader. It writes
+    arrays, objects and values as they are produced, without building a
+    QJsonDocument first. The separators between values are written
+    automatically, and a newline follows each complete top-level value, so
+    that writing several of them produces newline-delimited JSON:
+
+    \snippet code/src_corelib_serialization_qjsonstreamreader.cpp 1
+
+    Strings and numbers are written exactly like QJsonDocument::toJson()
+    writes them in the QJsonDocument::Compact format.
+
+    The writer does not check that the calls form a valid document, beyond
+    what is needed to write the separators: an object member must be
+    written as a call to writeName() followed by a value.
+
+    Output to a device is buffered. It is written to the device at the end
+    of each top-level value, when the buffer grows large, and by flush().
+
+    \sa QJsonStreamReader, QCborStreamWriter
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    enum : qsizetype { BufferSize = 16 * 1024 };
+
+    struct Container
+    {
+        bool isObject;
+        bool isEmpty;
+    };
+
+    void beginValue();
+    void endValue();
+    bool flush();
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Container, 32> containers;
+    bool afterName = false;
+    bool error = false;
+};
+
+// Writes the separator needed before a value or a name.
+void QJsonStreamWriterPrivate::beginValue()
+{
+    if (afterName) {
+        afterName = false;
+        return;
+    }
+    if (containers.isEmpty())
+        return;
+    if (!containers.last().isEmpty)
+        buffer += ',';
+    containers.last().isEmpty = false;
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (containers.isEmpty())
+        buffer += '\n';
+    if (containers.isEmpty() || buffer.size() >= BufferSize)
+        flush();
+}
+
+bool QJsonStreamWriterPrivate::flush()
+{
+    if (buffer.isEmpty())
+        return !error;
+    if (data) {
+        *data += buffer;
+    } else if (device) {
+        if (device->write(buffer) != buffer.size())
+            error = true;
+    }
+    buffer.clear();
+    return !error;
+}
+
+/*!
+    Constructs a writer that writes to \a device, which must be open for
+    writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a writer that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->data = data;
+}
+
+/*!
+    Flushes the buffered output and destroys the writer.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Flushes the buffered output and makes the writer write to \a device
+    from now on.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->data = nullptr;
+    d->device = device;
+}
+
+/*!
+    Returns the device being written to, or \nullptr if the writer appends
+    to a QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Starts an array. The values written until the matching writeEndArray()
+    are its elements.
+*/
+void QJsonStreamWriter::writeStartArray()
+{
+    d->beginValue();
+    d->buffer += '[';
+    d->containers.append({ false, true });
+}
+
+/*!
+    Ends the array started by the matching writeStartArray().
+*/
+void QJsonStreamWriter::writeEndArray()
+{
+    Q_ASSERT(!d->containers.isEmpty() && !d->containers.last().isObject);
+    d->containers.removeLast();
+    d->buffer += ']';
+    d->endValue();
+}
+
+/*!
+    Starts an object. Its members are written as a writeName() call followed
+    by the value, until the matching writeEndObject().
+*/
+void QJsonStreamWriter::writeStartObject()
+{
+    d->beginValue();
+    d->buffer += '{';
+    d->containers.append({ true, true });
+}
+
+/*!
+    Ends the object started by the matching writeStartObject().
+*/
+void QJsonStreamWriter::writeEndObject()
+{
+    Q_ASSERT(!d->containers.isEmpty() && d->containers.last().isObject);
+    d->containers.removeLast();
+    d->buffer += '}';
+    d->endValue();
+}
+
+/*!
+    Writes \a name as the name of the next object member. The next call must
+    write its value.
+*/
+void QJsonStreamWriter::writeName(const QString &name)
+{
+    Q_ASSERT(!d->containers.isEmpty() && d->containers.last().isObject && !d->afterName);
+    d->beginValue();
+    d->buffer += '"';
+    d->buffer += QJsonPrivate::Writer::escapedString(name);
+    d->buffer += "\":";
+    d->afterName = true;
+}
+
+/*!
+    Writes the string \a value.
+*/
+void QJsonStreamWriter::writeValue(const QString &value)
+{
+    d->beginValue();
+    d->buffer += '"';
+    d->buffer += QJsonPrivate::Writer::escapedString(value);
+    d->buffer += '"';
+    d->endValue();
+}
+
+/*!
+    \overload
+*/
+void QJsonStreamWriter::writeValue(QLatin1String value)
+{
+    writeValue(QString(value));
+}
+
+/*!
+    \overload
+
+    Writes the integer \a value.
+*/
+void QJsonStreamWriter::writeValue(qint64 value)
+{
+    d->beginValue();
+    d->buffer += QByteArray::number(value);
+    d->endValue();
+}
+
+/*!
+    \fn void QJsonStreamWriter::writeValue(int value)
+    \overload
+*/
+
+/*!
+    \overload
+
+    Writes the number \a value. Infinities and NaN are written as \c null,
+    like QJsonDocument does.
+*/
+void QJsonStreamWriter::writeValue(double value)
+{
+    d->beginValue();
+    QJsonPrivate::Writer::valueToJson(QCborValue(value), d->buffer, 0, true);
+    d->endValue();
+}
+
+/*!
+    \overload
+
+    Writes \c true or \c false.
+*/
+void QJsonStreamWriter::writeValue(bool value)
+{
+    d->beginValue();
+    d->buffer += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    \overload
+
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeValue(std::nullptr_t)
+{
+    d->beginValue();
+    d->buffer += "null";
+    d->endValue();
+}
+
+/*!
+    \overload
+
+    Writes \a value, including all the contents of an array or object.
+    Undefined values are written as \c null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    d->beginValue();
+    QJsonPrivate::Writer::valueToJson(QCborValue::fromJsonValue(value), d->buffer, 0, true);
+    d->endValue();
+}
+
+/*!
+    Returns the number of arrays and objects that have been started and not
+    ended yet.
+*/
+int QJsonStreamWriter::containerDepth() const
+{
+    return d->containers.size();
+}
+
+/*!
+    Writes the buffered output to the device. Returns \c false if the device
+    did not accept all of it.
+
+    \sa hasError()
+*/
+bool QJsonStreamWriter::flush()
+{
+    return d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->error;
+}
+
+QT_END_NAMESPACE
@@ -45,6 +45,7 @@
 #include "private/qstringconverter_p.h"
 #include <private/qnumeric_p.h>
 #include <private/qcborvalue_p.h>
+#include <private/qlocale_tools_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -143,9 +144,14 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
         break;
     case QCborValue::Double: {
         const double d = v.toDouble();
-        if (qIsFinite(d))
-            json += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
-        else
+        if (qIsFinite(d)) {
+            // formatted right into the output, without a temporary QByteArray
+            char buffer[32];
+            const qsizetype length = qt_doubleToChars(d, 'g', QLocale::FloatingPointShortest,
+                                                      buffer, sizeof(buffer));
+            Q_ASSERT(length <= qsizetype(sizeof(buffer)));
+            json.append(buffer, length);
+        } else
             json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
         break;
     }
@@ -241,4 +247,14 @@ void Writer::arrayToJson(const QCborContainerPrivate *a, QByteArray &json, int i
     json += compact ? "]" : "]\n";
 }
 
+void Writer::valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
+{
+    QT_PREPEND_NAMESPACE(valueToJson)(v, json, indent, compact);
+}
+
+QByteArray Writer::escapedString(const QString &s)
+{
+    return QT_PREPEND_NAMESPACE(escapedString)(s);
+}
+
 QT_END_NAMESPACE
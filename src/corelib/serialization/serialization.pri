@@ -12,11 +12,14 @@ HEADERS += \
     serialization/qdatastream_p.h \
     serialization/qjson_p.h \
     serialization/qjsondocument.h \
+    serialization/qjsonlazydocument_p.h \
     serialization/qjsonobject.h \
     serialization/qjsonvalue.h \
     serialization/qjsonarray.h \
     serialization/qjsonwriter_p.h \
     serialization/qjsonparser_p.h \
+    serialization/qjsonstreamreader.h \
+    serialization/qjsonstreamwriter.h \
     serialization/qtextstream.h \
     serialization/qtextstream_p.h \
     serialization/qxmlstream.h \
@@ -30,11 +33,14 @@ SOURCES += \
     serialization/qdatastream.cpp \
     serialization/qjsoncbor.cpp \
     serialization/qjsondocument.cpp \
+    serialization/qjsonlazydocument.cpp \
     serialization/qjsonobject.cpp \
     serialization/qjsonarray.cpp \
     serialization/qjsonvalue.cpp \
     serialization/qjsonwriter.cpp \
     serialization/qjsonparser.cpp \
+    serialization/qjsonstreamreader.cpp \
+    serialization/qjsonstreamwriter.cpp \
     serialization/qtextstream.cpp \
     serialization/qxmlstream.cpp \
     serialization/qxmlutils.cpp
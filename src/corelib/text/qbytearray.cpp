@@ -3907,32 +3907,22 @@ QByteArray &QByteArray::setNum(qulonglong n, int base)
 
 QByteArray &QByteArray::setNum(double n, char f, int prec)
 {
-    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
-    uint flags = QLocaleData::ZeroPadExponent;
-
-    char lower = asciiLower(uchar(f));
-    if (f != lower)
-        flags |= QLocaleData::CapitalEorX;
-    f = lower;
-
-    switch (f) {
-        case 'f':
-            form = QLocaleData::DFDecimal;
-            break;
-        case 'e':
-            form = QLocaleData::DFExponent;
-            break;
-        case 'g':
-            form = QLocaleData::DFSignificantDigits;
-            break;
-        default:
 #if defined(QT_CHECK_RANGE)
-            qWarning("QByteArray::setNum: Invalid format char '%c'", f);
+    if (!f || !strchr("eEfFgG", f))
+        qWarning("QByteArray::setNum: Invalid format char '%c'", f);
 #endif
-            break;
-    }
 
-    *this = QLocaleData::c()->doubleToString(n, prec, form, -1, flags).toUtf8();
+    char buffer[64];
+    const qsizetype length = qt_doubleToChars(n, f, prec, buffer, sizeof(buffer));
+    if (length <= qsizetype(sizeof(buffer))) {
+        clear();
+        append(buffer, length);
+    } else {
+        resize(length);
+        const qsizetype written = qt_doubleToChars(n, f, prec, data(), length);
+        Q_ASSERT(written == length);
+        Q_UNUSED(written);
+    }
     return *this;
 }
 
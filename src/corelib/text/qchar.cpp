@@ -1653,9 +1653,18 @@ char32_t QChar::toTitleCase(char32_t ucs4) noexcept
     return convertCase_helper(ucs4, QUnicodeTables::TitleCase);
 }
 
+// US-ASCII characters are common enough in case-insensitive string matching
+// to deserve a shortcut around the Unicode tables
+static inline char32_t foldCaseAscii(char32_t ch) noexcept
+{
+    return ch - U'A' < 26 ? ch | 0x20 : ch;
+}
+
 static inline char32_t foldCase(const char16_t *ch, const char16_t *start)
 {
     char32_t ucs4 = *ch;
+    if (ucs4 < 0x80)
+        return foldCaseAscii(ucs4);
     if (QChar::isLowSurrogate(ucs4) && ch > start && QChar::isHighSurrogate(*(ch - 1)))
         ucs4 = QChar::surrogateToUcs4(*(ch - 1), ucs4);
     return convertCase_helper(ucs4, QUnicodeTables::CaseFold);
@@ -1664,6 +1673,10 @@ static inline char32_t foldCase(const char16_t *ch, const char16_t *start)
 static inline char32_t foldCase(char32_t ch, char32_t &last) noexcept
 {
     char32_t ucs4 = ch;
+    if (ucs4 < 0x80) {
+        last = ch;
+        return foldCaseAscii(ucs4);
+    }
     if (QChar::isLowSurrogate(ucs4) && QChar::isHighSurrogate(last))
         ucs4 = QChar::surrogateToUcs4(last, ucs4);
     last = ch;
@@ -1672,6 +1685,8 @@ static inline char32_t foldCase(char32_t ch, char32_t &last) noexcept
 
 static inline char16_t foldCase(char16_t ch) noexcept
 {
+    if (ch < 0x80)
+        return char16_t(foldCaseAscii(ch));
     return convertCase_helper(ch, QUnicodeTables::CaseFold);
 }
 
@@ -44,6 +44,17 @@
 
 #include "qdebug.h"
 
+#if QT_CONFIG(thread)
+#include <QtCore/qatomic.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -354,6 +365,259 @@ int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) con
     \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
  */
 
+namespace {
+enum { SortKeysChunkSize = 1024, SortRunMinimumSize = 4096 };
+
+#if QT_CONFIG(thread)
+// A job split into count parts, run by whichever thread (including the
+// calling one) is free. A pool thread that starts once all the parts are
+// taken has nothing to do, and only touches this state, which stays alive
+// until every thread is done with it.
+struct QCollatorParallelJob
+{
+    QCollatorParallelJob(qsizetype count, std::function<void(qsizetype)> &&part)
+        : count(count), part(std::move(part))
+    {
+    }
+
+    void run()
+    {
+        for (qsizetype i = next.fetchAndAddRelaxed(1); i < count; i = next.fetchAndAddRelaxed(1)) {
+            part(i);
+            finishedParts.release();
+        }
+    }
+
+    const qsizetype count;
+    const std::function<void(qsizetype)> part;
+    QAtomicInteger<qsizetype> next = 0;
+    QSemaphore finishedParts;
+};
+#endif // QT_CONFIG(thread)
+
+// Calls part(i) for each i in [0, count), in parallel on the threads of
+// threadPool if it's not null, and returns once all the calls are done.
+void forEachPart(QThreadPool *threadPool, qsizetype count, std::function<void(qsizetype)> &&part)
+{
+#if QT_CONFIG(thread)
+    if (threadPool && count > 1) {
+        auto job = QSharedPointer<QCollatorParallelJob>::create(count, std::move(part));
+        const qsizetype helpers = qMin(count - 1, qsizetype(threadPool->maxThreadCount()));
+        for (qsizetype i = 0; i < helpers; ++i)
+            threadPool->start([job] { job->run(); });
+        job->run();
+        job->finishedParts.acquire(int(count));
+        return;
+    }
+#else
+    Q_UNUSED(threadPool);
+#endif
+    for (qsizetype i = 0; i < count; ++i)
+        part(i);
+}
+
+// A QCollator is reentrant, not thread-safe: each thread gets its own.
+QCollator cloneCollator(const QCollator &collator)
+{
+    QCollator clone(collator.locale());
+    clone.setCaseSensitivity(collator.caseSensitivity());
+    clone.setNumericMode(collator.numericMode());
+    clone.setIgnorePunctuation(collator.ignorePunctuation());
+    return clone;
+}
+} // unnamed namespace
+
+/*!
+    \since 6.1
+
+    Returns the sort keys for all the \a strings, in the same order; it is
+    equivalent to calling sortKey() on each of them.
+
+    If \a threadPool is not \nullptr, the strings are split into chunks whose
+    keys are computed in parallel by the threads of \a threadPool, with the
+    calling thread helping. The function returns once all the keys have been
+    computed. Otherwise, all the keys are computed by the calling thread.
+
+    \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
+
+    \sa sortKey(), sort()
+*/
+QList<QCollatorSortKey> QCollator::sortKeys(const QStringList &strings,
+                                            QThreadPool *threadPool) const
+{
+    const qsizetype count = strings.size();
+    const qsizetype chunkCount = (count + SortKeysChunkSize - 1) / SortKeysChunkSize;
+    if (!threadPool || chunkCount < 2) {
+        QList<QCollatorSortKey> keys;
+        keys.reserve(count);
+        for (const QString &string : strings)
+            keys.append(sortKey(string));
+        return keys;
+    }
+
+    // every chunk is computed into its own list, so that threads don't
+    // share anything but the (read-only) input
+    QList<QList<QCollatorSortKey>> chunks(chunkCount);
+    forEachPart(threadPool, chunkCount, [&](qsizetype chunk) {
+        const QCollator collator = cloneCollator(*this);
+        const qsizetype begin = chunk * SortKeysChunkSize;
+        const qsizetype end = qMin(begin + qsizetype(SortKeysChunkSize), count);
+        QList<QCollatorSortKey> &keys = chunks[chunk];
+        keys.reserve(end - begin);
+        for (qsizetype i = begin; i < end; ++i)
+            keys.append(collator.sortKey(strings.at(i)));
+    });
+
+    QList<QCollatorSortKey> keys;
+    keys.reserve(count);
+    for (QList<QCollatorSortKey> &chunk : chunks)
+        keys.append(std::move(chunk));
+    return keys;
+}
+
+/*!
+    \since 6.1
+
+    Sorts \a strings in ascending order, according to this collator. Strings
+    that compare equal keep their relative order.
+
+    This is faster than calling \c{std::sort(strings.begin(), strings.end(), collator)},
+    which collates each string many times over: the strings are collated only
+    once each, into sort keys (see sortKeys()), which are then sorted.
+
+    If \a threadPool is not \nullptr, both computing and sorting the keys are
+    done in parallel by the threads of \a threadPool, with the calling thread
+    helping. The function returns once \a strings is sorted. Otherwise, all
+    the work is done by the calling thread.
+
+    \sa sortKeys(), compare()
+*/
+void QCollator::sort(QStringList &strings, QThreadPool *threadPool) const
+{
+    const QList<qsizetype> order = qt_collatorSortOrder(*this, strings, Qt::AscendingOrder,
+                                                        threadPool);
+    QStringList sorted;
+    sorted.reserve(strings.size());
+    for (qsizetype index : order)
+        sorted.append(std::move(strings[index]));
+    strings = std::move(sorted);
+}
+
+namespace {
+// What gets sorted: the first bytes of the sort key of a string, which are
+// enough to tell most keys apart without following pointers to them, and the
+// string's index.
+struct SortEntry
+{
+    quint64 prefix;
+    qsizetype index;
+};
+
+// The prefix must order like the whole keys do, whenever prefixes differ; a
+// key type for which that's not implemented gets an uninformative 0.
+template <typename Key>
+quint64 sortKeyPrefix(const Key &)
+{
+    return 0;
+}
+
+quint64 sortKeyPrefix(const QByteArray &key)
+{
+    quint64 prefix = 0;
+    const qsizetype size = qMin(key.size(), qsizetype(sizeof(prefix)));
+    for (qsizetype i = 0; i < qsizetype(sizeof(prefix)); ++i)
+        prefix = (prefix << 8) | (i < size ? uchar(key.at(i)) : 0);
+    return prefix;
+}
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Returns the indexes of \a strings, in the order that sorting them with
+    \a collator in the given \a order puts them. Strings that compare equal
+    keep their relative order. This is what QCollator::sort() does, using
+    \a threadPool the same way.
+*/
+QList<qsizetype> qt_collatorSortOrder(const QCollator &collator, const QStringList &strings,
+                                      Qt::SortOrder order, QThreadPool *threadPool)
+{
+    const qsizetype count = strings.size();
+    QList<qsizetype> result(count);
+    std::iota(result.begin(), result.end(), qsizetype(0));
+    if (count < 2)
+        return result;
+
+    if (collator.locale().language() == QLocale::C) {
+        // Sort keys aren't supported everywhere in the C locale, and
+        // comparisons are cheap there anyway.
+        const auto lessThan = [&](qsizetype lhs, qsizetype rhs) {
+            return collator.compare(strings.at(lhs), strings.at(rhs)) < 0;
+        };
+        if (order == Qt::AscendingOrder)
+            std::stable_sort(result.begin(), result.end(), lessThan);
+        else
+            std::stable_sort(result.begin(), result.end(),
+                             [&](qsizetype lhs, qsizetype rhs) { return lessThan(rhs, lhs); });
+        return result;
+    }
+
+    const QList<QCollatorSortKey> keys = collator.sortKeys(strings, threadPool);
+    QList<SortEntry> entries(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        // compare() sorts empty strings first, whatever their keys; no
+        // other key has a zero prefix, as they don't start with a null.
+        entries[i] = { strings.at(i).isEmpty() ? 0 : sortKeyPrefix(keys.at(i).d->m_key), i };
+    }
+    const auto lessThan = [&](const SortEntry &lhs, const SortEntry &rhs) {
+        if (lhs.prefix != rhs.prefix)
+            return lhs.prefix < rhs.prefix;
+        const bool lhsEmpty = strings.at(lhs.index).isEmpty();
+        const bool rhsEmpty = strings.at(rhs.index).isEmpty();
+        if (lhsEmpty || rhsEmpty)
+            return lhsEmpty && !rhsEmpty;
+        return keys.at(lhs.index).compare(keys.at(rhs.index)) < 0;
+    };
+    const auto greaterThan = [&](const SortEntry &lhs, const SortEntry &rhs) {
+        return lessThan(rhs, lhs);
+    };
+
+    // Each thread sorts a run of the entries, and then the runs are merged in
+    // pairs, the merges of each round in parallel.
+    qsizetype runCount = 1;
+#if QT_CONFIG(thread)
+    if (threadPool)
+        runCount = qBound(qsizetype(1), count / SortRunMinimumSize,
+                          qsizetype(threadPool->maxThreadCount()) + 1);
+#endif
+    const auto runBoundary = [&](qsizetype run) {
+        return entries.begin() + qMin(count, count * run / runCount);
+    };
+
+    forEachPart(threadPool, runCount, [&](qsizetype run) {
+        if (order == Qt::AscendingOrder)
+            std::stable_sort(runBoundary(run), runBoundary(run + 1), lessThan);
+        else
+            std::stable_sort(runBoundary(run), runBoundary(run + 1), greaterThan);
+    });
+    for (qsizetype width = 1; width < runCount; width *= 2) {
+        const qsizetype merges = (runCount - width + 2 * width - 1) / (2 * width);
+        forEachPart(threadPool, merges, [&](qsizetype merge) {
+            const qsizetype first = merge * 2 * width;
+            const auto middle = runBoundary(first + width);
+            const auto last = runBoundary(qMin(first + 2 * width, runCount));
+            if (order == Qt::AscendingOrder)
+                std::inplace_merge(runBoundary(first), middle, last, lessThan);
+            else
+                std::inplace_merge(runBoundary(first), middle, last, greaterThan);
+        });
+    }
+
+    for (qsizetype i = 0; i < count; ++i)
+        result[i] = entries.at(i).index;
+    return result;
+}
+
 /*!
     \class QCollatorSortKey
     \inmodule QtCore
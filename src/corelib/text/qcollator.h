@@ -47,12 +47,16 @@
 
 QT_BEGIN_NAMESPACE
 
+class QCollator;
 class QCollatorPrivate;
 class QCollatorSortKeyPrivate;
+class QThreadPool;
 
 class Q_CORE_EXPORT QCollatorSortKey
 {
     friend class QCollator;
+    friend QList<qsizetype> qt_collatorSortOrder(const QCollator &, const QStringList &,
+                                                 Qt::SortOrder, QThreadPool *);
 public:
     QCollatorSortKey(const QCollatorSortKey &other);
     ~QCollatorSortKey();
@@ -119,6 +123,9 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    QList<QCollatorSortKey> sortKeys(const QStringList &strings,
+                                     QThreadPool *threadPool = nullptr) const;
+    void sort(QStringList &strings, QThreadPool *threadPool = nullptr) const;
 
 private:
     QCollatorPrivate *d;
@@ -153,7 +153,10 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
 
 int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
 {
-    return qstrcmp(d->m_key, otherKey.d->m_key);
+    // Not qstrcmp(), which would stop at the terminating null that ICU
+    // includes in one of the keys but not in the other, so that no key
+    // would compare equal to another, or even to itself.
+    return d->m_key.compare(otherKey.d->m_key);
 }
 
 QT_END_NAMESPACE
@@ -139,6 +139,8 @@ private:
     Q_DISABLE_COPY_MOVE(QCollatorSortKeyPrivate)
 };
 
+QList<qsizetype> qt_collatorSortOrder(const QCollator &collator, const QStringList &strings,
+                                      Qt::SortOrder order, QThreadPool *threadPool);
 
 QT_END_NAMESPACE
 
@@ -44,6 +44,11 @@
 #include "qstring.h"
 
 #include <private/qnumeric_p.h>
+#include <QtCore/qvarlengtharray.h>
+
+#if __has_include(<charconv>)
+#  include <charconv>
+#endif
 
 #include <ctype.h>
 #include <errno.h>
@@ -116,6 +121,34 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    if (precision == QLocale::FloatingPointShortest) {
+        // std::to_chars also produces the shortest representation that
+        // round-trips, and is faster than libdouble-conversion at it
+        char scientific[32]; // "-d.dddddddddddddddde-ddd"
+        const auto result = std::to_chars(scientific, scientific + sizeof(scientific), d,
+                                          std::chars_format::scientific);
+        Q_ASSERT(result.ec == std::errc());
+        const char *p = scientific;
+        sign = (*p == '-');
+        if (sign)
+            ++p;
+        length = 0;
+        for (; *p != 'e'; ++p) {
+            if (*p != '.' && length < bufSize)
+                buf[length++] = *p;
+        }
+        ++p; // skip the 'e'; the exponent has a sign and at least two digits
+        const bool negativeExponent = (*p++ == '-');
+        int exponent = 0;
+        for (; p < result.ptr; ++p)
+            exponent = exponent * 10 + (*p - '0');
+        decpt = (negativeExponent ? -exponent : exponent) + 1;
+        // No trailing zeroes to drop, as the representation is the shortest
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -278,6 +311,145 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
         --length;
 }
 
+/*!
+    \internal
+
+    Formats \a d the same way as QString::number(\a d, \a format,
+    \a precision) does, i.e. in the C locale, writing the result into
+    \a buf. Returns the length of the result; if that's more than
+    \a bufSize, the contents of \a buf are unspecified and the caller has to
+    try again with a bigger buffer. 32 characters are enough for
+    QLocale::FloatingPointShortest precision, and for the 'e' and 'g'
+    formats with precisions up to 17.
+
+    Unlike QLocaleData::doubleToString(), this doesn't need to take care of
+    the digits, separators and signs of other locales, and doesn't need to
+    allocate any memory.
+*/
+qsizetype qt_doubleToChars(double d, char format, int precision, char *buf, qsizetype bufSize)
+{
+    const bool upperCase = format >= 'A' && format <= 'Z';
+    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
+    switch (upperCase ? format + ('a' - 'A') : format) {
+    case 'e':
+        form = QLocaleData::DFExponent;
+        break;
+    case 'g':
+        form = QLocaleData::DFSignificantDigits;
+        break;
+    default:
+        break;
+    }
+
+    QVarLengthArray<char, 64> result;
+    if (qt_is_inf(d)) {
+        if (d < 0)
+            result.append('-');
+        result.append("inf", 3);
+    } else if (qt_is_nan(d)) {
+        result.append("nan", 3);
+    } else {
+        // Aside from F.P.Shortest, precision < 0 is treated as default, 6 -
+        // same as printf() and QLocaleData::doubleToString().
+        if (precision != QLocale::FloatingPointShortest && precision < 0)
+            precision = 6;
+
+        // Same buffer size for the digits as in QLocaleData::doubleToString()
+        int digitsSize = 1;
+        if (precision == QLocale::FloatingPointShortest)
+            digitsSize += std::numeric_limits<double>::max_digits10;
+        else if (form == QLocaleData::DFDecimal)
+            digitsSize += wholePartSpace(qAbs(d)) + precision;
+        else
+            digitsSize += qMax(2, precision) + 1;
+
+        QVarLengthArray<char, 32> digits(digitsSize);
+        bool negative = false;
+        int length;
+        int decpt;
+        qt_doubleToAscii(d, form, precision, digits.data(), digitsSize, negative, length, decpt);
+
+        if (negative && !isZero(d))
+            result.append('-');
+        const qsizetype start = result.size();
+        result.append(digits.constData(), length);
+
+        // QString::number() and QByteArray::number() pad with zeroes up to the
+        // precision in the 'e' and 'f' formats, but chop trailing zeroes in
+        // the 'g' one
+        bool useDecimal = form == QLocaleData::DFDecimal;
+        if (form == QLocaleData::DFSignificantDigits) {
+            // Same choice as QLocaleData::doubleToString(), for a two-digit
+            // minimum exponent and no digit grouping
+            if (precision == QLocale::FloatingPointShortest) {
+                // Exponent adds separator, sign and digits:
+                int bias = 2 + 2;
+                if (length <= decpt && length > 1)
+                    ++bias; // decimal but not exponent
+                else if (length == 1 && decpt <= 0)
+                    --bias; // exponent but not decimal
+                useDecimal = (decpt <= 0 ? 1 - decpt <= bias
+                              : decpt <= length ? 0 <= bias
+                              : decpt <= length + bias);
+            } else {
+                useDecimal = decpt > -4 && decpt <= (precision ? precision : 1);
+            }
+        }
+        const bool padToPrecision = form != QLocaleData::DFSignificantDigits;
+
+        if (useDecimal) {
+            if (decpt < 0) {
+                result.insert(result.begin() + start, -decpt, '0');
+                decpt = 0;
+            } else {
+                while (result.size() - start < decpt)
+                    result.append('0');
+            }
+            if (padToPrecision) {
+                for (qsizetype i = result.size() - start - decpt; i < precision; ++i)
+                    result.append('0');
+            }
+            if (decpt < result.size() - start)
+                result.insert(result.begin() + start + decpt, '.');
+            if (decpt == 0)
+                result.insert(result.begin() + start, '0');
+        } else {
+            if (padToPrecision) {
+                while (result.size() - start < precision + 1)
+                    result.append('0');
+            }
+            if (result.size() - start > 1)
+                result.insert(result.begin() + start + 1, '.');
+
+            int exponent = decpt - 1;
+            result.append('e');
+            result.append(exponent < 0 ? '-' : '+');
+            exponent = qAbs(exponent);
+            char exponentDigits[4];
+            char *end = exponentDigits + sizeof(exponentDigits);
+            char *p = end;
+            do {
+                *--p = char('0' + exponent % 10);
+                exponent /= 10;
+            } while (exponent);
+            if (end - p < 2)
+                *--p = '0';
+            result.append(p, end - p);
+        }
+    }
+
+    if (upperCase) {
+        for (char &c : result) {
+            if (c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+        }
+    }
+
+    if (result.size() <= bufSize)
+        memcpy(buf, result.constData(), result.size());
+    return result.size();
+}
+
 double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &processed,
                         StrayCharacterMode strayCharMode)
 {
@@ -320,6 +492,25 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
     }
 
     double d = 0.0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // std::from_chars is a lot faster than libdouble-conversion, but doesn't
+    // accept quite the same input: try it on the plain numbers that both
+    // accept in the same way, and let the slow path deal with anything else,
+    // including overflow and underflow.
+    const auto isPlainNumberCharacter = [](char c) {
+        return (c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+';
+    };
+    if (numLen < 64 && (num[0] == '-' || num[0] == '.' || (num[0] >= '0' && num[0] <= '9'))
+            && std::all_of(num, num + numLen, isPlainNumberCharacter)) {
+        const auto result = std::from_chars(num, num + numLen, d);
+        // zero results go the slow way, to tell zeroes from underflows
+        if (result.ec == std::errc() && result.ptr == num + numLen && !isZero(d)) {
+            processed = int(numLen);
+            return d;
+        }
+        d = 0.0;
+    }
+#endif
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
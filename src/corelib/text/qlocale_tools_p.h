@@ -67,6 +67,8 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
                         StrayCharacterMode strayCharMode = TrailingJunkProhibited);
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                       bool &sign, int &length, int &decpt);
+[[nodiscard]] qsizetype qt_doubleToChars(double d, char format, int precision,
+                                         char *buf, qsizetype bufSize);
 
 QString qulltoa(qulonglong l, int base, const QStringView zero);
 Q_CORE_EXPORT QString qdtoa(qreal d, int *decpt, int *sign);
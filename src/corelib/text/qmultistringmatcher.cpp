@@ -0,0 +1,750 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmultistringmatcher.h"
+
+#include <private/qsimd_p.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(SSSE3)
+#  define MULTISTRINGMATCHER_SSSE3
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+/*
+    The matcher is an Aho-Corasick automaton stored as a dense DFA: every
+    state has one transition per equivalence class of code units, where all
+    code units that do not occur in any pattern share class 0. Matching is
+    then one table lookup per code unit, regardless of the number of patterns.
+
+    States are numbered so that all states where at least one pattern ends
+    come last, which lets the scanning loop detect matches with a single
+    comparison. Transitions store the offset of the target state's row,
+    instead of its index.
+
+    While the automaton is in its initial state, a Teddy-style SIMD filter
+    skips over text where no pattern can start: the first (up to three)
+    code units of every pattern are hashed into eight buckets through
+    nibble lookup tables, and a position is a candidate only if the three
+    consecutive code units at that position agree on a bucket.
+*/
+
+constexpr int PrefilterLength = 3;
+constexpr int PrefilterBuckets = 8;
+
+struct Prefilter
+{
+    // bit b of masks[i][0][n] (low nibble n) and masks[i][1][n] (high nibble n)
+    // is set if a pattern of bucket b can have such a code unit at offset i
+    alignas(16) uchar masks[PrefilterLength][2][16] = {};
+    int length = 0;     // 0 if the filter is unused
+};
+
+inline uchar foldUnit(uchar c) noexcept
+{
+    return c >= 'A' && c <= 'Z' ? c | 0x20 : c;
+}
+
+inline char16_t foldUnit(char16_t c) noexcept
+{
+    return char16_t(QChar::toCaseFolded(char32_t(c)));
+}
+
+// Returns the code units whose case folding is a different code unit,
+// together with that folding.
+template <typename Unit>
+const std::vector<std::pair<Unit, Unit>> &foldedUnits()
+{
+    static const std::vector<std::pair<Unit, Unit>> pairs = [] {
+        std::vector<std::pair<Unit, Unit>> result;
+        for (int u = 0; u < (sizeof(Unit) == 1 ? 0x100 : 0x10000); ++u) {
+            if (foldUnit(Unit(u)) != Unit(u))
+                result.emplace_back(Unit(u), foldUnit(Unit(u)));
+        }
+        return result;
+    }();
+    return pairs;
+}
+
+inline const uchar *unitsOf(const QByteArray &ba) noexcept
+{
+    return reinterpret_cast<const uchar *>(ba.constData());
+}
+
+inline const char16_t *unitsOf(const QString &s) noexcept
+{
+    return reinterpret_cast<const char16_t *>(s.utf16());
+}
+
+template <typename Unit>
+class Automaton
+{
+public:
+    static constexpr bool IsWide = sizeof(Unit) == 2;
+    static constexpr int UnitCount = IsWide ? 0x10000 : 0x100;
+
+    template <typename Container>
+    void build(const QList<Container> &patterns, Qt::CaseSensitivity cs);
+
+    template <typename Report>
+    void scan(const Unit *begin, const Unit *from, const Unit *&end, Report report) const;
+
+    quint32 classOf(Unit u) const noexcept
+    {
+        if constexpr (IsWide)
+            return classes[pageOffsets[u >> 8] + (u & 0xff)];
+        else
+            return classes[u];
+    }
+
+    bool isEmpty() const noexcept { return firstOutputOffset == 0; }
+
+private:
+    const Unit *prefilter(const Unit *p, const Unit *end) const;
+
+    std::vector<quint32> classes;           // code unit -> class
+    std::array<quint32, 256> pageOffsets = {};   // wide only: high byte -> offset in classes
+    quint32 classCount = 1;
+    quint32 firstOutputOffset = 0;
+    std::vector<quint32> transitions;       // row offset of the target, per state and class
+    std::vector<qint32> terminals;          // per state: first pattern ending there, or -1
+    std::vector<qint32> outputLinks;        // per state: longest proper suffix with a match, or -1
+    std::vector<qint32> duplicates;         // per pattern: next identical pattern, or -1
+    Prefilter filter;
+};
+
+template <typename Unit>
+template <typename Container>
+void Automaton<Unit>::build(const QList<Container> &patterns, Qt::CaseSensitivity cs)
+{
+    if (std::all_of(patterns.cbegin(), patterns.cend(), [](const Container &p) { return p.isEmpty(); }))
+        return;
+    const auto fold = [cs](Unit u) { return cs == Qt::CaseSensitive ? u : foldUnit(u); };
+
+    // assign classes to the (folded) code units used by the patterns
+    std::vector<quint32> unitClasses(UnitCount, 0);
+    qsizetype minLength = std::numeric_limits<qsizetype>::max();
+    for (const Container &pattern : patterns) {
+        const Unit *units = unitsOf(pattern);
+        for (qsizetype i = 0; i < pattern.size(); ++i) {
+            quint32 &c = unitClasses[fold(units[i])];
+            if (!c)
+                c = classCount++;
+        }
+        if (!pattern.isEmpty())
+            minLength = qMin(minLength, pattern.size());
+    }
+    if (cs == Qt::CaseInsensitive) {
+        // make every code unit share the class of its case folding
+        for (const auto &[unit, folded] : foldedUnits<Unit>())
+            unitClasses[unit] = unitClasses[folded];
+    }
+    if constexpr (IsWide) {
+        // share one page of zeroes for all pages of code units unused by the patterns
+        classes.assign(256, 0);
+        for (int page = 0; page < 256; ++page) {
+            const auto first = unitClasses.cbegin() + page * 256;
+            if (std::all_of(first, first + 256, [](quint32 c) { return c == 0; })) {
+                pageOffsets[page] = 0;
+            } else {
+                pageOffsets[page] = quint32(classes.size());
+                classes.insert(classes.end(), first, first + 256);
+            }
+        }
+    } else {
+        classes = std::move(unitClasses);
+    }
+
+    // build the trie
+    std::vector<qint32> trie(classCount, -1);
+    std::vector<qint32> terminal(1, -1);
+    duplicates.assign(patterns.size(), -1);
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const Container &pattern = patterns.at(i);
+        if (pattern.isEmpty())
+            continue;
+        const Unit *units = unitsOf(pattern);
+        qint32 state = 0;
+        for (qsizetype j = 0; j < pattern.size(); ++j) {
+            const qsizetype slot = qsizetype(state) * classCount + classOf(units[j]);
+            if (trie[slot] < 0) {
+                trie[slot] = qint32(terminal.size());
+                terminal.push_back(-1);
+                trie.resize(trie.size() + classCount, -1);
+            }
+            state = trie[slot];
+        }
+        if (terminal[state] < 0) {
+            terminal[state] = qint32(i);
+        } else {
+            qint32 last = terminal[state];
+            while (duplicates[last] >= 0)
+                last = duplicates[last];
+            duplicates[last] = qint32(i);
+        }
+    }
+
+    // compute the failure transitions in breadth-first order, completing the DFA
+    const qsizetype stateCount = qsizetype(terminal.size());
+    std::vector<qint32> failure(stateCount, 0);
+    std::vector<qint32> outputLink(stateCount, -1);
+    std::vector<qint32> order;
+    order.reserve(stateCount);
+    order.push_back(0);
+    for (qsizetype i = 0; i < qsizetype(order.size()); ++i) {
+        const qint32 state = order[i];
+        qint32 *row = trie.data() + qsizetype(state) * classCount;
+        const qint32 *failureRow = trie.data() + qsizetype(failure[state]) * classCount;
+        for (quint32 c = 0; c < classCount; ++c) {
+            if (row[c] < 0) {
+                row[c] = state ? failureRow[c] : 0;
+            } else {
+                const qint32 child = row[c];
+                const qint32 f = state ? failureRow[c] : 0;
+                failure[child] = f;
+                outputLink[child] = terminal[f] >= 0 ? f : outputLink[f];
+                order.push_back(child);
+            }
+        }
+    }
+
+    // renumber the states so that the ones reporting matches come last
+    std::vector<qint32> renumbered(stateCount);
+    qint32 next = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (qint32 state : order) {
+            const bool hasOutput = terminal[state] >= 0 || outputLink[state] >= 0;
+            if (hasOutput == bool(pass))
+                renumbered[state] = next++;
+        }
+        if (pass == 0)
+            firstOutputOffset = quint32(next) * classCount;
+    }
+    transitions.resize(trie.size());
+    terminals.resize(stateCount);
+    outputLinks.resize(stateCount);
+    for (qsizetype state = 0; state < stateCount; ++state) {
+        const qsizetype n = renumbered[state];
+        for (quint32 c = 0; c < classCount; ++c)
+            transitions[n * classCount + c] = quint32(renumbered[trie[state * classCount + c]]) * classCount;
+        terminals[n] = terminal[state];
+        outputLinks[n] = outputLink[state] < 0 ? -1 : renumbered[outputLink[state]];
+    }
+
+#ifdef MULTISTRINGMATCHER_SSSE3
+    // distribute the distinct prefixes over the buckets, keeping similar ones together
+    const int length = int(qMin(minLength, qsizetype(PrefilterLength)));
+    std::vector<std::array<Unit, PrefilterLength>> prefixes;
+    for (const Container &pattern : patterns) {
+        if (pattern.isEmpty())
+            continue;
+        std::array<Unit, PrefilterLength> prefix = {};
+        for (int i = 0; i < length; ++i)
+            prefix[i] = fold(unitsOf(pattern)[i]);
+        prefixes.push_back(prefix);
+    }
+    std::sort(prefixes.begin(), prefixes.end());
+    prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+
+    // the filter sees code units above 0xff as 0xff
+    const auto addUnit = [this, length](uint u, const std::array<uchar, PrefilterLength> &bits) {
+        const uchar byte = uchar(qMin(u, 0xffU));
+        for (int j = 0; j < length; ++j) {
+            filter.masks[j][0][byte & 0xf] |= bits[j];
+            filter.masks[j][1][byte >> 4] |= bits[j];
+        }
+    };
+    std::vector<std::array<uchar, PrefilterLength>> buckets(cs == Qt::CaseSensitive ? 0 : UnitCount);
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+        const uchar bit = uchar(1U << (i * PrefilterBuckets / prefixes.size()));
+        for (int j = 0; j < length; ++j) {
+            std::array<uchar, PrefilterLength> bits = {};
+            bits[j] = bit;
+            if (cs == Qt::CaseSensitive)
+                addUnit(prefixes[i][j], bits);
+            else
+                buckets[prefixes[i][j]][j] |= bit;
+        }
+    }
+    if (cs == Qt::CaseInsensitive) {
+        // the prefix units themselves, and every code unit folding to one of them
+        for (const auto &prefix : prefixes) {
+            for (int j = 0; j < length; ++j)
+                addUnit(prefix[j], buckets[prefix[j]]);
+        }
+        for (const auto &[unit, folded] : foldedUnits<Unit>())
+            addUnit(unit, buckets[folded]);
+    }
+    filter.length = length;
+#else
+    Q_UNUSED(minLength);
+#endif
+}
+
+#ifdef MULTISTRINGMATCHER_SSSE3
+static inline __m128i loadAsBytes(const uchar *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+static inline __m128i loadAsBytes(const char16_t *p)
+{
+    // saturate the code units to 0xff: packus is signed, so move bit 15 down first
+    const auto saturate = [](__m128i v) {
+        const __m128i high = _mm_slli_epi16(_mm_srli_epi16(v, 15), 8);
+        return _mm_or_si128(_mm_and_si128(v, _mm_set1_epi16(0x7fff)), high);
+    };
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8));
+    return _mm_packus_epi16(saturate(lo), saturate(hi));
+}
+
+QT_FUNCTION_TARGET(SSSE3)
+static inline __m128i prefilterLookup(__m128i bytes, const uchar (&masks)[2][16])
+{
+    const __m128i nibble = _mm_set1_epi8(0xf);
+    const __m128i lo = _mm_and_si128(bytes, nibble);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+    const __m128i loMatches = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(masks[0])), lo);
+    const __m128i hiMatches = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(masks[1])), hi);
+    return _mm_and_si128(loMatches, hiMatches);
+}
+
+// Returns the first position in [p, end) where a pattern may start, or a
+// position near the end where there isn't enough data left to check.
+template <typename Unit>
+QT_FUNCTION_TARGET(SSSE3)
+static const Unit *prefilterSsse3(const Prefilter &filter, const Unit *p, const Unit *end)
+{
+    const int length = filter.length;
+    while (end - p >= 16 + length - 1) {
+        __m128i candidates = prefilterLookup(loadAsBytes(p), filter.masks[0]);
+        if (length > 1)
+            candidates = _mm_and_si128(candidates, prefilterLookup(loadAsBytes(p + 1), filter.masks[1]));
+        if (length > 2)
+            candidates = _mm_and_si128(candidates, prefilterLookup(loadAsBytes(p + 2), filter.masks[2]));
+        const uint mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(candidates, _mm_setzero_si128())) & 0xffff;
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+        p += 16;
+    }
+    return p;
+}
+#endif
+
+template <typename Unit>
+const Unit *Automaton<Unit>::prefilter(const Unit *p, const Unit *end) const
+{
+#ifdef MULTISTRINGMATCHER_SSSE3
+    return prefilterSsse3(filter, p, end);
+#else
+    Q_UNUSED(end);
+    return p;
+#endif
+}
+
+// Calls report(end, pattern) for every match, in order of their end
+// positions, longest first. report() may move \a end backwards to stop early.
+template <typename Unit>
+template <typename Report>
+void Automaton<Unit>::scan(const Unit *begin, const Unit *p, const Unit *&end, Report report) const
+{
+    if (isEmpty())
+        return;
+
+    bool useFilter = filter.length > 0;
+#ifdef MULTISTRINGMATCHER_SSSE3
+    useFilter = useFilter && qCpuHasFeature(SSSE3);
+#endif
+    const quint32 *next = transitions.data();
+    const Unit *filterResume = useFilter ? p : end;
+    quint32 state = 0;
+    while (p < end) {
+        if (state == 0 && p >= filterResume) {
+            const Unit *candidate = prefilter(p, end);
+            // if the filter doesn't skip much here, pause it for a while
+            if (candidate - p < 16)
+                filterResume = end - candidate > 64 ? candidate + 64 : end;
+            p = candidate;
+            if (p == end)
+                break;
+        }
+        state = next[state + classOf(*p)];
+        ++p;
+        if (Q_UNLIKELY(state >= firstOutputOffset)) {
+            const qsizetype position = p - begin;
+            for (qint32 s = qint32(state / classCount); s >= 0; s = outputLinks[s]) {
+                for (qint32 pattern = terminals[s]; pattern >= 0; pattern = duplicates[pattern])
+                    report(position, pattern);
+            }
+        }
+    }
+}
+
+} // unnamed namespace
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    template <typename Unit>
+    QMultiStringMatcher::Match indexIn(const Automaton<Unit> &automaton, const Unit *begin,
+                                       qsizetype size, qsizetype from) const;
+    template <typename Unit>
+    QList<QMultiStringMatcher::Match> allMatches(const Automaton<Unit> &automaton,
+                                                 const Unit *begin, qsizetype size,
+                                                 qsizetype from) const;
+
+    QStringList patterns;
+    QList<qsizetype> lengths[2];   // in UTF-16 code units and in bytes
+    qsizetype maxLength[2] = {};
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    Automaton<char16_t> utf16;
+    Automaton<uchar> bytes;
+};
+
+template <typename Unit>
+QMultiStringMatcher::Match
+QMultiStringMatcherPrivate::indexIn(const Automaton<Unit> &automaton, const Unit *begin,
+                                    qsizetype size, qsizetype from) const
+{
+    if (from < 0)
+        from = qMax(from + size, qsizetype(0));
+    QMultiStringMatcher::Match best;
+    if (from >= size)
+        return best;
+
+    const QList<qsizetype> &patternLengths = lengths[sizeof(Unit) == 1];
+    const qsizetype longest = maxLength[sizeof(Unit) == 1];
+    const Unit *end = begin + size;
+    automaton.scan(begin, begin + from, end, [&](qsizetype position, qint32 pattern) {
+        const qsizetype length = patternLengths.at(pattern);
+        const qsizetype start = position - length;
+        if (best.isValid() && (start > best.position
+                               || (start == best.position && length <= best.length))) {
+            return;
+        }
+        best = { start, length, pattern };
+        // no match ending after this can start before it
+        if (size - start > longest)
+            end = begin + start + longest;
+    });
+    return best;
+}
+
+template <typename Unit>
+QList<QMultiStringMatcher::Match>
+QMultiStringMatcherPrivate::allMatches(const Automaton<Unit> &automaton, const Unit *begin,
+                                       qsizetype size, qsizetype from) const
+{
+    if (from < 0)
+        from = qMax(from + size, qsizetype(0));
+    QList<QMultiStringMatcher::Match> matches;
+    if (from >= size)
+        return matches;
+
+    const QList<qsizetype> &patternLengths = lengths[sizeof(Unit) == 1];
+    const Unit *end = begin + size;
+    automaton.scan(begin, begin + from, end, [&](qsizetype position, qint32 pattern) {
+        const qsizetype length = patternLengths.at(pattern);
+        matches.append({ position - length, length, pattern });
+    });
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const QMultiStringMatcher::Match &lhs, const QMultiStringMatcher::Match &rhs) {
+        if (lhs.position != rhs.position)
+            return lhs.position < rhs.position;
+        return lhs.length > rhs.length;
+    });
+    return matches;
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.1
+    \brief The QMultiStringMatcher class finds any of a set of strings in a
+    string or byte array, in a single pass.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    Searching a text for each of many patterns with QString::indexOf() or
+    QStringMatcher takes one pass over the text per pattern.
+    QMultiStringMatcher instead compiles all the patterns into one
+    automaton, so that the time it takes to search a text depends on the
+    length of the text and the number of matches, but not on the number of
+    patterns. This makes it the tool of choice for scanning text for a list
+    of keywords, such as log lines for a set of error messages.
+
+    Create the QMultiStringMatcher with the list of patterns, then call
+    indexIn() to find the leftmost match or allMatches() to find all of
+    them:
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 0
+
+    Matches are reported as QMultiStringMatcher::Match values, holding the
+    position and length of the match and the index of the pattern in the
+    list passed to the constructor.
+
+    Both QString and QByteArray data can be searched. Byte arrays are
+    matched against the UTF-8 encoding of the patterns; when matching case
+    insensitively, only US-ASCII letters are folded for them. Strings are
+    matched code unit by code unit, folding case with QChar::toCaseFolded().
+
+    Empty patterns never match. Memory use grows with the total length of
+    the patterns times the number of distinct characters in them, so the
+    class is meant for sets of up to a few thousand keywords.
+
+    \sa QStringMatcher, QByteArrayMatcher, QRegularExpression
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.1
+    \brief The Match struct describes one match found by QMultiStringMatcher.
+
+    \sa QMultiStringMatcher::indexIn(), QMultiStringMatcher::allMatches()
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::position
+
+    The position of the match, in code units for strings and in bytes for
+    byte arrays. It is -1 for an invalid match.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::length
+
+    The length of the match, in code units for strings and in bytes for
+    byte arrays.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::pattern
+
+    The index of the matching pattern in QMultiStringMatcher::patterns().
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::Match::isValid() const
+
+    Returns \c true if this is an actual match, and \c false if it is the
+    default-constructed value returned when nothing matched.
+*/
+
+/*!
+    Constructs an empty matcher that won't match anything.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : QMultiStringMatcher(QStringList())
+{
+}
+
+/*!
+    Constructs a matcher that will search for any of \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate)
+{
+    QByteArrayList utf8;
+    utf8.reserve(patterns.size());
+    for (const QString &pattern : patterns)
+        utf8.append(pattern.toUtf8());
+
+    d->patterns = patterns;
+    d->cs = cs;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        d->lengths[0].append(patterns.at(i).size());
+        d->lengths[1].append(utf8.at(i).size());
+        d->maxLength[0] = qMax(d->maxLength[0], patterns.at(i).size());
+        d->maxLength[1] = qMax(d->maxLength[1], utf8.at(i).size());
+    }
+    d->utf16.build(patterns, cs);
+    d->bytes.build(utf8, cs);
+}
+
+/*!
+    Constructs a matcher that will search for any of \a patterns, with case
+    sensitivity \a cs. The patterns are expected to be encoded in UTF-8.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QByteArrayList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate)
+{
+    QStringList strings;
+    strings.reserve(patterns.size());
+    for (const QByteArray &pattern : patterns)
+        strings.append(QString::fromUtf8(pattern));
+
+    d->patterns = strings;
+    d->cs = cs;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        d->lengths[0].append(strings.at(i).size());
+        d->lengths[1].append(patterns.at(i).size());
+        d->maxLength[0] = qMax(d->maxLength[0], strings.at(i).size());
+        d->maxLength[1] = qMax(d->maxLength[1], patterns.at(i).size());
+    }
+    d->utf16.build(strings, cs);
+    d->bytes.build(patterns, cs);
+}
+
+/*!
+    Constructs a copy of \a other. This operation takes constant time,
+    because the matchers are implicitly shared.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher, making it point at the same object that
+    \a other was pointing to.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher and returns a reference to it.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Returns the patterns this matcher searches for. Patterns passed as
+    byte arrays are returned decoded from UTF-8.
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Returns the number of patterns this matcher searches for.
+*/
+qsizetype QMultiStringMatcher::patternCount() const
+{
+    return d->patterns.size();
+}
+
+/*!
+    Returns the case sensitivity of this matcher.
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches the string \a str for any of the patterns, starting at position
+    \a from, and returns the leftmost match. If several patterns match at
+    that position, the longest one is returned, and among patterns of equal
+    length the first one in patterns(). If no pattern matches, an invalid
+    Match is returned.
+
+    A negative \a from counts from the end of \a str.
+
+    \sa allMatches()
+*/
+QMultiStringMatcher::Match QMultiStringMatcher::indexIn(QStringView str, qsizetype from) const
+{
+    return d->indexIn(d->utf16, str.utf16(), str.size(), from);
+}
+
+/*!
+    \overload
+
+    Searches the UTF-8 encoded \a data for any of the patterns, starting at
+    byte position \a from.
+*/
+QMultiStringMatcher::Match QMultiStringMatcher::indexIn(QByteArrayView data, qsizetype from) const
+{
+    return d->indexIn(d->bytes, reinterpret_cast<const uchar *>(data.data()), data.size(), from);
+}
+
+/*!
+    Returns all the occurrences of the patterns in the string \a str,
+    starting at position \a from, sorted by position. Overlapping matches,
+    and matches of different patterns at the same position, are all
+    reported; at the same position, longer matches come first.
+
+    A negative \a from counts from the end of \a str.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::allMatches(QStringView str, qsizetype from) const
+{
+    return d->allMatches(d->utf16, str.utf16(), str.size(), from);
+}
+
+/*!
+    \overload
+
+    Returns all the occurrences of the patterns in the UTF-8 encoded \a data,
+    starting at byte position \a from.
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::allMatches(QByteArrayView data, qsizetype from) const
+{
+    return d->allMatches(d->bytes, reinterpret_cast<const uchar *>(data.data()), data.size(), from);
+}
+
+QT_END_NAMESPACE
@@ -40,14 +40,22 @@
 ****************************************************************************/
 
 #include "qregularexpression.h"
+#include "qregularexpression_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qshareddata.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qthreadstorage.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthreadpool.h>
+#endif
 #include <QtCore/qglobal.h>
 #include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
@@ -721,6 +729,29 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    The outcome of compiling a pattern with some pattern options. It's never
+    modified after construction, so the same object (and the PCRE code it
+    owns) can be shared by any number of QRegularExpressionPrivate objects,
+    in any thread; the compiled pattern cache hands out such shared objects.
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    QRegularExpressionCompiledPattern(const QString &pattern,
+                                      QRegularExpression::PatternOptions patternOptions);
+    ~QRegularExpressionCompiledPattern();
+
+    void optimize();
+    void getPatternInfo();
+
+    pcre2_code_16 *code = nullptr;
+    int errorCode = 0;
+    int errorOffset = -1;
+    int capturingCount = 0;
+    bool usingCrLfNewlines = false;
+    bool hasJOptionChanged = false;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -730,7 +761,6 @@ struct QRegularExpressionPrivate : QSharedData
     void cleanCompiledPattern();
     void compilePattern();
     void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -741,6 +771,10 @@ struct QRegularExpressionPrivate : QSharedData
                  int offset,
                  CheckSubjectStringOption checkSubjectStringOption = CheckSubjectString,
                  const QRegularExpressionMatchPrivate *previous = nullptr) const;
+    qsizetype doBatchMatch(const QStringView *subjects, qsizetype count,
+                           qsizetype *capturedStarts, qsizetype *capturedLengths,
+                           int capturedGroupCount,
+                           QRegularExpression::MatchOptions matchOptions) const;
 
     int captureIndexForName(QStringView name) const;
 
@@ -753,9 +787,10 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code pointer is owned by compiledPatternData, which is
+    // reference-counted and shared with the compiled pattern cache; when the
+    // private is copied (i.e. a detach happened) both are reset
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> compiledPatternData;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     int errorOffset;
@@ -847,8 +882,8 @@ QRegularExpressionPrivate::~QRegularExpressionPrivate()
     \internal
 
     Copies the private, which means copying only the pattern and the pattern
-    options. The compiledPattern pointer is NOT copied (we
-    do not own it any more), and in general all the members set when
+    options. The compiled pattern is NOT shared with \a other (it will
+    most likely not match any more), and in general all the members set when
     compiling a pattern are set to default values. isDirty is set back to true
     so that the pattern has to be recompiled again.
 */
@@ -871,7 +906,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiledPatternData.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -881,29 +916,26 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
 
 /*!
     \internal
+
+    Compiles \a pattern with the given \a patternOptions. If compilation
+    fails, code is left to nullptr and errorCode and errorOffset describe
+    the problem.
 */
-void QRegularExpressionPrivate::compilePattern()
+QRegularExpressionCompiledPattern::QRegularExpressionCompiledPattern(const QString &pattern,
+                                                                     QRegularExpression::PatternOptions patternOptions)
 {
-    const QMutexLocker lock(&mutex);
-
-    if (!isDirty)
-        return;
-
-    isDirty = false;
-    cleanCompiledPattern();
-
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
     PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.utf16()),
-                                       pattern.length(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
-
-    if (!compiledPattern) {
+    code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.utf16()),
+                            pattern.length(),
+                            options,
+                            &errorCode,
+                            &patternErrorOffset,
+                            nullptr);
+
+    if (!code) {
         errorOffset = static_cast<int>(patternErrorOffset);
         return;
     } else {
@@ -911,22 +943,30 @@ void QRegularExpressionPrivate::compilePattern()
         errorCode = 0;
     }
 
-    optimizePattern();
+    optimize();
     getPatternInfo();
 }
 
 /*!
     \internal
 */
-void QRegularExpressionPrivate::getPatternInfo()
+QRegularExpressionCompiledPattern::~QRegularExpressionCompiledPattern()
 {
-    Q_ASSERT(compiledPattern);
+    pcre2_code_free_16(code);
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionCompiledPattern::getPatternInfo()
+{
+    Q_ASSERT(code);
 
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
 
     // detect the settings for the newline
     unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
         // no option was specified in the regexp, grab PCRE build defaults
         pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
     }
@@ -935,18 +975,254 @@ void QRegularExpressionPrivate::getPatternInfo()
             (patternNewlineSetting == PCRE2_NEWLINE_ANY) ||
             (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
 
-    unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
-    if (Q_UNLIKELY(hasJOptionChanged)) {
+    unsigned int jOptionChanged;
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &jOptionChanged);
+    hasJOptionChanged = jOptionChanged;
+}
+
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    friend bool operator==(const QRegularExpressionCacheKey &lhs,
+                           const QRegularExpressionCacheKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.pattern == rhs.pattern;
+    }
+};
+
+size_t qHash(const QRegularExpressionCacheKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.pattern, int(key.patternOptions));
+}
+
+using QRegularExpressionCompiledPatternPointer =
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern>;
+
+struct QRegularExpressionCacheData
+{
+    enum { DefaultCapacity = 128 };
+
+    QMutex mutex;
+    QCache<QRegularExpressionCacheKey, QRegularExpressionCompiledPatternPointer> cache { DefaultCapacity };
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionCacheData, regularExpressionCache)
+
+/*!
+    \internal
+
+    Returns the compiled form of \a pattern with \a patternOptions, taking
+    it from the compiled pattern cache if possible.
+*/
+static QRegularExpressionCompiledPatternPointer
+compiledPatternFor(const QString &pattern, QRegularExpression::PatternOptions patternOptions)
+{
+    QRegularExpressionCacheData *data = regularExpressionCache();
+    if (data) {
+        const QMutexLocker lock(&data->mutex);
+        if (const QRegularExpressionCompiledPatternPointer *cached =
+                data->cache.object({ pattern, patternOptions })) {
+            ++data->hits;
+            return *cached;
+        }
+        ++data->misses;
+    }
+
+    // Compiling can take a while, so don't hold the lock meanwhile. If
+    // another thread compiles the same pattern at the same time, the last
+    // one to finish replaces the other's entry in the cache.
+    QRegularExpressionCompiledPatternPointer compiled(
+                new QRegularExpressionCompiledPattern(pattern, patternOptions));
+    if (data) {
+        const QMutexLocker lock(&data->mutex);
+        data->cache.insert({ pattern, patternOptions },
+                           new QRegularExpressionCompiledPatternPointer(compiled));
+    }
+    return compiled;
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::compilePattern()
+{
+    const QMutexLocker lock(&mutex);
+
+    if (!isDirty)
+        return;
+
+    isDirty = false;
+    cleanCompiledPattern();
+
+    compiledPatternData = compiledPatternFor(pattern, patternOptions);
+    compiledPattern = compiledPatternData->code;
+    errorCode = compiledPatternData->errorCode;
+    errorOffset = compiledPatternData->errorOffset;
+
+    if (compiledPattern)
+        getPatternInfo();
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::getPatternInfo()
+{
+    Q_ASSERT(compiledPatternData);
+
+    capturingCount = compiledPatternData->capturingCount;
+    usingCrLfNewlines = compiledPatternData->usingCrLfNewlines;
+
+    if (Q_UNLIKELY(compiledPatternData->hasJOptionChanged)) {
         qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
                  qUtf16Printable(pattern));
     }
 }
 
+/*!
+    \internal
+    \class QRegularExpressionCache
+    \inmodule QtCore
+
+    \brief The QRegularExpressionCache class controls the process-wide cache
+    of compiled regular expressions.
+
+    Compiling a pattern (and JIT-compiling it) is much more expensive than
+    most matches done with it. QRegularExpression objects therefore share
+    the compiled form of their pattern with every other object that uses
+    the same pattern and pattern options, through a cache of the most
+    recently used compiled patterns.
+*/
+
+/*!
+    \internal
+
+    Returns the maximum number of compiled patterns kept in the cache.
+*/
+qsizetype QRegularExpressionCache::capacity()
+{
+    QRegularExpressionCacheData *data = regularExpressionCache();
+    if (!data)
+        return 0;
+    const QMutexLocker lock(&data->mutex);
+    return data->cache.maxCost();
+}
+
+/*!
+    \internal
+
+    Sets the maximum number of compiled patterns kept in the cache to
+    \a capacity, evicting the least recently used ones if needed. A
+    capacity of 0 disables the cache.
+
+    Evicted patterns stay alive for as long as a QRegularExpression object
+    uses them.
+*/
+void QRegularExpressionCache::setCapacity(qsizetype capacity)
+{
+    QRegularExpressionCacheData *data = regularExpressionCache();
+    if (!data)
+        return;
+    const QMutexLocker lock(&data->mutex);
+    data->cache.setMaxCost(int(qBound(qsizetype(0), capacity, qsizetype(INT_MAX))));
+}
+
+/*!
+    \internal
+
+    Removes all the compiled patterns from the cache.
+*/
+void QRegularExpressionCache::clear()
+{
+    QRegularExpressionCacheData *data = regularExpressionCache();
+    if (!data)
+        return;
+    const QMutexLocker lock(&data->mutex);
+    data->cache.clear();
+}
+
+/*!
+    \internal
+
+    Returns the number of cache hits and misses since the last call to
+    resetStatistics(), together with the current number of cached patterns
+    and the capacity of the cache.
+*/
+QRegularExpressionCache::Statistics QRegularExpressionCache::statistics()
+{
+    Statistics result;
+    QRegularExpressionCacheData *data = regularExpressionCache();
+    if (!data)
+        return result;
+    const QMutexLocker lock(&data->mutex);
+    result.hits = data->hits;
+    result.misses = data->misses;
+    result.count = data->cache.size();
+    result.capacity = data->cache.maxCost();
+    return result;
+}
+
+/*!
+    \internal
+
+    Resets the hit and miss counters to 0.
+*/
+void QRegularExpressionCache::resetStatistics()
+{
+    QRegularExpressionCacheData *data = regularExpressionCache();
+    if (!data)
+        return;
+    const QMutexLocker lock(&data->mutex);
+    data->hits = 0;
+    data->misses = 0;
+}
+
+namespace {
+struct QRegularExpressionJitStackPoolData
+{
+    // The default JIT stack size in PCRE is 32K,
+    // we allocate from 32K up to 512K.
+    enum {
+        DefaultStackStartSize = 32 * 1024,
+        DefaultStackMaximumSize = 512 * 1024,
+        DefaultCapacity = 8
+    };
+
+    ~QRegularExpressionJitStackPoolData()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (pcre2_jit_stack_16 *stack : qAsConst(stacks))
+            pcre2_jit_stack_free_16(stack);
+        stacks.clear();
+    }
+
+    QMutex mutex;
+    QList<pcre2_jit_stack_16 *> stacks;
+    qsizetype stackStartSize = DefaultStackStartSize;
+    qsizetype stackMaximumSize = DefaultStackMaximumSize;
+    qsizetype capacity = DefaultCapacity;
+    // bumped whenever the stack sizes change, so that stacks allocated
+    // with the old sizes don't get back into the pool
+    int generation = 0;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionJitStackPoolData, jitStackPool)
 
 /*
     Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
-    QThreadStorage.
+    QThreadStorage. The stack is taken from the JIT stack pool if there's one
+    available there, and given back to it when the thread exits.
 */
 class QPcreJitStackPointer
 {
@@ -958,20 +1234,54 @@ public:
     */
     QPcreJitStackPointer()
     {
-        // The default JIT stack size in PCRE is 32K,
-        // we allocate from 32K up to 512K.
-        stack = pcre2_jit_stack_create_16(32 * 1024, 512 * 1024, nullptr);
+        qsizetype startSize = QRegularExpressionJitStackPoolData::DefaultStackStartSize;
+        qsizetype maximumSize = QRegularExpressionJitStackPoolData::DefaultStackMaximumSize;
+        if (QRegularExpressionJitStackPoolData *pool = jitStackPool()) {
+            const QMutexLocker lock(&pool->mutex);
+            generation = pool->generation;
+            if (!pool->stacks.isEmpty()) {
+                stack = pool->stacks.takeLast();
+                return;
+            }
+            startSize = pool->stackStartSize;
+            maximumSize = pool->stackMaximumSize;
+        }
+        stack = pcre2_jit_stack_create_16(startSize, maximumSize, nullptr);
     }
     /*!
         \internal
     */
     ~QPcreJitStackPointer()
     {
-        if (stack)
-            pcre2_jit_stack_free_16(stack);
+        if (!stack)
+            return;
+        if (QRegularExpressionJitStackPoolData *pool = jitStackPool()) {
+            const QMutexLocker lock(&pool->mutex);
+            if (generation == pool->generation && pool->stacks.size() < pool->capacity) {
+                pool->stacks.append(stack);
+                return;
+            }
+        }
+        pcre2_jit_stack_free_16(stack);
+    }
+
+    /*!
+        \internal
+
+        Returns true if the stack sizes have changed since this stack was
+        allocated.
+    */
+    bool isStale() const
+    {
+        QRegularExpressionJitStackPoolData *pool = jitStackPool();
+        if (!pool)
+            return false;
+        const QMutexLocker lock(&pool->mutex);
+        return generation != pool->generation;
     }
 
-    pcre2_jit_stack_16 *stack;
+    pcre2_jit_stack_16 *stack = nullptr;
+    int generation = 0;
 };
 
 Q_GLOBAL_STATIC(QThreadStorage<QPcreJitStackPointer *>, jitStacks)
@@ -1012,19 +1322,151 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called right after a pattern is compiled, before the compiled
+    pattern can be shared with anybody else.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCompiledPattern::optimize()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+}
+
+/*!
+    \internal
+    \class QRegularExpressionJitStackPool
+    \inmodule QtCore
+
+    \brief The QRegularExpressionJitStackPool class controls the pool of
+    stacks used by JIT-compiled regular expressions.
+
+    A thread gets a JIT stack the first time one of its matches runs out of
+    the small stack PCRE2 provides by default. When the thread exits, its
+    JIT stack is returned to a pool, from which other threads take theirs
+    instead of allocating a new one.
+*/
+
+/*!
+    \internal
+
+    Returns the initial size of the JIT stacks, in bytes.
+*/
+qsizetype QRegularExpressionJitStackPool::stackStartSize()
+{
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return QRegularExpressionJitStackPoolData::DefaultStackStartSize;
+    const QMutexLocker lock(&pool->mutex);
+    return pool->stackStartSize;
+}
+
+/*!
+    \internal
+
+    Returns the size, in bytes, up to which the JIT stacks can grow.
+*/
+qsizetype QRegularExpressionJitStackPool::stackMaximumSize()
+{
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return QRegularExpressionJitStackPoolData::DefaultStackMaximumSize;
+    const QMutexLocker lock(&pool->mutex);
+    return pool->stackMaximumSize;
+}
+
+/*!
+    \internal
+
+    Sets the initial size of the JIT stacks to \a startSize bytes, and the
+    size up to which they can grow to \a maximumSize bytes.
+
+    The pooled stacks are freed. A thread that already has a JIT stack keeps
+    it until one of its matches runs out of it, at which point the match is
+    retried with a stack of the new size.
+*/
+void QRegularExpressionJitStackPool::setStackSize(qsizetype startSize, qsizetype maximumSize)
+{
+    if (startSize <= 0 || maximumSize < startSize) {
+        qWarning("QRegularExpressionJitStackPool::setStackSize: invalid sizes %lld, %lld",
+                 qlonglong(startSize), qlonglong(maximumSize));
+        return;
+    }
+
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return;
+    const QMutexLocker lock(&pool->mutex);
+    if (pool->stackStartSize == startSize && pool->stackMaximumSize == maximumSize)
+        return;
+    pool->stackStartSize = startSize;
+    pool->stackMaximumSize = maximumSize;
+    ++pool->generation;
+    pool->clear();
+}
+
+/*!
+    \internal
+
+    Returns the maximum number of unused JIT stacks kept in the pool.
+*/
+qsizetype QRegularExpressionJitStackPool::capacity()
+{
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return 0;
+    const QMutexLocker lock(&pool->mutex);
+    return pool->capacity;
+}
+
+/*!
+    \internal
+
+    Sets the maximum number of unused JIT stacks kept in the pool to
+    \a capacity. A capacity of 0 disables the pool, so that JIT stacks are
+    freed when their thread exits.
+*/
+void QRegularExpressionJitStackPool::setCapacity(qsizetype capacity)
+{
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return;
+    const QMutexLocker lock(&pool->mutex);
+    pool->capacity = qMax(capacity, qsizetype(0));
+    while (pool->stacks.size() > pool->capacity)
+        pcre2_jit_stack_free_16(pool->stacks.takeLast());
+}
+
+/*!
+    \internal
+
+    Returns the number of unused JIT stacks currently in the pool.
+*/
+qsizetype QRegularExpressionJitStackPool::count()
+{
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return 0;
+    const QMutexLocker lock(&pool->mutex);
+    return pool->stacks.size();
+}
+
+/*!
+    \internal
+
+    Frees all the unused JIT stacks in the pool.
+*/
+void QRegularExpressionJitStackPool::clear()
+{
+    QRegularExpressionJitStackPoolData *pool = jitStackPool();
+    if (!pool)
+        return;
+    const QMutexLocker lock(&pool->mutex);
+    pool->clear();
 }
 
 /*!
@@ -1051,8 +1493,9 @@ int QRegularExpressionPrivate::captureIndexForName(QStringView name) const
     \internal
 
     This is a simple wrapper for pcre2_match_16 for handling the case in which the
-    JIT runs out of memory. In that case, we allocate a thread-local JIT stack
-    and re-run pcre2_match_16.
+    JIT runs out of memory. In that case, we give the thread a JIT stack (or
+    a bigger one, if the configured sizes have grown since it got its current
+    one) and re-run pcre2_match_16.
 */
 static int safe_pcre2_match_16(const pcre2_code_16 *code,
                                PCRE2_SPTR16 subject, int length,
@@ -1063,7 +1506,8 @@ static int safe_pcre2_match_16(const pcre2_code_16 *code,
     int result = pcre2_match_16(code, subject, length,
                                 startOffset, options, matchData, matchContext);
 
-    if (result == PCRE2_ERROR_JIT_STACKLIMIT && !jitStacks()->hasLocalData()) {
+    if (result == PCRE2_ERROR_JIT_STACKLIMIT
+            && (!jitStacks()->hasLocalData() || jitStacks()->localData()->isStale())) {
         QPcreJitStackPointer *p = new QPcreJitStackPointer;
         jitStacks()->setLocalData(p);
 
@@ -1074,6 +1518,47 @@ static int safe_pcre2_match_16(const pcre2_code_16 *code,
     return result;
 }
 
+/*
+    Returns the code units of \a subject to be passed to PCRE2, which rejects
+    null subjects, even empty ones.
+*/
+static const char16_t *pcreSubject(QStringView subject)
+{
+    static const char16_t emptySubject[] = u"";
+    return subject.utf16() ? subject.utf16() : emptySubject;
+}
+
+/*
+    Owns the PCRE2 match context and match data used by a series of matches
+    of the same compiled pattern, done by one thread.
+*/
+class QPcreMatchResources
+{
+    Q_DISABLE_COPY(QPcreMatchResources)
+
+public:
+    /*!
+        \internal
+    */
+    explicit QPcreMatchResources(const pcre2_code_16 *code)
+        : matchContext(pcre2_match_context_create_16(nullptr)),
+          matchData(pcre2_match_data_create_from_pattern_16(code, nullptr))
+    {
+        pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
+    }
+    /*!
+        \internal
+    */
+    ~QPcreMatchResources()
+    {
+        pcre2_match_data_free_16(matchData);
+        pcre2_match_context_free_16(matchContext);
+    }
+
+    pcre2_match_context_16 *matchContext;
+    pcre2_match_data_16 *matchData;
+};
+
 /*!
     \internal
 
@@ -1145,11 +1630,11 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
+    const QPcreMatchResources resources(compiledPattern);
+    pcre2_match_context_16 * const matchContext = resources.matchContext;
+    pcre2_match_data_16 * const matchData = resources.matchData;
 
-    const char16_t * const subjectUtf16 = priv->subject.utf16();
+    const char16_t * const subjectUtf16 = pcreSubject(priv->subject);
 
     int result;
 
@@ -1242,9 +1727,67 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
             capturedOffsets[0] -= maximumLookBehind;
         }
     }
+}
+
+/*!
+    \internal
 
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
+    Performs a normal match, starting at offset 0, on each of the \a count
+    strings in \a subjects, honoring \a matchOptions. The start and length
+    of the first \a capturedGroupCount capturing groups of subject \c i are
+    stored at index \c{i * capturedGroupCount} and onwards of
+    \a capturedStarts and \a capturedLengths.
+
+    Unlike doMatch(), the PCRE2 match data and match context are allocated
+    once for the whole batch. Returns the number of subjects that matched.
+*/
+qsizetype QRegularExpressionPrivate::doBatchMatch(const QStringView *subjects, qsizetype count,
+                                                  qsizetype *capturedStarts, qsizetype *capturedLengths,
+                                                  int capturedGroupCount,
+                                                  QRegularExpression::MatchOptions matchOptions) const
+{
+    Q_ASSERT(compiledPattern);
+    Q_ASSERT(capturedGroupCount > 0);
+
+    const int pcreOptions = convertToPcreOptions(matchOptions);
+    const QPcreMatchResources resources(compiledPattern);
+    const PCRE2_SIZE * const ovector = pcre2_get_ovector_pointer_16(resources.matchData);
+
+    qsizetype matched = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const QStringView subject = subjects[i];
+        const int result = safe_pcre2_match_16(compiledPattern,
+                                               reinterpret_cast<PCRE2_SPTR16>(pcreSubject(subject)),
+                                               int(subject.size()),
+                                               0, pcreOptions,
+                                               resources.matchData, resources.matchContext);
+
+        // result == 0 means not enough space in the ovector; should never happen
+        Q_ASSERT(result != 0);
+
+        const int capturedCount = result > 0 ? qMin(result, capturedGroupCount) : 0;
+        if (result > 0)
+            ++matched;
+
+        qsizetype * const starts = capturedStarts + i * capturedGroupCount;
+        qsizetype * const lengths = capturedLengths + i * capturedGroupCount;
+        for (int group = 0; group < capturedCount; ++group) {
+            const PCRE2_SIZE start = ovector[2 * group];
+            if (start == PCRE2_UNSET) {
+                starts[group] = -1;
+                lengths[group] = 0;
+            } else {
+                starts[group] = qsizetype(start);
+                lengths[group] = qsizetype(ovector[2 * group + 1] - start);
+            }
+        }
+        for (int group = capturedCount; group < capturedGroupCount; ++group) {
+            starts[group] = -1;
+            lengths[group] = 0;
+        }
+    }
+
+    return matched;
 }
 
 /*!
@@ -1663,6 +2206,133 @@ QRegularExpressionMatchIterator QRegularExpression::globalMatch(QStringView subj
     return QRegularExpressionMatchIterator(*priv);
 }
 
+#if QT_CONFIG(thread)
+namespace {
+// State of a batch match split across the threads of a QThreadPool. The
+// subjects are processed in chunks, taken in order by whichever thread
+// (including the calling one) is free; a pool thread that starts once all
+// chunks are taken has nothing to do, and only touches this state, which
+// stays alive until every thread is done with it.
+struct QRegularExpressionBatchMatchState
+{
+    enum { ChunkSize = 1024 };
+
+    QRegularExpressionBatchMatchState(const QRegularExpression &re,
+                                      const QStringView *subjects, qsizetype count,
+                                      qsizetype *capturedStarts, qsizetype *capturedLengths,
+                                      int capturedGroupCount,
+                                      QRegularExpression::MatchOptions matchOptions)
+        : regularExpression(re),
+          subjects(subjects), count(count),
+          capturedStarts(capturedStarts), capturedLengths(capturedLengths),
+          capturedGroupCount(capturedGroupCount),
+          matchOptions(matchOptions),
+          chunkCount((count + ChunkSize - 1) / ChunkSize)
+    {
+    }
+
+    void run(const QRegularExpressionPrivate *d)
+    {
+        for (qsizetype chunk = nextChunk.fetchAndAddRelaxed(1); chunk < chunkCount;
+             chunk = nextChunk.fetchAndAddRelaxed(1)) {
+            const qsizetype begin = chunk * ChunkSize;
+            const qsizetype end = qMin(begin + qsizetype(ChunkSize), count);
+            const qsizetype offset = begin * capturedGroupCount;
+            matched.fetchAndAddRelaxed(d->doBatchMatch(subjects + begin, end - begin,
+                                                       capturedStarts + offset,
+                                                       capturedLengths + offset,
+                                                       capturedGroupCount, matchOptions));
+            finishedChunks.release();
+        }
+    }
+
+    // keeps the compiled pattern alive for late pool threads
+    const QRegularExpression regularExpression;
+    const QStringView * const subjects;
+    const qsizetype count;
+    qsizetype * const capturedStarts;
+    qsizetype * const capturedLengths;
+    const int capturedGroupCount;
+    const QRegularExpression::MatchOptions matchOptions;
+    const qsizetype chunkCount;
+
+    QAtomicInteger<qsizetype> nextChunk = 0;
+    QAtomicInteger<qsizetype> matched = 0;
+    QSemaphore finishedChunks;
+};
+} // unnamed namespace
+#endif // QT_CONFIG(thread)
+
+/*!
+    \since 6.1
+
+    Performs a normal match of the regular expression, starting at offset 0,
+    against each of the \a count string views in \a subjects, honoring the
+    given \a matchOptions. Returns the number of subjects that matched.
+
+    This function is meant for matching one pattern against a large number of
+    short strings, such as log lines or the cells of a table. Instead of
+    creating a QRegularExpressionMatch object for each subject, it stores the
+    position of the captured substrings into the arrays \a capturedStarts and
+    \a capturedLengths. Both must have room for \c{count * capturedGroupCount}
+    elements. For the \c i-th subject, the start and the length of the
+    implicit capturing group 0 (the whole match) are stored at index
+    \c{i * capturedGroupCount}, followed by those of the capturing groups 1 to
+    \a capturedGroupCount - 1. A group that did not capture anything,
+    because the subject doesn't match or because the group didn't take part
+    in the match, gets a start of -1 and a length of 0.
+
+    If \a threadPool is not \nullptr, the subjects are split into chunks
+    that are matched in parallel by the threads of \a threadPool, with the
+    calling thread helping. The function returns once all of the subjects
+    have been matched. Otherwise, all the matching is done by the calling
+    thread.
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 34
+
+    \sa match(), captureCount()
+*/
+qsizetype QRegularExpression::matchBatch(const QStringView *subjects, qsizetype count,
+                                         qsizetype *capturedStarts, qsizetype *capturedLengths,
+                                         int capturedGroupCount,
+                                         MatchOptions matchOptions,
+                                         QThreadPool *threadPool) const
+{
+    if (capturedGroupCount <= 0) {
+        qWarning("QRegularExpression::matchBatch: capturedGroupCount must be positive");
+        return 0;
+    }
+    if (count <= 0)
+        return 0;
+
+    d.data()->compilePattern();
+    if (Q_UNLIKELY(!d->compiledPattern)) {
+        qWarning("QRegularExpression::matchBatch(): called on an invalid QRegularExpression object");
+        std::fill_n(capturedStarts, count * capturedGroupCount, qsizetype(-1));
+        std::fill_n(capturedLengths, count * capturedGroupCount, qsizetype(0));
+        return 0;
+    }
+
+#if QT_CONFIG(thread)
+    if (threadPool && count > QRegularExpressionBatchMatchState::ChunkSize) {
+        auto state = QSharedPointer<QRegularExpressionBatchMatchState>::create(
+                    *this, subjects, count, capturedStarts, capturedLengths,
+                    capturedGroupCount, matchOptions);
+        const qsizetype helpers = qMin(state->chunkCount - 1, qsizetype(threadPool->maxThreadCount()));
+        for (qsizetype i = 0; i < helpers; ++i)
+            threadPool->start([state] { state->run(state->regularExpression.d.constData()); });
+        state->run(d.constData());
+        state->finishedChunks.acquire(int(state->chunkCount));
+        return state->matched.loadRelaxed();
+    }
+#else
+    Q_UNUSED(threadPool);
+#endif
+
+    return d->doBatchMatch(subjects, count, capturedStarts, capturedLengths,
+                           capturedGroupCount, matchOptions);
+}
+
 /*!
     \since 5.4
 
@@ -53,6 +53,7 @@ QT_BEGIN_NAMESPACE
 
 class QStringList;
 class QLatin1String;
+class QThreadPool;
 
 class QRegularExpressionMatch;
 class QRegularExpressionMatchIterator;
@@ -138,6 +139,12 @@ public:
                                                 MatchType matchType       = NormalMatch,
                                                 MatchOptions matchOptions = NoMatchOption) const;
 
+    qsizetype matchBatch(const QStringView *subjects, qsizetype count,
+                         qsizetype *capturedStarts, qsizetype *capturedLengths,
+                         int capturedGroupCount    = 1,
+                         MatchOptions matchOptions = NoMatchOption,
+                         QThreadPool *threadPool   = nullptr) const;
+
     void optimize() const;
 
     enum WildcardConversionOption {
@@ -826,6 +826,115 @@ void qt_to_latin1_unchecked(uchar *dst, const char16_t *src, qsizetype length)
     qt_to_latin1_internal<false>(dst, src, length);
 }
 
+#ifdef __SSE2__
+// Returns a mask with two bits set for each pair of code units that are
+// US-ASCII and equal, ignoring case.
+static inline uint equalAsciiCaseInsensitive(__m128i a, __m128i b)
+{
+    const auto fold = [](__m128i v) {
+        const __m128i upper = _mm_and_si128(_mm_cmpgt_epi16(v, _mm_set1_epi16('A' - 1)),
+                                            _mm_cmplt_epi16(v, _mm_set1_epi16('Z' + 1)));
+        return _mm_add_epi16(v, _mm_and_si128(upper, _mm_set1_epi16(0x20)));
+    };
+    const __m128i nonAscii = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(-0x80));
+    const __m128i ascii = _mm_cmpeq_epi16(nonAscii, _mm_setzero_si128());
+    const __m128i equal = _mm_cmpeq_epi16(fold(a), fold(b));
+    return uint(_mm_movemask_epi8(_mm_and_si128(ascii, equal)));
+}
+
+#  ifdef __AVX2__
+static inline uint equalAsciiCaseInsensitive(__m256i a, __m256i b)
+{
+    const auto fold = [](__m256i v) {
+        const __m256i upper = _mm256_andnot_si256(_mm256_cmpgt_epi16(v, _mm256_set1_epi16('Z')),
+                                                  _mm256_cmpgt_epi16(v, _mm256_set1_epi16('A' - 1)));
+        return _mm256_add_epi16(v, _mm256_and_si256(upper, _mm256_set1_epi16(0x20)));
+    };
+    const __m256i nonAscii = _mm256_and_si256(_mm256_or_si256(a, b), _mm256_set1_epi16(-0x80));
+    const __m256i ascii = _mm256_cmpeq_epi16(nonAscii, _mm256_setzero_si256());
+    const __m256i equal = _mm256_cmpeq_epi16(fold(a), fold(b));
+    return uint(_mm256_movemask_epi8(_mm256_and_si256(ascii, equal)));
+}
+#  endif
+
+static inline __m128i loadCodeUnits8(const char16_t *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+static inline __m128i loadCodeUnits8(const uchar *p)
+{
+    return mm_load8_zero_extend(p);
+}
+
+#  ifdef __AVX2__
+static inline __m256i loadCodeUnits16(const char16_t *p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+static inline __m256i loadCodeUnits16(const uchar *p)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+#  endif
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vminv is only available on Aarch64
+static inline uint16x8_t loadCodeUnits8(const char16_t *p)
+{
+    return vld1q_u16(reinterpret_cast<const uint16_t *>(p));
+}
+
+static inline uint16x8_t loadCodeUnits8(const uchar *p)
+{
+    return vmovl_u8(vld1_u8(p));
+}
+#endif
+
+// Returns the length of the longest common prefix of \a a and \a b, ignoring
+// case, that consists of US-ASCII characters only. The callers fold the
+// characters after it through the Unicode tables.
+template <typename Char>
+static qsizetype ucstricmp_ascii(const char16_t *a, const Char *b, qsizetype l)
+{
+    qsizetype i = 0;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+#  ifdef __AVX2__
+    // we're going to read a[i..i+15] and b[i..i+15]
+    for ( ; l - i >= 16; i += 16) {
+        const uint mask = ~equalAsciiCaseInsensitive(loadCodeUnits16(a + i), loadCodeUnits16(b + i));
+        if (mask)
+            return i + qCountTrailingZeroBits(mask) / 2;
+    }
+#  endif
+    // we're going to read a[i..i+7] and b[i..i+7]
+    for ( ; l - i >= 8; i += 8) {
+        const uint mask = ~equalAsciiCaseInsensitive(loadCodeUnits8(a + i), loadCodeUnits8(b + i)) & 0xffff;
+        if (mask)
+            return i + qCountTrailingZeroBits(mask) / 2;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    for ( ; l - i >= 8; i += 8) {
+        const uint16x8_t da = loadCodeUnits8(a + i);
+        const uint16x8_t db = loadCodeUnits8(b + i);
+        const auto fold = [](uint16x8_t v) {
+            const uint16x8_t upper = vcleq_u16(vsubq_u16(v, vdupq_n_u16('A')), vdupq_n_u16(25));
+            return vaddq_u16(v, vandq_u16(upper, vdupq_n_u16(0x20)));
+        };
+        const uint16x8_t ascii = vcleq_u16(vorrq_u16(da, db), vdupq_n_u16(0x7f));
+        const uint16x8_t equal = vandq_u16(ascii, vceqq_u16(fold(da), fold(db)));
+        if (vminvq_u16(equal) != 0xffff)
+            break;  // let the loop below find the exact position
+    }
+#endif
+    for ( ; i < l; ++i) {
+        const char16_t ca = a[i];
+        const char16_t cb = b[i];
+        if ((ca | cb) >= 0x80 || foldCaseAscii(ca) != foldCaseAscii(cb))
+            break;
+    }
+    return i;
+}
+
 // Unicode case-insensitive comparison
 static int ucstricmp(const QChar *a, const QChar *ae, const QChar *b, const QChar *be)
 {
@@ -839,14 +948,21 @@ static int ucstricmp(const QChar *a, const QChar *ae, const QChar *b, const QCha
     char32_t alast = 0;
     char32_t blast = 0;
     while (a < e) {
-//         qDebug() << Qt::hex << alast << blast;
-//         qDebug() << Qt::hex << "*a=" << *a << "alast=" << alast << "folded=" << foldCase (*a, alast);
-//         qDebug() << Qt::hex << "*b=" << *b << "blast=" << blast << "folded=" << foldCase (*b, blast);
-        int diff = foldCase(a->unicode(), alast) - foldCase(b->unicode(), blast);
-        if ((diff))
-            return diff;
-        ++a;
-        ++b;
+        // skip the common US-ASCII prefix first
+        if (qsizetype n = ucstricmp_ascii(reinterpret_cast<const char16_t *>(a),
+                                          reinterpret_cast<const char16_t *>(b), e - a)) {
+            a += n;
+            b += n;
+            alast = blast = 0;
+            if (a == e)
+                break;
+        }
+        // then fold a few characters through the Unicode tables
+        for (const QChar *chunkEnd = a + qMin(e - a, qptrdiff(8)); a < chunkEnd; ++a, ++b) {
+            int diff = foldCase(a->unicode(), alast) - foldCase(b->unicode(), blast);
+            if ((diff))
+                return diff;
+        }
     }
     if (a == ae) {
         if (b == be)
@@ -864,11 +980,18 @@ static int ucstricmp(const QChar *a, const QChar *ae, const char *b, const char
         e = a + (be - b);
 
     while (a < e) {
-        int diff = foldCase(a->unicode()) - foldCase(char16_t{uchar(*b)});
-        if ((diff))
-            return diff;
-        ++a;
-        ++b;
+        if (qsizetype n = ucstricmp_ascii(reinterpret_cast<const char16_t *>(a),
+                                          reinterpret_cast<const uchar *>(b), e - a)) {
+            a += n;
+            b += n;
+            if (a == e)
+                break;
+        }
+        for (const QChar *chunkEnd = a + qMin(e - a, qptrdiff(8)); a < chunkEnd; ++a, ++b) {
+            int diff = foldCase(a->unicode()) - foldCase(char16_t{uchar(*b)});
+            if ((diff))
+                return diff;
+        }
     }
     if (a == ae) {
         if (b == be)
@@ -1213,7 +1336,7 @@ static int ucstrcmp(const QChar *a, size_t alen, const char *b, size_t blen)
 
 static int latin1nicmp(const char *lhsChar, qsizetype lSize, const char *rhsChar, qsizetype rSize)
 {
-    constexpr uchar latin1Lower[256] = {
+    static constexpr uchar latin1Lower[256] = {
         0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,
         0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,
         0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,
@@ -1243,7 +1366,41 @@ static int latin1nicmp(const char *lhsChar, qsizetype lSize, const char *rhsChar
     const uchar *lhs = reinterpret_cast<const uchar *>(lhsChar);
     const uchar *rhs = reinterpret_cast<const uchar *>(rhsChar);
     Q_ASSERT(lhs && rhs); // since both lSize and rSize are positive
-    for (qsizetype i = 0; i < size; i++) {
+    qsizetype i = 0;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+    // same as latin1Lower, 16 characters at a time
+    const auto inRange = [](__m128i v, uchar first, uchar last) {
+        const __m128i offset = _mm_sub_epi8(v, _mm_set1_epi8(char(first)));
+        return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(char(last - first))), offset);
+    };
+    const auto fold = [&inRange](const uchar *p) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i notTimes = _mm_cmpeq_epi8(v, _mm_set1_epi8(char(0xd7)));
+        const __m128i upper = _mm_or_si128(inRange(v, 'A', 'Z'),
+                                           _mm_andnot_si128(notTimes, inRange(v, 0xc0, 0xde)));
+        return _mm_add_epi8(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    };
+    for ( ; size - i >= 16; i += 16) {
+        const uint mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(fold(lhs + i), fold(rhs + i))) & 0xffff;
+        if (mask) {
+            i += qCountTrailingZeroBits(mask);
+            return latin1Lower[lhs[i]] - latin1Lower[rhs[i]];
+        }
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vminv is only available on Aarch64
+    const auto fold = [](const uchar *p) {
+        const uint8x16_t v = vld1q_u8(p);
+        const uint8x16_t ascii = vcleq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8('Z' - 'A'));
+        const uint8x16_t latin1 = vbicq_u8(vcleq_u8(vsubq_u8(v, vdupq_n_u8(0xc0)), vdupq_n_u8(0xde - 0xc0)),
+                                           vceqq_u8(v, vdupq_n_u8(0xd7)));
+        return vaddq_u8(v, vandq_u8(vorrq_u8(ascii, latin1), vdupq_n_u8(0x20)));
+    };
+    for ( ; size - i >= 16; i += 16) {
+        if (vminvq_u8(vceqq_u8(fold(lhs + i), fold(rhs + i))) != 0xff)
+            break;  // let the loop below find the exact position
+    }
+#endif
+    for ( ; i < size; i++) {
         Q_ASSERT(lhs[i] && rhs[i]);
         if (int res = latin1Lower[lhs[i]] - latin1Lower[rhs[i]])
             return res;
@@ -7100,30 +7257,22 @@ QString QString::number(qulonglong n, int base)
 */
 QString QString::number(double n, char f, int prec)
 {
-    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
-    uint flags = QLocaleData::ZeroPadExponent;
-
-    if (qIsUpper(f))
-        flags |= QLocaleData::CapitalEorX;
-
-    switch (qToLower(f)) {
-        case 'f':
-            form = QLocaleData::DFDecimal;
-            break;
-        case 'e':
-            form = QLocaleData::DFExponent;
-            break;
-        case 'g':
-            form = QLocaleData::DFSignificantDigits;
-            break;
-        default:
 #if defined(QT_CHECK_RANGE)
-            qWarning("QString::setNum: Invalid format char '%c'", f);
+    if (!f || !strchr("eEfFgG", f))
+        qWarning("QString::setNum: Invalid format char '%c'", f);
 #endif
-            break;
-    }
 
-    return QLocaleData::c()->doubleToString(n, prec, form, -1, flags);
+    // The C locale only uses US-ASCII, so this can skip QLocaleData
+    char buffer[64];
+    const qsizetype length = qt_doubleToChars(n, f, prec, buffer, sizeof(buffer));
+    if (length <= qsizetype(sizeof(buffer)))
+        return QString::fromLatin1(buffer, length);
+
+    QVarLengthArray<char> bigBuffer(length);
+    const qsizetype written = qt_doubleToChars(n, f, prec, bigBuffer.data(), length);
+    Q_ASSERT(written == length);
+    Q_UNUSED(written);
+    return QString::fromLatin1(bigBuffer.constData(), length);
 }
 
 namespace {
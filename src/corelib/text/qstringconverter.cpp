@@ -474,6 +474,303 @@ static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *
 }
 #endif
 
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(SSSE3) && !defined(QT_BOOTSTRAPPED)
+#  define UTF8_SSSE3
+
+// Shuffle masks, indexed by a bit mask of characters, and the number of
+// characters or bytes each of them gathers:
+// - decode gathers the 16-bit lanes with a bit set;
+// - encodeTwo takes eight 16-bit lanes each holding a character encoded in
+//   one or two bytes of UTF-8, and gathers the low byte of each lane and the
+//   high byte of those with a bit set;
+// - encodeThree takes four 32-bit lanes each holding a character encoded in
+//   one to three bytes of UTF-8 and is indexed by a mask of the characters
+//   below U+0080 in the low nibble and by one of those below U+0800 in the
+//   high nibble.
+struct Utf8ShuffleTables
+{
+    uchar decode[256][16];
+    uchar encodeTwo[256][16];
+    uchar encodeThree[256][16];
+    uchar decodeLength[256];
+    uchar encodeTwoLength[256];
+    uchar encodeThreeLength[256];
+};
+
+static constexpr Utf8ShuffleTables makeUtf8ShuffleTables()
+{
+    Utf8ShuffleTables tables = {};
+    for (uint mask = 0; mask < 256; ++mask) {
+        uint d = 0;
+        uint e2 = 0;
+        uint e3 = 0;
+        for (uint i = 0; i < 8; ++i) {
+            tables.encodeTwo[mask][e2++] = uchar(2 * i);
+            if (mask & (1U << i)) {
+                tables.decode[mask][d++] = uchar(2 * i);
+                tables.decode[mask][d++] = uchar(2 * i + 1);
+                tables.encodeTwo[mask][e2++] = uchar(2 * i + 1);
+            }
+        }
+        for (uint i = 0; i < 4; ++i) {
+            const uint length = 3 - ((mask >> i) & 1) - ((mask >> (i + 4)) & 1);
+            for (uint j = 0; j < length; ++j)
+                tables.encodeThree[mask][e3++] = uchar(4 * i + j);
+        }
+        tables.decodeLength[mask] = uchar(d / 2);
+        tables.encodeTwoLength[mask] = uchar(e2);
+        tables.encodeThreeLength[mask] = uchar(e3);
+        while (d < 16)
+            tables.decode[mask][d++] = 0x80;
+        while (e2 < 16)
+            tables.encodeTwo[mask][e2++] = 0x80;
+        while (e3 < 16)
+            tables.encodeThree[mask][e3++] = 0x80;
+    }
+    return tables;
+}
+
+static constexpr Utf8ShuffleTables utf8ShuffleTables = makeUtf8ShuffleTables();
+
+// Returns a mask of the bytes in data that are greater than or equal to c.
+static inline uint simdUtf8AtLeast(__m128i data, uchar c)
+{
+    const __m128i flipped = _mm_xor_si128(data, _mm_set1_epi8(char(0x80)));
+    return _mm_movemask_epi8(_mm_cmpgt_epi8(flipped, _mm_set1_epi8(char((c - 1) ^ 0x80))));
+}
+
+// Checks the sixteen bytes in data, which start at the beginning of a
+// character, for valid UTF-8 sequences of up to three bytes. Returns the
+// number of bytes taken by the characters that end in the block and stores
+// in leads one bit for each byte that starts one of them. Four-byte
+// sequences and errors are left to the scalar code: the block is cut before
+// the first of them, and 0 is returned if it starts with one.
+static inline uint simdCheckUtf8Block(__m128i data, uint &leads)
+{
+    const uint nonAscii = _mm_movemask_epi8(data);
+    const uint atLeastA0 = simdUtf8AtLeast(data, 0xa0);
+    const uint atLeastC0 = simdUtf8AtLeast(data, 0xc0);
+    const uint atLeastC2 = simdUtf8AtLeast(data, 0xc2);
+    const uint atLeastE0 = simdUtf8AtLeast(data, 0xe0);
+    const uint atLeastF0 = simdUtf8AtLeast(data, 0xf0);
+    const uint isE0 = _mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(char(0xe0))));
+    const uint isED = _mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(char(0xed))));
+    const uint continuation = nonAscii & ~atLeastC0;
+
+    // leave a sequence that does not end in this block for the next one
+    const uint unfinished = (atLeastC0 & 0x8000) | (atLeastE0 & 0x4000);
+    const uint length = unfinished ? qCountTrailingZeroBits(unfinished) : 16;
+    const uint inBlock = (1U << length) - 1;
+
+    // every lead byte must be followed by the right number of continuation
+    // bytes, and nothing else may be a continuation byte
+    uint errors = continuation ^ ((atLeastC0 << 1) | (atLeastE0 << 2));
+    // overlong sequences and four-byte sequences
+    errors |= (atLeastC0 & ~atLeastC2) | atLeastF0 | (isE0 & ~(atLeastA0 >> 1));
+    // surrogates
+    errors |= isED & (atLeastA0 >> 1);
+    errors &= inBlock;
+
+    leads = ~continuation & inBlock;
+    if (errors) {
+        // stop before the character that contains or precedes the error
+        leads &= (1U << qCountTrailingZeroBits(errors)) - 1;
+        if (!leads)
+            return 0;
+        const uint last = qBitScanReverse(leads);
+        leads &= ~(1U << last);
+        return last;
+    }
+    return length;
+}
+
+// Decodes the characters whose lead bytes are in the low eight bytes of the
+// three registers: the bytes themselves, and the bytes one and two
+// positions later.
+QT_FUNCTION_TARGET(SSSE3)
+static inline void simdDecodeUtf8Half(ushort *&dst, __m128i b0, __m128i b1, __m128i b2, uint leads)
+{
+    const __m128i zero = _mm_setzero_si128();
+    b0 = _mm_unpacklo_epi8(b0, zero);
+    b1 = _mm_unpacklo_epi8(b1, zero);
+    b2 = _mm_unpacklo_epi8(b2, zero);
+
+    const __m128i low6 = _mm_set1_epi16(0x3f);
+    const __m128i two = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b0, _mm_set1_epi16(0x1f)), 6),
+                                     _mm_and_si128(b1, low6));
+    const __m128i three = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(b0, 12),
+                                                    _mm_slli_epi16(_mm_and_si128(b1, low6), 6)),
+                                       _mm_and_si128(b2, low6));
+    const __m128i isAscii = _mm_cmplt_epi16(b0, _mm_set1_epi16(0x80));
+    const __m128i isThree = _mm_cmpgt_epi16(b0, _mm_set1_epi16(0xdf));
+    __m128i chars = _mm_or_si128(_mm_and_si128(isThree, three), _mm_andnot_si128(isThree, two));
+    chars = _mm_or_si128(_mm_and_si128(isAscii, b0), _mm_andnot_si128(isAscii, chars));
+
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8ShuffleTables.decode[leads]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(chars, shuffle));
+    dst += utf8ShuffleTables.decodeLength[leads];
+}
+
+// Decodes blocks of sixteen bytes that contain characters of up to three
+// bytes until a block is all US-ASCII, when simdDecodeAscii() is faster, or
+// starts with a character that is left to the scalar code.
+// Leaves at least one byte in the input.
+QT_FUNCTION_TARGET(SSSE3)
+static void simdDecodeNonAsciiSsse3(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    while (end - src > 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        if (!_mm_movemask_epi8(data))
+            return;
+
+        uint leads;
+        const uint length = simdCheckUtf8Block(data, leads);
+        if (!length)
+            return;
+
+        const __m128i next1 = _mm_srli_si128(data, 1);
+        const __m128i next2 = _mm_srli_si128(data, 2);
+        simdDecodeUtf8Half(dst, data, next1, next2, leads & 0xff);
+        simdDecodeUtf8Half(dst, _mm_srli_si128(data, 8), _mm_srli_si128(next1, 8),
+                           _mm_srli_si128(next2, 8), leads >> 8);
+        src += length;
+    }
+}
+
+// Like simdDecodeNonAsciiSsse3(), but only validates, which SSE2 is enough
+// for.
+static void simdCheckNonAsciiSse2(const uchar *&src, const uchar *end)
+{
+    while (end - src > 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        if (!_mm_movemask_epi8(data))
+            return;
+
+        uint leads;
+        const uint length = simdCheckUtf8Block(data, leads);
+        if (!length)
+            return;
+        src += length;
+    }
+}
+
+// Encodes four characters, zero-extended to 32 bits, none of them a
+// surrogate.
+QT_FUNCTION_TARGET(SSSE3)
+static inline void simdEncodeUtf8Half(uchar *&dst, __m128i chars)
+{
+    const __m128i low6 = _mm_set1_epi32(0x3f);
+    const __m128i continuation = _mm_set1_epi32(0x80);
+
+    // the bytes of each character in memory order, in its 32-bit lane
+    const __m128i two = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(chars, 6), _mm_set1_epi32(0xc0)),
+                                     _mm_slli_epi32(_mm_or_si128(_mm_and_si128(chars, low6), continuation), 8));
+    __m128i three = _mm_or_si128(_mm_srli_epi32(chars, 12), _mm_set1_epi32(0xe0));
+    three = _mm_or_si128(three, _mm_slli_epi32(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(chars, 6), low6),
+                                                            continuation), 8));
+    three = _mm_or_si128(three, _mm_slli_epi32(_mm_or_si128(_mm_and_si128(chars, low6), continuation), 16));
+
+    const __m128i isAscii = _mm_cmplt_epi32(chars, _mm_set1_epi32(0x80));
+    const __m128i isTwo = _mm_cmplt_epi32(chars, _mm_set1_epi32(0x800));
+    __m128i bytes = _mm_or_si128(_mm_and_si128(isTwo, two), _mm_andnot_si128(isTwo, three));
+    bytes = _mm_or_si128(_mm_and_si128(isAscii, chars), _mm_andnot_si128(isAscii, bytes));
+
+    const uint ascii = _mm_movemask_ps(_mm_castsi128_ps(isAscii));
+    const uint twoBytes = _mm_movemask_ps(_mm_castsi128_ps(isTwo));
+    const uint index = ascii | twoBytes << 4;
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8ShuffleTables.encodeThree[index]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(bytes, shuffle));
+    dst += utf8ShuffleTables.encodeThreeLength[index];
+}
+
+// Encodes blocks of eight characters until a block is all US-ASCII, when
+// simdEncodeAscii() is faster, or contains a surrogate, which is left to the
+// scalar code.
+// Leaves at least one character in the input.
+QT_FUNCTION_TARGET(SSSE3)
+static void simdEncodeNonAsciiSsse3(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    // stay sixteen characters away from the end, so that there is space for
+    // the sixteen-byte stores
+    for ( ; end - src >= 16; src += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))), zero);
+        if (_mm_movemask_epi8(ascii) == 0xffff)
+            return;
+        const __m128i high5 = _mm_and_si128(data, _mm_set1_epi16(short(0xf800)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high5, _mm_set1_epi16(short(0xd800)))))
+            return;
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high5, zero)) == 0xffff) {
+            // all characters below U+0800, which is the common case for
+            // alphabetic scripts: one or two bytes per character
+            const __m128i two = _mm_or_si128(_mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0)),
+                                             _mm_slli_epi16(_mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)),
+                                                                         _mm_set1_epi16(0x80)), 8));
+            const __m128i bytes = _mm_or_si128(_mm_and_si128(ascii, data), _mm_andnot_si128(ascii, two));
+            const uint twoBytes = ~_mm_movemask_epi8(_mm_packs_epi16(ascii, zero)) & 0xff;
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8ShuffleTables.encodeTwo[twoBytes]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(bytes, shuffle));
+            dst += utf8ShuffleTables.encodeTwoLength[twoBytes];
+            continue;
+        }
+
+        // up to three bytes per character
+        simdEncodeUtf8Half(dst, _mm_unpacklo_epi16(data, zero));
+        simdEncodeUtf8Half(dst, _mm_unpackhi_epi16(data, zero));
+    }
+}
+#endif
+
+// The dispatchers below pass copies of the pointers to the SIMD functions,
+// which cannot be inlined, so that the callers can keep theirs in registers.
+static inline void simdDecodeNonAscii(ushort *&dst, const uchar *&src, const uchar *end)
+{
+#ifdef UTF8_SSSE3
+    if (qCpuHasFeature(SSSE3)) {
+        ushort *d = dst;
+        const uchar *s = src;
+        simdDecodeNonAsciiSsse3(d, s, end);
+        dst = d;
+        src = s;
+    }
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
+static inline void simdCheckNonAscii(const uchar *&src, const uchar *end)
+{
+#ifdef UTF8_SSSE3
+    const uchar *s = src;
+    simdCheckNonAsciiSse2(s, end);
+    src = s;
+#else
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
+static inline void simdEncodeNonAscii(uchar *&dst, const ushort *&src, const ushort *end)
+{
+#ifdef UTF8_SSSE3
+    if (qCpuHasFeature(SSSE3)) {
+        uchar *d = dst;
+        const ushort *s = src;
+        simdEncodeNonAsciiSsse3(d, s, end);
+        dst = d;
+        src = s;
+    }
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(const QChar *uc, qsizetype len)
@@ -488,6 +785,7 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, qsizetype len)
         const ushort *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        simdEncodeNonAscii(dst, src, end);
 
         do {
             ushort u = *src++;
@@ -555,6 +853,7 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const ushort *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        simdEncodeNonAscii(cursor, src, end);
 
         do {
             ushort uc = *src++;
@@ -641,6 +940,7 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, const char *chars, qsizetype len)
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            simdDecodeNonAscii(dst, src, end);
 
             do {
                 uchar b = *src++;
@@ -741,8 +1041,11 @@ QChar *QUtf8::convertToUnicode(QChar *out, const char *chars, qsizetype len, QSt
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            simdDecodeNonAscii(dst, src, end);
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -790,10 +1093,15 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(const char *chars, qsizetype len)
     bool isValidAscii = true;
 
     while (src < end) {
-        if (src >= nextAscii)
+        if (src >= nextAscii) {
             src = simdFindNonAscii(src, end, nextAscii);
-        if (src == end)
-            break;
+            if (src == end)
+                break;
+            if (*src & 0x80) {
+                isValidAscii = false;
+                simdCheckNonAscii(src, end);
+            }
+        }
 
         do {
             uchar b = *src++;
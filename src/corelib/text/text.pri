@@ -15,6 +15,7 @@ HEADERS +=  \
         text/qlocale.h \
         text/qlocale_p.h \
         text/qlocale_tools_p.h \
+        text/qmultistringmatcher.h \
         text/qlocale_data_p.h \
         text/qstring.h \
         text/qstringalgorithms.h \
@@ -40,6 +41,7 @@ SOURCES += \
         text/qcollator.cpp \
         text/qlocale.cpp \
         text/qlocale_tools.cpp \
+        text/qmultistringmatcher.cpp \
         text/qstring.cpp \
         text/qstringbuilder.cpp \
         text/qstringconverter.cpp \
@@ -82,7 +84,8 @@ qtConfig(regularexpression) {
     QMAKE_USE_PRIVATE += pcre2
 
     HEADERS += \
-        text/qregularexpression.h
+        text/qregularexpression.h \
+        text/qregularexpression_p.h
     SOURCES += text/qregularexpression.cpp
 }
 
@@ -102,6 +102,16 @@ QThreadData::~QThreadData()
         }
     }
 
+    // the receivers of events that never made it into the list are gone
+    QPostEventNode *node = postEventList.takeIncoming();
+    while (node) {
+        QPostEventNode *next = node->next;
+        node->event.event->posted = false;
+        delete node->event.event;
+        delete node;
+        node = next;
+    }
+
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
@@ -513,6 +523,45 @@ uint QThread::stackSize() const
     return d->stackSize;
 }
 
+/*!
+    \since 6.1
+
+    Restricts the thread to the CPUs listed in \a cpus, numbered from 0 as
+    the operating system numbers them. An empty list, the default, removes
+    the restriction.
+
+    If the thread is running, the new affinity takes effect immediately,
+    otherwise when the thread is started.
+
+    \note CPU affinity is only supported on Linux. On other platforms the
+    list is stored, but has no effect.
+
+    \sa cpuAffinity(), QThreadPool::setCpuAffinity()
+*/
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThread);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    if (d->running && !d->isInFinish)
+        d->setCpuAffinity(cpus);
+}
+
+/*!
+    \since 6.1
+
+    Returns the CPUs the thread is restricted to, as set with
+    setCpuAffinity(), or an empty list if it may run on any CPU.
+
+    \sa setCpuAffinity()
+*/
+QList<int> QThread::cpuAffinity() const
+{
+    Q_D(const QThread);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
 /*!
     Enters the event loop and waits until exit() is called, returning the value
     that was passed to exit(). The value returned is 0 if exit() is called via
@@ -938,6 +987,16 @@ uint QThread::stackSize() const
     return 0;
 }
 
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_UNUSED(cpus);
+}
+
+QList<int> QThread::cpuAffinity() const
+{
+    return QList<int>();
+}
+
 #endif // QT_CONFIG(thread)
 
 /*!
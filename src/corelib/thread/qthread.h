@@ -95,6 +95,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setCpuAffinity(const QList<int> &cpus);
+    QList<int> cpuAffinity() const;
+
     void exit(int retcode = 0);
 
     QAbstractEventDispatcher *eventDispatcher() const;
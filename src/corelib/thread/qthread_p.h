@@ -92,6 +92,14 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// An event posted from another thread, queued until the receiving thread
+// moves it into its QPostEventList
+struct QPostEventNode
+{
+    QPostEvent event;
+    QPostEventNode *next;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 class QPostEventList : public QList<QPostEvent>
@@ -107,8 +115,40 @@ public:
 
     QMutex mutex;
 
+    // events posted from other threads without taking the mutex, most
+    // recent first; whoever holds the mutex moves them into the list
+    QAtomicPointer<QPostEventNode> incoming;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
+    void pushIncoming(QPostEventNode *node)
+    {
+        // the node must not be written to once it's published
+        QPostEventNode *head = incoming.loadRelaxed();
+        do {
+            node->next = head;
+        } while (!incoming.testAndSetRelease(head, node, head));
+    }
+
+    bool hasIncoming() const
+    {
+        return incoming.loadAcquire() != nullptr;
+    }
+
+    // takes all incoming events, in the order they were posted
+    QPostEventNode *takeIncoming()
+    {
+        QPostEventNode *node = incoming.fetchAndStoreAcquire(nullptr);
+        QPostEventNode *first = nullptr;
+        while (node) {
+            QPostEventNode *next = node->next;
+            node->next = first;
+            first = node;
+            node = next;
+        }
+        return first;
+    }
+
     void addEvent(const QPostEvent &ev) {
         int priority = ev.priority;
         if (isEmpty() ||
@@ -149,6 +189,11 @@ public:
     ~QThreadPrivate();
 
     void setPriority(QThread::Priority prio);
+    void setCpuAffinity(const QList<int> &cpus);
+
+    // the CPUs of each NUMA node, indexed by node; empty if not known
+    static QList<QList<int>> numaNodes();
+    static int currentNumaNode();
 
     mutable QMutex mutex;
     QAtomicInt quitLockRef;
@@ -163,6 +208,7 @@ public:
 
     uint stackSize;
     QThread::Priority priority;
+    QList<int> cpuAffinity;
 
     static QThread *threadForId(int id);
 
@@ -255,7 +301,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncoming();
     }
 
     // This class provides per-thread (by way of being a QThreadData
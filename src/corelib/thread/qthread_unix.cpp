@@ -303,6 +303,9 @@ void *QThreadPrivate::start(void *arg)
             data->threadId.storeRelaxed(to_HANDLE(pthread_self()));
             set_thread_data(data);
 
+            if (!thr->d_func()->cpuAffinity.isEmpty())
+                thr->d_func()->setCpuAffinity(thr->d_func()->cpuAffinity);
+
             data->ref();
             data->quitNow = thr->d_func()->exited;
         }
@@ -828,6 +831,104 @@ void QThreadPrivate::setPriority(QThread::Priority threadPriority)
 #endif
 }
 
+// Caller must lock the mutex
+void QThreadPrivate::setCpuAffinity(const QList<int> &cpus)
+{
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    const pthread_t thread = from_HANDLE<pthread_t>(data->threadId.loadRelaxed());
+    if (!thread)
+        return; // start() applies it once the thread runs
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpus.isEmpty()) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &set);
+    } else {
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+    }
+
+    int code = pthread_setaffinity_np(thread, sizeof(set), &set);
+    if (code)
+        qErrnoWarning(code, "QThread::setCpuAffinity: Cannot set CPU affinity");
+#else
+    Q_UNUSED(cpus);
+#endif
+}
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+static QByteArray readSysFile(const char *path)
+{
+    int fd = qt_safe_open(path, O_RDONLY);
+    if (fd == -1)
+        return QByteArray();
+    char buffer[4096];
+    qint64 len = qt_safe_read(fd, buffer, sizeof(buffer));
+    qt_safe_close(fd);
+    return len > 0 ? QByteArray(buffer, len).trimmed() : QByteArray();
+}
+
+// parses a sysfs CPU or node list such as "0-3,8-11"
+static QList<int> parseSysList(const QByteArray &list)
+{
+    QList<int> result;
+    for (const QByteArray &range : list.split(',')) {
+        if (range.isEmpty())
+            continue;
+        bool ok1 = true, ok2 = true;
+        int dash = range.indexOf('-');
+        int first = range.left(dash).toInt(&ok1);
+        int last = dash < 0 ? first : range.mid(dash + 1).toInt(&ok2);
+        if (!ok1 || !ok2 || first < 0 || last < first)
+            return QList<int>();
+        for (int i = first; i <= last; ++i)
+            result.append(i);
+    }
+    return result;
+}
+
+static QList<QList<int>> readNumaNodes()
+{
+    QList<QList<int>> nodes;
+    const QList<int> online = parseSysList(readSysFile("/sys/devices/system/node/online"));
+    for (int node : online) {
+        QByteArray path = "/sys/devices/system/node/node" + QByteArray::number(node) + "/cpulist";
+        if (node >= nodes.size())
+            nodes.resize(node + 1);
+        nodes[node] = parseSysList(readSysFile(path.constData()));
+    }
+    return nodes;
+}
+#endif
+
+QList<QList<int>> QThreadPrivate::numaNodes()
+{
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    static const QList<QList<int>> nodes = readNumaNodes();
+    return nodes;
+#else
+    return QList<QList<int>>();
+#endif
+}
+
+int QThreadPrivate::currentNumaNode()
+{
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    const int cpu = sched_getcpu();
+    if (cpu < 0)
+        return -1;
+    const QList<QList<int>> nodes = numaNodes();
+    for (int node = 0; node < nodes.size(); ++node) {
+        if (nodes.at(node).contains(cpu))
+            return node;
+    }
+#endif
+    return -1;
+}
+
 #endif // QT_CONFIG(thread)
 
 QT_END_NAMESPACE
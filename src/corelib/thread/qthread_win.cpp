@@ -621,6 +621,21 @@ void QThreadPrivate::setPriority(QThread::Priority threadPriority)
     }
 }
 
+void QThreadPrivate::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_UNUSED(cpus);
+}
+
+QList<QList<int>> QThreadPrivate::numaNodes()
+{
+    return QList<QList<int>>();
+}
+
+int QThreadPrivate::currentNumaNode()
+{
+    return -1;
+}
+
 #endif // QT_CONFIG(thread)
 
 QT_END_NAMESPACE
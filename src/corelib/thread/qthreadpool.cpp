@@ -39,6 +39,7 @@
 
 #include "qthreadpool.h"
 #include "qthreadpool_p.h"
+#include "qthread_p.h"
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
 
@@ -60,8 +61,100 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QWorkStealingQueue localQueue;
+    int numaNode = -1;
 };
 
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
+QWorkStealingQueue::QWorkStealingQueue()
+    : m_top(0), m_bottom(0)
+{
+    m_buffers.emplace_back(new Buffer(64));
+    m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+QWorkStealingQueue::~QWorkStealingQueue()
+{
+    Q_ASSERT(isEmpty());
+}
+
+QWorkStealingQueue::Buffer *QWorkStealingQueue::grow(Buffer *buffer, qint64 top, qint64 bottom)
+{
+    Buffer *grown = new Buffer(buffer->capacity() * 2);
+    for (qint64 i = top; i < bottom; ++i)
+        grown->set(i, buffer->at(i));
+    m_buffers.emplace_back(grown);
+    return grown;
+}
+
+void QWorkStealingQueue::push(QRunnable *runnable)
+{
+    const qint64 bottom = m_bottom.load(std::memory_order_relaxed);
+    const qint64 top = m_top.load(std::memory_order_acquire);
+    Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->mask) {
+        buffer = grow(buffer, top, bottom);
+        m_buffer.store(buffer, std::memory_order_release);
+    }
+
+    buffer->set(bottom, runnable);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+QRunnable *QWorkStealingQueue::pop()
+{
+    const qint64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    qint64 top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    QRunnable *runnable = buffer->at(bottom);
+    if (top == bottom) {
+        // the last one, a thief might be taking it as well
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            runnable = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return runnable;
+}
+
+qint64 QWorkStealingQueue::size() const
+{
+    const qint64 top = m_top.load(std::memory_order_relaxed);
+    const qint64 bottom = m_bottom.load(std::memory_order_relaxed);
+    return qMax(bottom - top, Q_INT64_C(0));
+}
+
+QRunnable *QWorkStealingQueue::steal()
+{
+    for (;;) {
+        qint64 top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const qint64 bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        Buffer *buffer = m_buffer.load(std::memory_order_acquire);
+        QRunnable *runnable = buffer->at(top);
+        if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return runnable;
+        }
+        // lost against the owner or another thief, try the next one
+    }
+}
+
 /*
     QThreadPool private class.
 */
@@ -74,6 +167,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
     :manager(manager), runnable(nullptr)
 {
     setStackSize(manager->stackSize);
+    setCpuAffinity(manager->cpuAffinity);
 }
 
 /*
@@ -81,6 +175,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -88,28 +183,32 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                const bool del = r->autoDelete();
-                Q_ASSERT(!del || r->ref == 1);
-
-
                 // run the task
                 locker.unlock();
+                do {
+                    const bool del = r->autoDelete();
+                    Q_ASSERT(!del || r->ref == 1);
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // then the ones started from this thread, without locking
+                    r = localQueue.isEmpty() ? nullptr : localQueue.pop();
+                } while (r);
                 locker.relock();
             }
 
@@ -118,7 +217,9 @@ void QThreadPoolThread::run()
                 break;
 
             if (manager->queue.isEmpty()) {
-                r = nullptr;
+                r = manager->workStealing ? manager->stealRunnable(this) : nullptr;
+                if (r)
+                    continue;
                 break;
             }
 
@@ -136,10 +237,22 @@ void QThreadPoolThread::run()
         if (!expired) {
             manager->waitingThreads.enqueue(this);
             registerThreadInactive();
+            const bool workStealing = manager->workStealing;
+            bool stolen = false;
+            if (workStealing) {
+                // pairs with the fence in startLocal(): a runnable pushed
+                // before we are counted as idle must be found here
+                manager->idleThreads.fetchAndAddOrdered(1);
+                runnable = manager->stealRunnable(this);
+                stolen = runnable != nullptr;
+            }
             // wait for work, exiting after the expiry timeout is reached
-            runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
+            if (!stolen)
+                runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
+            if (workStealing)
+                manager->idleThreads.fetchAndSubOrdered(1);
             ++manager->activeThreads;
-            if (manager->waitingThreads.removeOne(this))
+            if (manager->waitingThreads.removeOne(this) && !stolen)
                 expired = true;
             if (!manager->allThreads.contains(this)) {
                 registerThreadInactive();
@@ -180,20 +293,22 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
     if (activeThreadCount() >= maxThreadCount)
         return false;
 
+    const int node = submitterNumaNode();
     if (waitingThreads.count() > 0) {
         // recycle an available thread
         enqueueTask(task);
-        waitingThreads.takeFirst()->runnableReady.wakeOne();
+        takeThread(waitingThreads, node)->runnableReady.wakeOne();
         return true;
     }
 
     if (!expiredThreads.isEmpty()) {
         // restart an expired thread
-        QThreadPoolThread *thread = expiredThreads.dequeue();
+        QThreadPoolThread *thread = takeThread(expiredThreads, node);
         Q_ASSERT(thread->runnable == nullptr);
 
         ++activeThreads;
 
+        setThreadNumaNode(thread, node);
         thread->runnable = task;
         thread->start();
         return true;
@@ -247,6 +362,160 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
     }
 }
 
+/*!
+    \internal
+    Returns the thread of this pool the caller runs in, if any.
+*/
+QThreadPoolThread *QThreadPoolPrivate::currentThread() const
+{
+    QThreadPoolThread *thread = currentPoolThread;
+    return thread && thread->manager == this ? thread : nullptr;
+}
+
+/*!
+    \internal
+    Queues \a runnable in the local queue of \a thread, which must be the
+    current thread, and makes sure there's a thread around to steal it.
+*/
+void QThreadPoolPrivate::startLocal(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    const bool wasEmpty = thread->localQueue.isEmpty();
+    thread->localQueue.push(runnable);
+
+    // pairs with the increment in QThreadPoolThread::run(): either the
+    // idle thread finds the runnable, or we see that it's idle
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (wasEmpty || idleThreads.loadRelaxed() > 0) {
+        QMutexLocker locker(&mutex);
+        wakeIdleThread();
+    }
+}
+
+/*!
+    \internal
+    Wakes up a waiting thread, or starts one if we're below the limit, so
+    that it can steal from the local queues.
+*/
+void QThreadPoolPrivate::wakeIdleThread()
+{
+    const int node = submitterNumaNode();
+    if (!waitingThreads.isEmpty()) {
+        takeThread(waitingThreads, node)->runnableReady.wakeOne();
+        return;
+    }
+
+    if (activeThreadCount() >= maxThreadCount)
+        return;
+
+    if (!expiredThreads.isEmpty()) {
+        // restart an expired thread
+        QThreadPoolThread *thread = takeThread(expiredThreads, node);
+        Q_ASSERT(thread->runnable == nullptr);
+        ++activeThreads;
+        setThreadNumaNode(thread, node);
+        thread->start();
+        return;
+    }
+
+    startThread();
+}
+
+/*!
+    \internal
+    Takes a runnable from the local queue of another thread for \a thief,
+    along with up to half of the ones remaining there, so that the thief
+    doesn't have to come back for each of them. Called with the mutex
+    locked, which keeps the other threads alive.
+*/
+QRunnable *QThreadPoolPrivate::stealRunnable(QThreadPoolThread *thief)
+{
+    // with NUMA affinity, try the threads on the thief's node first
+    const bool sameNodeFirst = thief->numaNode >= 0;
+    for (int pass = sameNodeFirst ? 0 : 1; pass < 2; ++pass) {
+        for (QThreadPoolThread *victim : qAsConst(allThreads)) {
+            if (victim == thief)
+                continue;
+            if (sameNodeFirst && (victim->numaNode == thief->numaNode) != (pass == 0))
+                continue;
+
+            QRunnable *runnable = victim->localQueue.steal();
+            if (!runnable)
+                continue;
+
+            for (qint64 n = victim->localQueue.size() / 2; n > 0; --n) {
+                QRunnable *next = victim->localQueue.steal();
+                if (!next)
+                    break;
+                thief->localQueue.push(next);
+            }
+            return runnable;
+        }
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+    Returns the NUMA node the calling thread runs on, or -1 if NUMA
+    affinity is disabled or the system has a single node.
+*/
+int QThreadPoolPrivate::submitterNumaNode() const
+{
+    if (!numaAffinity || QThreadPrivate::numaNodes().size() < 2)
+        return -1;
+    return QThreadPrivate::currentNumaNode();
+}
+
+/*!
+    \internal
+    Returns the CPUs a thread on \a node may run on: those of the node that
+    are also in the pool's CPU affinity, or just the latter if \a node is
+    -1 or the two don't overlap.
+*/
+QList<int> QThreadPoolPrivate::cpuAffinityForNode(int node) const
+{
+    const QList<QList<int>> nodes = QThreadPrivate::numaNodes();
+    if (node < 0 || node >= nodes.size())
+        return cpuAffinity;
+    if (cpuAffinity.isEmpty())
+        return nodes.at(node);
+
+    QList<int> cpus;
+    for (int cpu : nodes.at(node)) {
+        if (cpuAffinity.contains(cpu))
+            cpus.append(cpu);
+    }
+    return cpus.isEmpty() ? cpuAffinity : cpus;
+}
+
+/*!
+    \internal
+    Binds \a thread, which must not be running, to the CPUs of \a node.
+*/
+void QThreadPoolPrivate::setThreadNumaNode(QThreadPoolThread *thread, int node)
+{
+    if (thread->numaNode == node)
+        return;
+    thread->numaNode = node;
+    thread->setCpuAffinity(cpuAffinityForNode(node));
+}
+
+/*!
+    \internal
+    Takes a thread from \a threads, preferring one on \a node.
+*/
+QThreadPoolThread *QThreadPoolPrivate::takeThread(QQueue<QThreadPoolThread *> &threads, int node)
+{
+    Q_ASSERT(!threads.isEmpty());
+    if (node >= 0) {
+        for (qsizetype i = 0; i < threads.size(); ++i) {
+            if (threads.at(i)->numaNode == node)
+                return threads.takeAt(i);
+        }
+    }
+    return threads.takeFirst();
+}
+
 bool QThreadPoolPrivate::tooManyThreadsActive() const
 {
     const int activeThreadCount = this->activeThreadCount();
@@ -258,9 +527,10 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
+    Q_ASSERT(runnable != nullptr || workStealing);
     QScopedPointer <QThreadPoolThread> thread(new QThreadPoolThread(this));
     thread->setObjectName(QLatin1String("Thread (pooled)"));
+    setThreadNumaNode(thread.data(), submitterNumaNode());
     Q_ASSERT(!allThreads.contains(thread.data())); // if this assert hits, we have an ABA problem (deleted threads don't get removed here)
     allThreads.insert(thread.data());
     ++activeThreads;
@@ -507,6 +777,17 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->workStealing) {
+        if (QThreadPoolThread *thread = d->currentThread()) {
+            if (runnable->autoDelete()) {
+                Q_ASSERT(runnable->ref == 0);
+                ++runnable->ref;
+            }
+            d->startLocal(thread, runnable);
+            return;
+        }
+    }
+
     QMutexLocker locker(&d->mutex);
     if (runnable->autoDelete()) {
         Q_ASSERT(runnable->ref == 0);
@@ -517,7 +798,7 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         d->enqueueTask(runnable, priority);
 
         if (!d->waitingThreads.isEmpty())
-            d->waitingThreads.takeFirst()->runnableReady.wakeOne();
+            d->takeThread(d->waitingThreads, d->submitterNumaNode())->runnableReady.wakeOne();
     }
 }
 
@@ -722,6 +1003,110 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \since 6.1
+
+    This property holds whether the thread pool threads keep the runnables
+    they start in queues of their own.
+
+    When enabled, a runnable started with start() from one of the pool's
+    threads is put in a queue owned by that thread, without locking. The
+    thread runs the runnables in its queue, most recently started first,
+    when its current runnable returns. Threads without work take runnables
+    from the other threads' queues. This avoids contention when many small
+    runnables are started from within the pool, as with recursive divide
+    and conquer algorithms.
+
+    The priority passed to start() only orders the runnables started from
+    outside the pool, which are still run before any taken from another
+    thread's queue. Runnables in the thread queues are not affected by
+    tryTake() or clear().
+
+    The default value is \c false. Change it before starting any runnables.
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->workStealing = enabled;
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing;
+}
+
+/*!
+    \since 6.1
+
+    Restricts the thread pool threads to the CPUs listed in \a cpus. An
+    empty list, the default, lets them run on any CPU. Unlike stackSize(),
+    the new affinity also applies to the threads that already exist.
+
+    \note CPU affinity is only supported on Linux. On other platforms this
+    function has no effect.
+
+    \sa cpuAffinity(), QThread::setCpuAffinity(), numaAffinityEnabled
+*/
+void QThreadPool::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads))
+        thread->setCpuAffinity(d->cpuAffinityForNode(thread->numaNode));
+}
+
+/*!
+    \since 6.1
+
+    Returns the CPUs the thread pool threads are restricted to, or an empty
+    list if they may run on any CPU.
+
+    \sa setCpuAffinity()
+*/
+QList<int> QThreadPool::cpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
+/*! \property QThreadPool::numaAffinityEnabled
+    \since 6.1
+
+    This property holds whether the thread pool keeps runnables on the NUMA
+    node they are started from.
+
+    When enabled on a system with more than one NUMA node, each thread of
+    the pool is bound to the CPUs of a single node, within the limits set
+    by setCpuAffinity(). A runnable started with start() or tryStart() is
+    handed to a waiting thread on the node of the thread starting it, or to
+    a new thread started on that node, so that the runnable works on memory
+    local to that node. If there is no such thread, a thread on another
+    node is used. With \l workStealingEnabled, threads out of work take
+    runnables from the threads on their own node first.
+
+    Runnables that have to wait in the pool's queue can still be run by a
+    thread on any node.
+
+    The default value is \c false. On systems with a single NUMA node, and on
+    platforms other than Linux, this property has no effect.
+*/
+void QThreadPool::setNumaAffinityEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->numaAffinity = enabled;
+}
+
+bool QThreadPool::isNumaAffinityEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->numaAffinity;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -61,6 +61,8 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(bool workStealingEnabled READ isWorkStealingEnabled WRITE setWorkStealingEnabled)
+    Q_PROPERTY(bool numaAffinityEnabled READ isNumaAffinityEnabled WRITE setNumaAffinityEnabled)
     friend class QFutureInterfaceBase;
 
 public:
@@ -86,6 +88,15 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setWorkStealingEnabled(bool enabled);
+    bool isWorkStealingEnabled() const;
+
+    void setCpuAffinity(const QList<int> &cpus);
+    QList<int> cpuAffinity() const;
+
+    void setNumaAffinityEnabled(bool enabled);
+    bool isNumaAffinityEnabled() const;
+
     void reserveThread();
     void releaseThread();
 
@@ -59,6 +59,10 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -146,6 +150,52 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+// Chase-Lev work stealing deque. The owning thread pushes and pops at the
+// bottom without locking, any other thread may steal from the top.
+class QWorkStealingQueue
+{
+public:
+    QWorkStealingQueue();
+    ~QWorkStealingQueue();
+
+    // owner only
+    bool isEmpty() const
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+    void push(QRunnable *runnable);
+    QRunnable *pop();
+
+    // any thread
+    qint64 size() const;
+    QRunnable *steal();
+
+private:
+    struct Buffer
+    {
+        explicit Buffer(qint64 capacity)
+            : mask(capacity - 1), entries(new std::atomic<QRunnable *>[capacity])
+        { }
+
+        qint64 capacity() const { return mask + 1; }
+        QRunnable *at(qint64 index) const
+        { return entries[index & mask].load(std::memory_order_relaxed); }
+        void set(qint64 index, QRunnable *runnable)
+        { entries[index & mask].store(runnable, std::memory_order_relaxed); }
+
+        const qint64 mask;
+        std::unique_ptr<std::atomic<QRunnable *>[]> entries;
+    };
+
+    Buffer *grow(Buffer *buffer, qint64 top, qint64 bottom);
+
+    std::atomic<qint64> m_top;
+    std::atomic<qint64> m_bottom;
+    std::atomic<Buffer *> m_buffer;
+    // thieves may still read from replaced buffers, keep them until the end
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -170,6 +220,16 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    QThreadPoolThread *currentThread() const;
+    void startLocal(QThreadPoolThread *thread, QRunnable *runnable);
+    void wakeIdleThread();
+    QRunnable *stealRunnable(QThreadPoolThread *thief);
+
+    int submitterNumaNode() const;
+    QList<int> cpuAffinityForNode(int node) const;
+    void setThreadNumaNode(QThreadPoolThread *thread, int node);
+    QThreadPoolThread *takeThread(QQueue<QThreadPoolThread *> &threads, int node);
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -182,6 +242,11 @@ public:
     int reservedThreads = 0;
     int activeThreads = 0;
     uint stackSize = 0;
+    bool workStealing = false;
+    // threads waiting for work while work stealing is enabled
+    QAtomicInt idleThreads;
+    QList<int> cpuAffinity;
+    bool numaAffinity = false;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,293 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qarenaallocator.h"
+#include "qarenaallocator_p.h"
+
+#include <stdlib.h>
+#if defined(Q_OS_WIN)
+#  include <malloc.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QArenaAllocator
+    \inmodule QtCore
+    \since 6.1
+    \brief The QArenaAllocator class provides a memory arena for the data of
+    Qt containers.
+
+    \reentrant
+
+    Code that builds many short-lived containers, such as the handling of a
+    single request in a server, spends a good part of its time allocating
+    and freeing their memory. A QArenaAllocator instead hands out memory
+    from large blocks by simply moving a pointer forward, and releases the
+    blocks all at once when it is destroyed.
+
+    An arena is used by making it current with a QArenaAllocator::Scope.
+    While the scope exists, the data of QList, QString, QByteArray and
+    QHash allocated in the same thread comes from the arena, as long as it
+    is small enough; larger blocks still come from the heap.
+
+    \snippet code/src_corelib_tools_qarenaallocator.cpp 0
+
+    Containers allocated from an arena are ordinary containers: they may be
+    copied, shared with other threads and kept after the scope ends. If any
+    of them outlives the arena, the block holding its data is only freed
+    when that container is. Memory that a container frees while the arena
+    exists is not reused until the arena is destroyed, so an arena is not
+    suited for code that keeps modifying the same containers for a long
+    time.
+
+    An arena may be current in only one thread at a time.
+*/
+
+/*!
+    \class QArenaAllocator::Scope
+    \inmodule QtCore
+    \since 6.1
+    \brief The Scope class makes a QArenaAllocator current in a block of
+    code.
+
+    A Scope makes its arena current in the thread that creates it, until it
+    is destroyed. Scopes may be nested; the innermost one wins. A Scope for
+    a \nullptr arena makes the allocations inside it come from the heap
+    again, which is useful for data that is known to be long-lived.
+*/
+
+QBasicAtomicInt QArenaAllocatorPrivate::activeScopes = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+static thread_local QArenaAllocator *currentArenaInThread = nullptr;
+
+static void *allocateAlignedBlock() noexcept
+{
+    const size_t size = QArenaAllocatorPrivate::BlockSize;
+#if defined(Q_OS_WIN)
+    return _aligned_malloc(size, size);
+#else
+    void *memory = nullptr;
+    if (posix_memalign(&memory, size, size) != 0)
+        return nullptr;
+    return memory;
+#endif
+}
+
+static void freeAlignedBlock(void *block) noexcept
+{
+#if defined(Q_OS_WIN)
+    _aligned_free(block);
+#else
+    ::free(block);
+#endif
+}
+
+namespace {
+// Aligned allocations of a block size are expensive (glibc serves them with
+// mmap()), and arenas are typically created and destroyed in a loop, so each
+// thread keeps a few free blocks around.
+struct BlockCache
+{
+    enum { MaxBlocks = 16 };
+    void *blocks[MaxBlocks];
+    int count = 0;
+
+    ~BlockCache()
+    {
+        while (count)
+            freeAlignedBlock(blocks[--count]);
+        destroyed = true;
+    }
+
+    static thread_local bool destroyed;
+};
+thread_local bool BlockCache::destroyed = false;
+}
+
+static thread_local BlockCache blockCache;
+
+static void *allocateBlock() noexcept
+{
+    if (!BlockCache::destroyed && blockCache.count)
+        return blockCache.blocks[--blockCache.count];
+    return allocateAlignedBlock();
+}
+
+static void freeBlock(void *block) noexcept
+{
+    if (!BlockCache::destroyed && blockCache.count < BlockCache::MaxBlocks)
+        blockCache.blocks[blockCache.count++] = block;
+    else
+        freeAlignedBlock(block);
+}
+
+QArenaAllocatorPrivate::~QArenaAllocatorPrivate()
+{
+    if (!blocks.empty())
+        retireBlock();
+    for (Block *block : blocks) {
+        if (!block->ref.deref())
+            freeBlock(block);
+    }
+}
+
+// replaces the bias in the reference count of the current block by the
+// number of allocations made from it, plus one for the arena
+void QArenaAllocatorPrivate::retireBlock() noexcept
+{
+    blocks.back()->ref.fetchAndAddRelaxed(allocationsInBlock + 1 - Block::Bias);
+    allocationsInBlock = 0;
+}
+
+QArenaAllocatorPrivate *QArenaAllocatorPrivate::currentArena() noexcept
+{
+    QArenaAllocator *arena = currentArenaInThread;
+    return arena ? arena->d_func() : nullptr;
+}
+
+bool QArenaAllocatorPrivate::addBlock() noexcept
+{
+    char *memory = static_cast<char *>(allocateBlock());
+    if (!memory)
+        return false;
+    if (!blocks.empty())
+        retireBlock();
+    Block *block = new (memory) Block;
+    block->ref.storeRelaxed(Block::Bias);
+    blocks.push_back(block);
+    cursor = memory + HeaderSize;
+    limit = memory + BlockSize;
+    return true;
+}
+
+void *QArenaAllocatorPrivate::allocate(size_t size, size_t alignment) noexcept
+{
+    Q_ASSERT(alignment && !(alignment & (alignment - 1)));
+    if (size > MaxAllocationSize || alignment > HeaderSize)
+        return nullptr;
+
+    char *ptr = reinterpret_cast<char *>((quintptr(cursor) + alignment - 1) & ~quintptr(alignment - 1));
+    if (!cursor || size > size_t(limit - ptr)) {
+        if (!addBlock())
+            return nullptr;
+        ptr = cursor;
+    }
+    cursor = ptr + size;
+    bytesAllocated += qsizetype(size);
+    ++allocationsInBlock;
+    return ptr;
+}
+
+void QArenaAllocatorPrivate::release(void *ptr) noexcept
+{
+    Block *block = reinterpret_cast<Block *>(quintptr(ptr) & ~quintptr(BlockSize - 1));
+    if (!block->ref.deref())
+        freeBlock(block);
+}
+
+/*!
+    Constructs an empty arena. It allocates no memory until it is used.
+*/
+QArenaAllocator::QArenaAllocator()
+    : d_ptr(new QArenaAllocatorPrivate)
+{
+}
+
+/*!
+    Destroys the arena, releasing all of its memory that is not used by
+    containers any more.
+
+    The arena must not be current in any thread.
+*/
+QArenaAllocator::~QArenaAllocator()
+{
+    Q_ASSERT_X(currentArenaInThread != this, "QArenaAllocator",
+               "Destroying an arena that is still current");
+    delete d_ptr;
+}
+
+/*!
+    Returns the number of bytes that were allocated from this arena.
+*/
+qsizetype QArenaAllocator::bytesAllocated() const noexcept
+{
+    Q_D(const QArenaAllocator);
+    return d->bytesAllocated;
+}
+
+/*!
+    Returns the number of memory blocks this arena has allocated so far.
+*/
+qsizetype QArenaAllocator::blockCount() const noexcept
+{
+    Q_D(const QArenaAllocator);
+    return qsizetype(d->blocks.size());
+}
+
+/*!
+    Returns the arena that is current in the calling thread, or \nullptr if
+    there is none.
+*/
+QArenaAllocator *QArenaAllocator::current() noexcept
+{
+    return currentArenaInThread;
+}
+
+/*!
+    Makes \a arena current in the calling thread, until this scope is
+    destroyed.
+*/
+QArenaAllocator::Scope::Scope(QArenaAllocator *arena) noexcept
+    : previous(currentArenaInThread)
+{
+    currentArenaInThread = arena;
+    QArenaAllocatorPrivate::activeScopes.ref();
+}
+
+/*!
+    Makes the arena that was current before this scope current again.
+*/
+QArenaAllocator::Scope::~Scope()
+{
+    currentArenaInThread = previous;
+    QArenaAllocatorPrivate::activeScopes.deref();
+}
+
+QT_END_NAMESPACE
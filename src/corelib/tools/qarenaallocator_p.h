@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QARENAALLOCATOR_P_H
+#define QARENAALLOCATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qarenaallocator.h>
+#include <QtCore/qatomic.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QArenaAllocatorPrivate
+{
+public:
+    enum : size_t {
+        // blocks are aligned to their size, so that any pointer into one
+        // leads to its header
+        BlockSize = 64 * 1024,
+        HeaderSize = 64,
+        // larger requests are better served by malloc()
+        MaxAllocationSize = BlockSize / 4
+    };
+
+    struct Block
+    {
+        // While the arena uses the block, ref starts at a bias larger than
+        // any number of allocations it can hold and only releases change it,
+        // so that allocating needs no atomic operation. When the arena is
+        // destroyed, it replaces the bias with the count of allocations it
+        // made, leaving the number of those still in use.
+        enum : int { Bias = 1 << 30 };
+        QAtomicInt ref;
+    };
+
+    ~QArenaAllocatorPrivate();
+
+    // returns nullptr if the request is too large for the arena
+    void *allocate(size_t size, size_t alignment) noexcept;
+    static void release(void *ptr) noexcept;
+
+    // the arena made current in this thread, if any
+    static QArenaAllocatorPrivate *current() noexcept
+    {
+        if (Q_LIKELY(!activeScopes.loadRelaxed()))
+            return nullptr;
+        return currentArena();
+    }
+
+    static QBasicAtomicInt activeScopes;
+
+    std::vector<Block *> blocks;
+    char *cursor = nullptr;
+    char *limit = nullptr;
+    int allocationsInBlock = 0;
+    qsizetype bytesAllocated = 0;
+
+private:
+    static QArenaAllocatorPrivate *currentArena() noexcept;
+    bool addBlock() noexcept;
+    void retireBlock() noexcept;
+};
+
+QT_END_NAMESPACE
+
+#endif // QARENAALLOCATOR_P_H
@@ -39,10 +39,12 @@
 ****************************************************************************/
 
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qarenaallocator_p.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 #include <QtCore/qmath.h>
 
+#include <stddef.h>
 #include <stdlib.h>
 
 QT_BEGIN_NAMESPACE
@@ -154,9 +156,36 @@ static inline qsizetype calculateBlockSize(qsizetype &capacity, qsizetype object
     }
 }
 
+// Set in QArrayData::flags for blocks that come from a QArenaAllocator, which
+// must be released to it instead of being passed to free(). Not part of
+// ArrayOptions, so that it never gets carried over to another block.
+static constexpr uint ArenaAllocated = 0x80000000;
+
+static void *allocateBlock(qsizetype allocSize, uint *options)
+{
+    *options &= ~ArenaAllocated;
+    if (QArenaAllocatorPrivate *arena = QArenaAllocatorPrivate::current()) {
+        if (allocSize >= 0) {
+            if (void *block = arena->allocate(size_t(allocSize), alignof(std::max_align_t))) {
+                *options |= ArenaAllocated;
+                return block;
+            }
+        }
+    }
+    return ::malloc(size_t(allocSize));
+}
+
+static void freeBlock(QArrayData *data) noexcept
+{
+    if (data && (data->flags & ArenaAllocated))
+        QArenaAllocatorPrivate::release(data);
+    else
+        ::free(data);
+}
+
 static QArrayData *allocateData(qsizetype allocSize, uint options)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    QArrayData *header = static_cast<QArrayData *>(allocateBlock(allocSize, &options));
     if (header) {
         header->ref_.storeRelaxed(1);
         header->flags = options;
@@ -212,9 +241,24 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     qsizetype headerSize = sizeof(QArrayData);
     qsizetype allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
     qptrdiff offset = dataPointer ? reinterpret_cast<char *>(dataPointer) - reinterpret_cast<char *>(data) : headerSize;
-    QArrayData *header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    uint flags = options;
+    QArrayData *header;
+    if (data && !(data->flags & ArenaAllocated)) {
+        header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+        flags &= ~ArenaAllocated;
+    } else {
+        // arena blocks can't grow in place, so move to a new block
+        header = static_cast<QArrayData *>(allocateBlock(allocSize, &flags));
+        if (header && data) {
+            const qsizetype oldSize = offset + data->alloc * objectSize;
+            ::memcpy(static_cast<void *>(header), data, size_t(qMin(oldSize, allocSize)));
+            freeBlock(data);
+        } else if (header) {
+            header->ref_.storeRelaxed(1);
+        }
+    }
     if (header) {
-        header->flags = options;
+        header->flags = flags;
         header->alloc = uint(capacity);
         dataPointer = reinterpret_cast<char *>(header) + offset;
     }
@@ -230,7 +274,7 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
-    ::free(data);
+    freeBlock(data);
 }
 
 QT_END_NAMESPACE
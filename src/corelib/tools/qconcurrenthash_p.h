@@ -0,0 +1,465 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTHASH_P_H
+#define QCONCURRENTHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qmutex.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QConcurrentHash is a hash table that may be used from several threads at
+  once without external locking.
+
+  The table is split into shards, chosen by the high bits of the hash of a
+  key. Each shard is an open-addressed table of pointers to immutable
+  nodes. Writers to a shard serialize on its mutex and publish their
+  changes by atomically replacing node pointers (or the whole table, when
+  it grows), so readers never block: they only announce themselves in the
+  reader counts of the shard, so that writers know when it is safe to free
+  the nodes and tables they unlinked.
+
+  As the nodes are shared with concurrent readers, lookups return copies
+  of the values. snapshot() copies each shard atomically, but the shards
+  one after the other.
+*/
+
+namespace QConcurrentHashPrivate {
+
+// the readers of a shard, counted in two halves that writers flip between,
+// so that waiting for the current readers isn't starved by new ones
+class ReaderTracker
+{
+public:
+    uint lock() noexcept
+    {
+        const uint index = epoch.load() & 1;
+        readers[index].fetch_add(1);
+        return index;
+    }
+
+    void unlock(uint index) noexcept
+    {
+        readers[index].fetch_sub(1, std::memory_order_release);
+    }
+
+    // waits until every reader that may have seen memory unlinked before
+    // this call is done with it
+    void synchronize() noexcept
+    {
+        for (int i = 0; i < 2; ++i) {
+            const uint index = epoch.fetch_add(1) & 1;
+            while (readers[index].load() != 0)
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    std::atomic<uint> epoch = { 0 };
+    std::atomic<int> readers[2] = { { 0 }, { 0 } };
+};
+
+class ReadLocker
+{
+public:
+    explicit ReadLocker(ReaderTracker &tracker) noexcept
+        : tracker(tracker), index(tracker.lock())
+    {
+    }
+    ~ReadLocker() { tracker.unlock(index); }
+
+private:
+    Q_DISABLE_COPY_MOVE(ReadLocker)
+    ReaderTracker &tracker;
+    uint index;
+};
+
+template <typename Key, typename T>
+struct Node
+{
+    size_t hash;
+    Key key;
+    T value;
+};
+
+template <typename Node>
+struct Table
+{
+    size_t mask;
+    std::unique_ptr<std::atomic<Node *>[]> buckets;
+
+    explicit Table(size_t capacity)
+        : mask(capacity - 1), buckets(new std::atomic<Node *>[capacity])
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const noexcept { return mask + 1; }
+
+    // marks a bucket whose node was removed, so that lookups go on probing
+    static Node *deleted() noexcept { return reinterpret_cast<Node *>(quintptr(1)); }
+
+    static bool isNode(const Node *n) noexcept { return n && n != deleted(); }
+};
+
+} // namespace QConcurrentHashPrivate
+
+template <typename Key, typename T>
+class QConcurrentHash
+{
+    using Node = QConcurrentHashPrivate::Node<Key, T>;
+    using Table = QConcurrentHashPrivate::Table<Node>;
+    using ReadLocker = QConcurrentHashPrivate::ReadLocker;
+
+    enum { DefaultShardCount = 64, MinimumCapacity = 16 };
+
+    struct alignas(64) Shard
+    {
+        QBasicMutex mutex;
+        QConcurrentHashPrivate::ReaderTracker readers;
+        std::atomic<Table *> table = { nullptr };
+        std::atomic<qsizetype> size = { 0 };
+
+        // the following are only used with the mutex locked
+        size_t used = 0; // nodes and deleted buckets
+        std::vector<Node *> retiredNodes;
+        std::vector<Table *> retiredTables;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    explicit QConcurrentHash(int shardCountHint = DefaultShardCount)
+        : shardCount(qNextPowerOfTwo(quint32(qMax(shardCountHint, 1) - 1))),
+          shardShift(std::numeric_limits<size_t>::digits - qCountTrailingZeroBits(shardCount)),
+          shards(new Shard[shardCount]),
+          seed(size_t(qGlobalQHashSeed()))
+    {
+    }
+
+    ~QConcurrentHash()
+    {
+        for (size_t i = 0; i < shardCount; ++i) {
+            Shard &shard = shards[i];
+            freeTable(shard.table.load(std::memory_order_relaxed), true);
+            reclaim(shard);
+        }
+    }
+
+    // returns whether the key was new
+    bool insert(const Key &key, const T &value)
+    {
+        return insertImpl(key, value, true);
+    }
+
+    // inserts only if the key isn't there yet, returns whether it wasn't
+    bool tryInsert(const Key &key, const T &value)
+    {
+        return insertImpl(key, value, false);
+    }
+
+    bool remove(const Key &key)
+    {
+        return takeImpl(key, nullptr);
+    }
+
+    T take(const Key &key)
+    {
+        T value = T();
+        takeImpl(key, &value);
+        return value;
+    }
+
+    bool contains(const Key &key) const
+    {
+        const size_t hash = qHash(key, seed);
+        Shard &shard = shardFor(hash);
+        ReadLocker locker(shard.readers);
+        return findNode(shard, key, hash) != nullptr;
+    }
+
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const size_t hash = qHash(key, seed);
+        Shard &shard = shardFor(hash);
+        ReadLocker locker(shard.readers);
+        const Node *n = findNode(shard, key, hash);
+        return n ? n->value : defaultValue;
+    }
+
+    // the number of entries; only a hint while other threads modify the hash
+    qsizetype size() const noexcept
+    {
+        qsizetype result = 0;
+        for (size_t i = 0; i < shardCount; ++i)
+            result += shards[i].size.load(std::memory_order_relaxed);
+        return result;
+    }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    void clear()
+    {
+        for (size_t i = 0; i < shardCount; ++i) {
+            Shard &shard = shards[i];
+            QMutexLocker locker(&shard.mutex);
+            if (Table *t = shard.table.exchange(nullptr)) {
+                for (size_t b = 0; b < t->capacity(); ++b) {
+                    Node *n = t->buckets[b].load(std::memory_order_relaxed);
+                    if (Table::isNode(n))
+                        shard.retiredNodes.push_back(n);
+                }
+                shard.retiredTables.push_back(t);
+            }
+            shard.size.store(0, std::memory_order_relaxed);
+            shard.used = 0;
+            shard.readers.synchronize();
+            reclaim(shard);
+        }
+    }
+
+    QHash<Key, T> snapshot() const
+    {
+        QHash<Key, T> result;
+        result.reserve(size());
+        for (size_t i = 0; i < shardCount; ++i) {
+            Shard &shard = shards[i];
+            ReadLocker locker(shard.readers);
+            const Table *t = shard.table.load();
+            if (!t)
+                continue;
+            for (size_t b = 0; b < t->capacity(); ++b) {
+                const Node *n = t->buckets[b].load();
+                if (Table::isNode(n))
+                    result.insert(n->key, n->value);
+            }
+        }
+        return result;
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentHash)
+
+    // unlinked nodes and tables are freed in batches, as that needs
+    // waiting for the readers
+    enum { ReclaimThreshold = 32 };
+
+    Shard &shardFor(size_t hash) const noexcept
+    {
+        return shards[shardShift < size_t(std::numeric_limits<size_t>::digits) ? hash >> shardShift : 0];
+    }
+
+    static const Node *findNode(const Shard &shard, const Key &key, size_t hash) noexcept
+    {
+        const Table *t = shard.table.load();
+        if (!t)
+            return nullptr;
+        for (size_t i = hash & t->mask; ; i = (i + 1) & t->mask) {
+            // not just acquire: writers must see us read after registering
+            const Node *n = t->buckets[i].load();
+            if (!n)
+                return nullptr;
+            if (n != Table::deleted() && n->hash == hash && n->key == key)
+                return n;
+        }
+    }
+
+    // returns the bucket of key, or the first free one on its probe sequence
+    static size_t findBucket(const Table *t, const Key &key, size_t hash, bool *found) noexcept
+    {
+        size_t free = t->capacity();
+        for (size_t i = hash & t->mask; ; i = (i + 1) & t->mask) {
+            const Node *n = t->buckets[i].load(std::memory_order_relaxed);
+            if (!n) {
+                *found = false;
+                return free < t->capacity() ? free : i;
+            }
+            if (n == Table::deleted()) {
+                if (free == t->capacity())
+                    free = i;
+            } else if (n->hash == hash && n->key == key) {
+                *found = true;
+                return i;
+            }
+        }
+    }
+
+    bool insertImpl(const Key &key, const T &value, bool replace)
+    {
+        const size_t hash = qHash(key, seed);
+        Shard &shard = shardFor(hash);
+        QMutexLocker locker(&shard.mutex);
+
+        Table *t = shard.table.load(std::memory_order_relaxed);
+        // keep at least a quarter of the buckets empty, so that probing is short
+        if (!t || (shard.used + 1) * 4 > t->capacity() * 3)
+            t = rehash(shard);
+
+        bool found;
+        const size_t index = findBucket(t, key, hash, &found);
+        std::atomic<Node *> &bucket = t->buckets[index];
+        if (found) {
+            if (!replace)
+                return false;
+            Node *old = bucket.load(std::memory_order_relaxed);
+            bucket.store(new Node{ hash, key, value });
+            shard.retiredNodes.push_back(old);
+            maybeReclaim(shard);
+            return false;
+        }
+
+        if (!bucket.load(std::memory_order_relaxed))
+            ++shard.used;
+        bucket.store(new Node{ hash, key, value }, std::memory_order_release);
+        shard.size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool takeImpl(const Key &key, T *value)
+    {
+        const size_t hash = qHash(key, seed);
+        Shard &shard = shardFor(hash);
+        QMutexLocker locker(&shard.mutex);
+
+        Table *t = shard.table.load(std::memory_order_relaxed);
+        if (!t)
+            return false;
+        bool found;
+        const size_t index = findBucket(t, key, hash, &found);
+        if (!found)
+            return false;
+
+        Node *old = t->buckets[index].exchange(Table::deleted());
+        if (value)
+            *value = old->value;
+        shard.size.fetch_sub(1, std::memory_order_relaxed);
+        shard.retiredNodes.push_back(old);
+        maybeReclaim(shard);
+        return true;
+    }
+
+    // replaces the table of shard by one sized for its current contents
+    Table *rehash(Shard &shard)
+    {
+        Table *old = shard.table.load(std::memory_order_relaxed);
+        const size_t size = size_t(shard.size.load(std::memory_order_relaxed));
+        Table *t = new Table(qMax(size_t(MinimumCapacity), size_t(qNextPowerOfTwo(quint64(size * 2)))));
+        if (old) {
+            for (size_t b = 0; b < old->capacity(); ++b) {
+                Node *n = old->buckets[b].load(std::memory_order_relaxed);
+                if (!Table::isNode(n))
+                    continue;
+                size_t i = n->hash & t->mask;
+                while (t->buckets[i].load(std::memory_order_relaxed))
+                    i = (i + 1) & t->mask;
+                t->buckets[i].store(n, std::memory_order_relaxed);
+            }
+        }
+        shard.table.store(t);
+        shard.used = size;
+        if (old) {
+            shard.retiredTables.push_back(old);
+            maybeReclaim(shard);
+        }
+        return t;
+    }
+
+    static void maybeReclaim(Shard &shard)
+    {
+        if (shard.retiredNodes.size() < ReclaimThreshold && shard.retiredTables.empty())
+            return;
+        shard.readers.synchronize();
+        reclaim(shard);
+    }
+
+    static void reclaim(Shard &shard)
+    {
+        for (Node *n : shard.retiredNodes)
+            delete n;
+        shard.retiredNodes.clear();
+        for (Table *t : shard.retiredTables)
+            freeTable(t, false);
+        shard.retiredTables.clear();
+    }
+
+    static void freeTable(Table *t, bool withNodes)
+    {
+        if (t && withNodes) {
+            for (size_t b = 0; b < t->capacity(); ++b) {
+                Node *n = t->buckets[b].load(std::memory_order_relaxed);
+                if (Table::isNode(n))
+                    delete n;
+            }
+        }
+        delete t;
+    }
+
+    const size_t shardCount;
+    const size_t shardShift;
+    const std::unique_ptr<Shard[]> shards;
+    const size_t seed;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTHASH_P_H
@@ -0,0 +1,794 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_P_H
+#define QFLATHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qiterator.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrefcount.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__ARM_NEON__) && !defined(__SSE2__)
+#include <arm_neon.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QFlatHash is a hash table with the API of QHash, using open addressing
+  in the style of Abseil's SwissTable.
+
+  The slots are organized in groups of 16. Each slot has a control byte,
+  holding either 7 bits of the hash of its key, or a marker for an empty
+  or deleted slot. The control bytes of a group are stored together, so
+  that a lookup compares them all at once (with SSE2 or NEON, when
+  available) and only compares the keys whose bits match. Unlike QHash,
+  the keys and values are stored in the table itself, so a successful
+  lookup usually touches just two cache lines.
+
+  Like QHash, QFlatHash uses qHash() and is implicitly shared. Iterators
+  and references are invalidated by any insertion into the hash, but not
+  by removals. As opposed to QHash, the hash never shrinks on its own;
+  call squeeze() for that.
+*/
+
+namespace QFlatHashPrivate {
+
+enum : quint8 {
+    // full slots have the top 7 bits of the hash, with the high bit cleared
+    EmptyControl = 0x80,
+    DeletedControl = 0xfe
+};
+
+enum : size_t { GroupSize = 16 };
+
+// a set of slots of a group, iterated from the lowest
+class BitMask
+{
+public:
+#if defined(__SSE2__) || !defined(__ARM_NEON__)
+    // one bit per slot
+    enum { Shift = 0 };
+    using Mask = quint32;
+#else
+    // four bits per slot, of which we keep the highest
+    enum { Shift = 2 };
+    using Mask = quint64;
+#endif
+
+    explicit BitMask(Mask mask) noexcept : mask(mask) { }
+
+    explicit operator bool() const noexcept { return mask != 0; }
+    uint lowest() const noexcept { return qCountTrailingZeroBits(mask) >> Shift; }
+    void removeLowest() noexcept { mask &= mask - 1; }
+
+private:
+    Mask mask;
+};
+
+class Group
+{
+public:
+    explicit Group(const quint8 *control) noexcept
+    {
+#if defined(__SSE2__)
+        bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(control));
+#elif defined(__ARM_NEON__)
+        bytes = vld1q_u8(control);
+#else
+        memcpy(bytes, control, GroupSize);
+#endif
+    }
+
+    BitMask match(quint8 h2) const noexcept
+    {
+#if defined(__SSE2__)
+        return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(char(h2)), bytes)));
+#elif defined(__ARM_NEON__)
+        return BitMask(toMask(vceqq_u8(bytes, vdupq_n_u8(h2))));
+#else
+        return matchIf([h2](quint8 c) { return c == h2; });
+#endif
+    }
+
+    BitMask matchEmpty() const noexcept
+    {
+#if defined(__SSE2__)
+        return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(char(EmptyControl)), bytes)));
+#elif defined(__ARM_NEON__)
+        return BitMask(toMask(vceqq_u8(bytes, vdupq_n_u8(EmptyControl))));
+#else
+        return matchIf([](quint8 c) { return c == EmptyControl; });
+#endif
+    }
+
+    BitMask matchEmptyOrDeleted() const noexcept
+    {
+        // only these have the high bit set
+#if defined(__SSE2__)
+        return BitMask(_mm_movemask_epi8(bytes));
+#elif defined(__ARM_NEON__)
+        return BitMask(toMask(vcltq_s8(vreinterpretq_s8_u8(bytes), vdupq_n_s8(0))));
+#else
+        return matchIf([](quint8 c) { return c & 0x80; });
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i bytes;
+#elif defined(__ARM_NEON__)
+    static quint64 toMask(uint8x16_t matches) noexcept
+    {
+        // narrow each 0xff or 0x00 byte to a nibble
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & Q_UINT64_C(0x8888888888888888);
+    }
+    uint8x16_t bytes;
+#else
+    template <typename Predicate>
+    BitMask matchIf(Predicate predicate) const noexcept
+    {
+        BitMask::Mask mask = 0;
+        for (size_t i = 0; i < GroupSize; ++i) {
+            if (predicate(bytes[i]))
+                mask |= BitMask::Mask(1) << i;
+        }
+        return BitMask(mask);
+    }
+    quint8 bytes[GroupSize];
+#endif
+};
+
+template <typename Key, typename T>
+struct Node
+{
+    Key key;
+    T value;
+};
+
+template <typename Node>
+struct Data
+{
+    QtPrivate::RefCount ref = {{1}};
+    size_t size = 0;
+    size_t numGroups = 0;   // a power of two
+    size_t growthLeft = 0;  // empty slots we may still fill before growing
+    size_t seed = 0;
+    quint8 *control = nullptr;
+    Node *entries = nullptr;
+
+    static_assert(alignof(Node) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "QFlatHash doesn't support over-aligned keys or values");
+
+    size_t capacity() const noexcept { return numGroups * GroupSize; }
+
+    // at most 7/8 of the slots are used, so that there are always empty ones
+    static size_t maxSizeFor(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+    static size_t groupsFor(size_t size) noexcept
+    {
+        size_t groups = 1;
+        while (maxSizeFor(groups * GroupSize) < size)
+            groups *= 2;
+        return groups;
+    }
+
+    static quint8 h2(size_t hash) noexcept { return quint8(hash >> (sizeof(size_t) * 8 - 7)); }
+
+    bool isFull(size_t index) const noexcept { return !(control[index] & 0x80); }
+
+    explicit Data(size_t numGroups, size_t seed)
+        : seed(seed)
+    {
+        allocate(numGroups);
+    }
+
+    Data(const Data &other)
+        : seed(other.seed)
+    {
+        allocate(other.numGroups);
+        memcpy(control, other.control, capacity());
+        size = other.size;
+        growthLeft = other.growthLeft;
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (isFull(i))
+                new (entries + i) Node(other.entries[i]);
+        }
+    }
+
+    ~Data()
+    {
+        destroySlots();
+        ::operator delete(control);
+    }
+
+    void allocate(size_t groups)
+    {
+        numGroups = groups;
+        const size_t slotsOffset = (capacity() + alignof(Node) - 1) & ~(alignof(Node) - 1);
+        void *memory = ::operator new(slotsOffset + capacity() * sizeof(Node));
+        control = static_cast<quint8 *>(memory);
+        entries = reinterpret_cast<Node *>(control + slotsOffset);
+        memset(control, EmptyControl, capacity());
+        growthLeft = maxSizeFor(capacity());
+    }
+
+    void destroySlots() noexcept
+    {
+        if (!std::is_trivially_destructible<Node>::value) {
+            for (size_t i = 0; i < capacity(); ++i) {
+                if (isFull(i))
+                    entries[i].~Node();
+            }
+        }
+    }
+
+    void clear() noexcept
+    {
+        destroySlots();
+        memset(control, EmptyControl, capacity());
+        size = 0;
+        growthLeft = maxSizeFor(capacity());
+    }
+
+    // the groups to look at for a hash: triangular probing visits them all
+    struct Probe
+    {
+        size_t group;
+        size_t mask;
+        size_t step = 0;
+        Probe(size_t hash, size_t numGroups) noexcept
+            : group(hash & (numGroups - 1)), mask(numGroups - 1) { }
+        void next() noexcept { group = (group + ++step) & mask; }
+    };
+
+    template <typename K>
+    size_t findIndex(const K &key, size_t hash) const noexcept
+    {
+        const quint8 h2 = Data::h2(hash);
+        for (Probe probe(hash, numGroups); ; probe.next()) {
+            const size_t first = probe.group * GroupSize;
+            const Group group(control + first);
+            for (BitMask matches = group.match(h2); matches; matches.removeLowest()) {
+                const size_t index = first + matches.lowest();
+                if (entries[index].key == key)
+                    return index;
+            }
+            // the key would have been put in an empty slot of this group
+            if (group.matchEmpty())
+                return capacity();
+        }
+    }
+
+    size_t findInsertIndex(size_t hash) const noexcept
+    {
+        for (Probe probe(hash, numGroups); ; probe.next()) {
+            const size_t first = probe.group * GroupSize;
+            if (BitMask free = Group(control + first).matchEmptyOrDeleted())
+                return first + free.lowest();
+        }
+    }
+
+    // returns the index of a new slot for a key with \a hash, which the
+    // caller must construct
+    size_t insertSlot(size_t hash)
+    {
+        size_t index = findInsertIndex(hash);
+        if (control[index] == EmptyControl && growthLeft == 0) {
+            // clean up the deleted slots if there are many, grow otherwise
+            rehash(size < capacity() / 2 ? numGroups : numGroups * 2);
+            index = findInsertIndex(hash);
+        }
+        if (control[index] == EmptyControl)
+            --growthLeft;
+        control[index] = h2(hash);
+        ++size;
+        return index;
+    }
+
+    void erase(size_t index) noexcept
+    {
+        Q_ASSERT(isFull(index));
+        entries[index].~Node();
+        --size;
+        // lookups stop at a group with an empty slot, so if this one has
+        // none, no key in another group may stop here either
+        if (Group(control + index / GroupSize * GroupSize).matchEmpty()) {
+            control[index] = EmptyControl;
+            ++growthLeft;
+        } else {
+            control[index] = DeletedControl;
+        }
+    }
+
+    void rehash(size_t groups)
+    {
+        quint8 *oldControl = control;
+        Node *oldSlots = entries;
+        const size_t oldCapacity = capacity();
+
+        allocate(groups);
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldControl[i] & 0x80)
+                continue;
+            Node &node = oldSlots[i];
+            const size_t hash = qHash(node.key, seed);
+            const size_t index = findInsertIndex(hash);
+            control[index] = h2(hash);
+            new (entries + index) Node(std::move(node));
+            node.~Node();
+        }
+        growthLeft -= size;
+        ::operator delete(oldControl);
+    }
+
+    size_t nextFull(size_t index) const noexcept
+    {
+        while (index < capacity() && !isFull(index))
+            ++index;
+        return index;
+    }
+};
+
+} // namespace QFlatHashPrivate
+
+template <typename Key, typename T>
+class QFlatHash
+{
+    using Node = QFlatHashPrivate::Node<Key, T>;
+    using Data = QFlatHashPrivate::Data<Node>;
+
+    Data *d = nullptr;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = T;
+    using size_type = qsizetype;
+    using difference_type = qsizetype;
+    using reference = T &;
+    using const_reference = const T &;
+
+    QFlatHash() noexcept = default;
+    inline QFlatHash(std::initializer_list<std::pair<Key, T>> list)
+    {
+        reserve(qsizetype(list.size()));
+        for (auto it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+    QFlatHash(const QFlatHash &other) noexcept
+        : d(other.d)
+    {
+        if (d)
+            d->ref.ref();
+    }
+    ~QFlatHash()
+    {
+        if (d && !d->ref.deref())
+            delete d;
+    }
+    QFlatHash &operator=(const QFlatHash &other) noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d != other.d) {
+            Data *o = other.d;
+            if (o)
+                o->ref.ref();
+            if (d && !d->ref.deref())
+                delete d;
+            d = o;
+        }
+        return *this;
+    }
+    QFlatHash(QFlatHash &&other) noexcept
+        : d(std::exchange(other.d, nullptr))
+    {
+    }
+    QFlatHash &operator=(QFlatHash &&other) noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d != other.d) {
+            if (d && !d->ref.deref())
+                delete d;
+            d = std::exchange(other.d, nullptr);
+        }
+        return *this;
+    }
+    void swap(QFlatHash &other) noexcept { qSwap(d, other.d); }
+
+    bool operator==(const QFlatHash &other) const noexcept
+    {
+        if (d == other.d)
+            return true;
+        if (size() != other.size())
+            return false;
+        for (const_iterator it = begin(); it != end(); ++it) {
+            const_iterator i = other.find(it.key());
+            if (i == other.end() || !(i.value() == it.value()))
+                return false;
+        }
+        return true;
+    }
+    bool operator!=(const QFlatHash &other) const noexcept { return !(*this == other); }
+
+    inline qsizetype size() const noexcept { return d ? qsizetype(d->size) : 0; }
+    inline qsizetype count() const noexcept { return size(); }
+    inline bool isEmpty() const noexcept { return !d || d->size == 0; }
+    inline qsizetype capacity() const noexcept { return d ? qsizetype(d->capacity()) : 0; }
+
+    void reserve(qsizetype size)
+    {
+        const size_t groups = Data::groupsFor(size_t(qMax(size, this->size())));
+        if (isDetached() && d && d->numGroups >= groups)
+            return;
+        if (!d)
+            d = new Data(groups, size_t(qGlobalQHashSeed()));
+        else if (isDetached())
+            d->rehash(groups);
+        else
+            reallocate(groups);
+    }
+    inline void squeeze()
+    {
+        if (!d)
+            return;
+        if (d->size == 0) {
+            clear();
+            return;
+        }
+        const size_t groups = Data::groupsFor(d->size);
+        if (isDetached())
+            d->rehash(groups);
+        else
+            reallocate(groups);
+    }
+
+    inline void detach()
+    {
+        if (!d)
+            d = new Data(1, size_t(qGlobalQHashSeed()));
+        else if (d->ref.isShared())
+            reallocate(0);
+    }
+    inline bool isDetached() const noexcept { return d && !d->ref.isShared(); }
+    bool isSharedWith(const QFlatHash &other) const noexcept { return d == other.d; }
+
+    void clear() noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (isDetached())
+            d->clear();
+        else
+            QFlatHash().swap(*this);
+    }
+
+    bool remove(const Key &key)
+    {
+        if (isEmpty())
+            return false;
+        const size_t index = d->findIndex(key, qHash(key, d->seed));
+        if (index == d->capacity())
+            return false;
+        detach();
+        d->erase(index);
+        return true;
+    }
+    T take(const Key &key)
+    {
+        if (isEmpty())
+            return T();
+        const size_t index = d->findIndex(key, qHash(key, d->seed));
+        if (index == d->capacity())
+            return T();
+        detach();
+        T value = std::move(d->entries[index].value);
+        d->erase(index);
+        return value;
+    }
+
+    bool contains(const Key &key) const noexcept
+    {
+        return !isEmpty() && d->findIndex(key, qHash(key, d->seed)) != d->capacity();
+    }
+    qsizetype count(const Key &key) const noexcept { return contains(key) ? 1 : 0; }
+
+    Key key(const T &value, const Key &defaultKey = Key()) const noexcept
+    {
+        for (const_iterator it = begin(); it != end(); ++it) {
+            if (it.value() == value)
+                return it.key();
+        }
+        return defaultKey;
+    }
+    T value(const Key &key) const noexcept
+    {
+        return value(key, T());
+    }
+    T value(const Key &key, const T &defaultValue) const noexcept
+    {
+        if (const T *v = valueImpl(key))
+            return *v;
+        return defaultValue;
+    }
+    T &operator[](const Key &key)
+    {
+        return *tryEmplace(key).value;
+    }
+    const T operator[](const Key &key) const noexcept
+    {
+        return value(key);
+    }
+
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(size());
+        for (const_iterator it = begin(); it != end(); ++it)
+            result.append(it.key());
+        return result;
+    }
+    QList<T> values() const
+    {
+        QList<T> result;
+        result.reserve(size());
+        for (const_iterator it = begin(); it != end(); ++it)
+            result.append(it.value());
+        return result;
+    }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatHash;
+        friend class const_iterator;
+        Data *d = nullptr;
+        size_t index = 0;
+        iterator(Data *d, size_t index) noexcept : d(d), index(index) { }
+
+    public:
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr iterator() noexcept = default;
+
+        inline const Key &key() const noexcept { return d->entries[index].key; }
+        inline T &value() const noexcept { return d->entries[index].value; }
+        inline T &operator*() const noexcept { return value(); }
+        inline T *operator->() const noexcept { return &value(); }
+        inline bool operator==(const iterator &o) const noexcept { return index == o.index; }
+        inline bool operator!=(const iterator &o) const noexcept { return index != o.index; }
+        inline iterator &operator++() noexcept
+        {
+            index = d->nextFull(index + 1);
+            return *this;
+        }
+        inline iterator operator++(int) noexcept
+        {
+            iterator r = *this;
+            ++(*this);
+            return r;
+        }
+        inline bool operator==(const const_iterator &o) const noexcept { return index == o.index; }
+        inline bool operator!=(const const_iterator &o) const noexcept { return index != o.index; }
+    };
+
+    class const_iterator
+    {
+        friend class QFlatHash;
+        friend class iterator;
+        const Data *d = nullptr;
+        size_t index = 0;
+        const_iterator(const Data *d, size_t index) noexcept : d(d), index(index) { }
+
+    public:
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = const T *;
+        using reference = const T &;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr const_iterator() noexcept = default;
+        inline const_iterator(const iterator &o) noexcept : d(o.d), index(o.index) { }
+
+        inline const Key &key() const noexcept { return d->entries[index].key; }
+        inline const T &value() const noexcept { return d->entries[index].value; }
+        inline const T &operator*() const noexcept { return value(); }
+        inline const T *operator->() const noexcept { return &value(); }
+        inline bool operator==(const const_iterator &o) const noexcept { return index == o.index; }
+        inline bool operator!=(const const_iterator &o) const noexcept { return index != o.index; }
+        inline const_iterator &operator++() noexcept
+        {
+            index = d->nextFull(index + 1);
+            return *this;
+        }
+        inline const_iterator operator++(int) noexcept
+        {
+            const_iterator r = *this;
+            ++(*this);
+            return r;
+        }
+    };
+
+    // STL style
+    inline iterator begin()
+    {
+        if (!d)
+            return iterator();
+        detach();
+        return iterator(d, d->nextFull(0));
+    }
+    inline const_iterator begin() const noexcept { return constBegin(); }
+    inline const_iterator cbegin() const noexcept { return constBegin(); }
+    inline const_iterator constBegin() const noexcept
+    {
+        return d ? const_iterator(d, d->nextFull(0)) : const_iterator();
+    }
+    inline iterator end() noexcept { return iterator(d, d ? d->capacity() : 0); }
+    inline const_iterator end() const noexcept { return constEnd(); }
+    inline const_iterator cend() const noexcept { return constEnd(); }
+    inline const_iterator constEnd() const noexcept
+    {
+        return const_iterator(d, d ? d->capacity() : 0);
+    }
+
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it.d == d && d->isFull(it.index));
+        Q_ASSERT(isDetached());
+        d->erase(it.index);
+        return iterator(d, d->nextFull(it.index + 1));
+    }
+
+    iterator find(const Key &key)
+    {
+        if (isEmpty())
+            return end();
+        const size_t hash = qHash(key, d->seed);
+        size_t index = d->findIndex(key, hash);
+        if (index == d->capacity())
+            return end();
+        detach();
+        return iterator(d, index);
+    }
+    const_iterator find(const Key &key) const noexcept
+    {
+        return constFind(key);
+    }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        if (isEmpty())
+            return constEnd();
+        return const_iterator(d, d->findIndex(key, qHash(key, d->seed)));
+    }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        return emplace(key, value);
+    }
+
+    template <typename ...Args>
+    iterator emplace(const Key &key, Args &&... args)
+    {
+        Key copy = key; // key may be in our own storage
+        return emplace(std::move(copy), std::forward<Args>(args)...);
+    }
+
+    template <typename ...Args>
+    iterator emplace(Key &&key, Args &&... args)
+    {
+        Emplaced result = tryEmplace(std::move(key));
+        *result.value = T(std::forward<Args>(args)...);
+        return iterator(d, result.index);
+    }
+
+private:
+    struct Emplaced
+    {
+        size_t index;
+        T *value;
+    };
+
+    // returns the value for key, inserting a default constructed one if needed
+    template <typename K>
+    Emplaced tryEmplace(K &&key)
+    {
+        detach();
+        const size_t hash = qHash(key, d->seed);
+        size_t index = d->findIndex(key, hash);
+        if (index == d->capacity()) {
+            index = d->insertSlot(hash);
+            new (d->entries + index) Node{ Key(std::forward<K>(key)), T() };
+        }
+        return { index, &d->entries[index].value };
+    }
+
+    const T *valueImpl(const Key &key) const noexcept
+    {
+        if (isEmpty())
+            return nullptr;
+        const size_t index = d->findIndex(key, qHash(key, d->seed));
+        return index == d->capacity() ? nullptr : &d->entries[index].value;
+    }
+
+    // detaches into a table with \a groups groups, or as many as now if 0
+    void reallocate(size_t groups)
+    {
+        Data *dd;
+        if (groups == 0 || groups == d->numGroups) {
+            dd = new Data(*d);
+        } else {
+            dd = new Data(groups, d->seed);
+            for (const_iterator it = constBegin(); it != constEnd(); ++it) {
+                const size_t hash = qHash(it.key(), dd->seed);
+                const size_t index = dd->insertSlot(hash);
+                new (dd->entries + index) Node{ it.key(), it.value() };
+            }
+        }
+        if (!d->ref.deref())
+            delete d;
+        d = dd;
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_P_H
@@ -60,6 +60,7 @@
 #include <qdatetime.h>
 #include <qbasicatomic.h>
 #include <qendian.h>
+#include <private/qarenaallocator_p.h>
 #include <private/qsimd_p.h>
 
 #ifndef QT_BOOTSTRAPPED
@@ -3331,4 +3332,28 @@ size_t qHash(long double key, size_t seed) noexcept
     Type \c T must be supported by qHash().
 */
 
+/*!
+    \internal
+
+    Returns \a size bytes for the entries of a span from the QArenaAllocator
+    that is current in this thread, or \nullptr if there is none or it can't
+    provide the memory.
+*/
+void *QHashPrivate::allocateSpanStorage(size_t size) noexcept
+{
+    if (QArenaAllocatorPrivate *arena = QArenaAllocatorPrivate::current())
+        return arena->allocate(size, alignof(std::max_align_t));
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Releases \a storage returned by allocateSpanStorage().
+*/
+void QHashPrivate::freeSpanStorage(void *storage) noexcept
+{
+    QArenaAllocatorPrivate::release(storage);
+}
+
 QT_END_NAMESPACE
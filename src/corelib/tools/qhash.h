@@ -229,6 +229,11 @@ struct MultiNode
     // compiler generated move operators are fine
 };
 
+// Storage for the entries of spans comes from the current QArenaAllocator,
+// if there is one. allocateSpanStorage() returns nullptr otherwise.
+Q_CORE_EXPORT void *allocateSpanStorage(size_t size) noexcept;
+Q_CORE_EXPORT void freeSpanStorage(void *storage) noexcept;
+
 template<typename  Node>
 constexpr bool isRelocatable()
 {
@@ -269,6 +274,7 @@ struct Span {
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
+    bool arenaStorage = false;
     Span() noexcept
     {
         memset(offsets, UnusedEntry, sizeof(offsets));
@@ -286,10 +292,28 @@ struct Span {
                         entries[o].node().~Node();
                 }
             }
-            delete [] entries;
+            freeEntries(entries, arenaStorage);
             entries = nullptr;
         }
     }
+    static Entry *allocateEntries(size_t count, bool *fromArena)
+    {
+        if constexpr (alignof(Entry) <= alignof(std::max_align_t)) {
+            if (void *storage = allocateSpanStorage(count * sizeof(Entry))) {
+                *fromArena = true;
+                return static_cast<Entry *>(storage);
+            }
+        }
+        *fromArena = false;
+        return new Entry[count];
+    }
+    static void freeEntries(Entry *storage, bool fromArena) noexcept
+    {
+        if (fromArena)
+            freeSpanStorage(storage);
+        else
+            delete [] storage;
+    }
     Node *insert(size_t i)
     {
         Q_ASSERT(i <= NEntries);
@@ -393,7 +417,8 @@ struct Span {
         // some more space
         const size_t increment = NEntries/8;
         size_t alloc = allocated + increment;
-        Entry *newEntries = new Entry[alloc];
+        bool newArenaStorage;
+        Entry *newEntries = allocateEntries(alloc, &newArenaStorage);
         // we only add storage if the previous storage was fully filled, so
         // simply copy the old data over
         if constexpr (isRelocatable<Node>()) {
@@ -408,8 +433,9 @@ struct Span {
         for (size_t i = allocated; i < allocated + increment; ++i) {
             newEntries[i].nextFree() = uchar(i + 1);
         }
-        delete [] entries;
+        freeEntries(entries, arenaStorage);
         entries = newEntries;
+        arenaStorage = newArenaStorage;
         allocated = uchar(alloc);
     }
 };
@@ -4,15 +4,19 @@ intel_icc: QMAKE_CXXFLAGS += -fp-model strict
 
 HEADERS +=  \
         tools/qalgorithms.h \
+        tools/qarenaallocator.h \
+        tools/qarenaallocator_p.h \
         tools/qarraydata.h \
         tools/qarraydataops.h \
         tools/qarraydatapointer.h \
         tools/qbitarray.h \
         tools/qcache.h \
+        tools/qconcurrenthash_p.h \
         tools/qcontainerfwd.h \
         tools/qcontainertools_impl.h \
         tools/qcryptographichash.h \
         tools/qduplicatetracker_p.h \
+        tools/qflathash_p.h \
         tools/qflatmap_p.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
@@ -50,6 +54,7 @@ HEADERS +=  \
         tools/qversionnumber.h
 
 SOURCES += \
+        tools/qarenaallocator.cpp \
         tools/qarraydata.cpp \
         tools/qbitarray.cpp \
         tools/qcryptographichash.cpp \
@@ -163,7 +163,7 @@ void QHostInfoResult::postResultsReady(const QHostInfo &info)
     types[0] = QMetaType::type("void");
     types[1] = QMetaType::type("QHostInfo");
     args[0] = nullptr;
-    args[1] = QMetaType::create(types[1], &info);
+    args[1] = metaCallEvent->createArgument(types[1], &info);
     Q_CHECK_PTR(args[1]);
     qApp->postEvent(result, metaCallEvent);
 }
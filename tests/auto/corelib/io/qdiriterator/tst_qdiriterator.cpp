@@ -103,6 +103,7 @@ private slots:
     void longPath();
     void dirorder();
     void relativePaths();
+    void prefetchMetadata();
 #if defined(Q_OS_WIN)
     void uncPaths_data();
     void uncPaths();
@@ -329,6 +330,16 @@ void tst_QDirIterator::iterateRelativeDirectory_data()
                    "entrylist/directory/dummy,"
                    "entrylist/writable").split(',');
 
+    QTest::newRow("QDir::Subdirectories | QDir::PrefetchMetadata / QDir::Files")
+        << QString("entrylist") << QDirIterator::IteratorFlags(QDirIterator::Subdirectories | QDirIterator::PrefetchMetadata)
+        << QDir::Filters(QDir::Files) << QStringList("*")
+        << QString("entrylist/directory/dummy,"
+                   "entrylist/file,"
+#ifndef Q_NO_SYMLINKS
+                   "entrylist/linktofile.lnk,"
+#endif
+                   "entrylist/writable").split(',');
+
     QTest::newRow("empty, default")
         << QString("empty") << QDirIterator::IteratorFlags{}
         << QDir::Filters(QDir::NoFilter) << QStringList("*")
@@ -582,6 +593,59 @@ void tst_QDirIterator::relativePaths()
     }
 }
 
+void tst_QDirIterator::prefetchMetadata()
+{
+    QVERIFY(createDirectory("prefetch"));
+    QVERIFY(createDirectory("prefetch/directory"));
+    QVERIFY(createFile("prefetch/empty"));
+    QVERIFY(createFile("prefetch/directory/empty"));
+    QFile sized("prefetch/sized");
+    QVERIFY(sized.open(QIODevice::WriteOnly));
+    QCOMPARE(sized.write(QByteArray(1234, 'x')), qint64(1234));
+    sized.close();
+    createdFiles << sized.fileName();
+#ifndef Q_NO_SYMLINKS
+    QVERIFY(createLink("sized", "prefetch/linktosized.lnk"));
+    QVERIFY(createLink("nothing", "prefetch/brokenlink.lnk"));
+#endif
+
+    const QDir::Filters filters = QDir::AllEntries | QDir::System | QDir::Hidden | QDir::NoDotAndDotDot;
+    QStringList plain;
+    QDirIterator plainIt("prefetch", filters, QDirIterator::Subdirectories);
+    while (plainIt.hasNext())
+        plain << plainIt.next();
+
+    QStringList prefetched;
+    QDirIterator it("prefetch", filters,
+                    QDirIterator::Subdirectories | QDirIterator::PrefetchMetadata);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        prefetched << path;
+        const QFileInfo info = it.fileInfo();
+        const QFileInfo fresh(path);
+        QCOMPARE(info.exists(), fresh.exists());
+        QCOMPARE(info.isSymLink(), fresh.isSymLink());
+        QCOMPARE(info.isFile(), fresh.isFile());
+        QCOMPARE(info.isDir(), fresh.isDir());
+        QCOMPARE(info.permissions(), fresh.permissions());
+        QCOMPARE(info.size(), fresh.size());
+        QCOMPARE(info.lastModified(), fresh.lastModified());
+    }
+
+    plain.sort();
+    prefetched.sort();
+    QCOMPARE(prefetched, plain);
+    QVERIFY(prefetched.contains("prefetch/sized"));
+#ifndef Q_NO_SYMLINKS
+    QVERIFY(prefetched.contains("prefetch/brokenlink.lnk"));
+#endif
+
+    const QFileInfoList bySize = QDir("prefetch").entryInfoList(QDir::Files, QDir::Size);
+    QVERIFY(bySize.size() >= 2);
+    QCOMPARE(bySize.first().size(), qint64(1234));
+    QCOMPARE(bySize.last().fileName(), QString("empty"));
+}
+
 #if defined(Q_OS_WIN)
 void tst_QDirIterator::uncPaths_data()
 {
@@ -36,6 +36,9 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QTemporaryDir>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
@@ -282,6 +285,11 @@ private slots:
 
     void stdfilesystem();
 
+    void readAsync_data();
+    void readAsync();
+    void readAllAsync();
+    void writeAsync();
+
 private:
 #ifdef BUILTIN_TESTDATA
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -3845,5 +3853,149 @@ void tst_QFile::stdfilesystem()
 #endif
 }
 
+static QByteArray asyncTestData(int size, char seed)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = char(seed + i * 7 + i / 251);
+    return data;
+}
+
+void tst_QFile::readAsync_data()
+{
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qint64>("maxSize");
+    QTest::addColumn<QByteArray>("expected");
+
+    const QByteArray data = asyncTestData(300000, 'a');
+    QTest::newRow("all") << qint64(0) << qint64(1 << 20) << data;
+    QTest::newRow("exact") << qint64(0) << qint64(data.size()) << data;
+    QTest::newRow("middle") << qint64(1000) << qint64(5000) << data.mid(1000, 5000);
+    QTest::newRow("tail") << qint64(299000) << qint64(5000) << data.mid(299000);
+    QTest::newRow("at-end") << qint64(data.size()) << qint64(10) << QByteArray("");
+    QTest::newRow("past-end") << qint64(400000) << qint64(10) << QByteArray("");
+    QTest::newRow("nothing") << qint64(0) << qint64(0) << QByteArray("");
+}
+
+void tst_QFile::readAsync()
+{
+#if QT_CONFIG(future)
+    QFETCH(qint64, offset);
+    QFETCH(qint64, maxSize);
+    QFETCH(QByteArray, expected);
+
+    const QString fileName = QStringLiteral("readAsync.bin");
+    {
+        QFile writer(fileName);
+        QVERIFY(writer.open(QIODevice::WriteOnly));
+        QCOMPARE(writer.write(asyncTestData(300000, 'a')), qint64(300000));
+    }
+
+    QFuture<QByteArray> future;
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QVERIFY(file.seek(42));
+        future = file.readAsync(offset, maxSize);
+        QCOMPARE(file.pos(), qint64(42));
+        // closing the file early must not affect the read
+    }
+    const QByteArray result = future.result();
+    QVERIFY(!result.isNull());
+    QCOMPARE(result, expected);
+
+    QFile notOpen(fileName);
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: File (readAsync.bin) not open");
+    QVERIFY(notOpen.readAsync(offset, maxSize).result().isNull());
+
+    QFile writeOnly(fileName);
+    QVERIFY(writeOnly.open(QIODevice::WriteOnly | QIODevice::Append));
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QFile::readAsync: File (readAsync.bin) not open for reading");
+    QVERIFY(writeOnly.readAsync(offset, maxSize).result().isNull());
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
+void tst_QFile::readAllAsync()
+{
+#if QT_CONFIG(future)
+    QList<QByteArray> expected;
+    QList<QFile *> files;
+    for (int i = 0; i < 600; ++i) {
+        const QString fileName = QStringLiteral("readAllAsync%1.bin").arg(i);
+        const QByteArray data = asyncTestData((i * 97) % 5000, char(i));
+        QFile writer(fileName);
+        QVERIFY(writer.open(QIODevice::WriteOnly));
+        QCOMPARE(writer.write(data), qint64(data.size()));
+        writer.close();
+
+        files.append(new QFile(fileName));
+        // every seventh file is not opened, which fails its read
+        if (i % 7 == 3) {
+            expected.append(QByteArray());
+            QTest::ignoreMessage(QtWarningMsg,
+                                 qPrintable(QStringLiteral("QFile::readAllAsync: File (%1) not open")
+                                            .arg(fileName)));
+        } else {
+            QVERIFY(files.constLast()->open(QIODevice::ReadOnly));
+            expected.append(data.isEmpty() ? QByteArray("") : data);
+        }
+    }
+
+    // resources have no file descriptor and are read by name
+    files.append(new QFile(QStringLiteral(":/tst_qfileinfo/resources/file1.ext1")));
+    QVERIFY(files.constLast()->open(QIODevice::ReadOnly));
+    expected.append(files.constLast()->readAll());
+    QVERIFY(!expected.constLast().isEmpty());
+
+    QFuture<QByteArray> future = QFile::readAllAsync(files);
+    qDeleteAll(files);
+
+    const QList<QByteArray> results = future.results();
+    QCOMPARE(results.size(), expected.size());
+    for (int i = 0; i < results.size(); ++i) {
+        QCOMPARE(results.at(i).isNull(), expected.at(i).isNull());
+        QCOMPARE(results.at(i), expected.at(i));
+    }
+
+    QVERIFY(QFile::readAllAsync({}).results().isEmpty());
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
+void tst_QFile::writeAsync()
+{
+#if QT_CONFIG(future)
+    const QString fileName = QStringLiteral("writeAsync.txt");
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite | QIODevice::Truncate));
+    // still buffered; writeAsync() must flush it first
+    QCOMPARE(file.write("hello"), qint64(5));
+    QCOMPARE(file.writeAsync(5, QByteArray(" world")).result(), qint64(6));
+    QCOMPARE(file.pos(), qint64(5));
+    QCOMPARE(file.writeAsync(11, QByteArray()).result(), qint64(0));
+
+    const QByteArray large = asyncTestData(1 << 20, 'x');
+    QCOMPARE(file.writeAsync(100, large).result(), qint64(large.size()));
+    QVERIFY(file.seek(0));
+    const QByteArray contents = file.readAll();
+    QCOMPARE(contents.size(), 100 + large.size());
+    QCOMPARE(contents.left(11), QByteArray("hello world"));
+    QCOMPARE(contents.mid(11, 89), QByteArray(89, '\0'));
+    QCOMPARE(contents.mid(100), large);
+    file.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QFile::writeAsync: File (writeAsync.txt) not open for writing");
+    QCOMPARE(file.writeAsync(0, QByteArray("x")).result(), qint64(-1));
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
 QTEST_MAIN(tst_QFile)
 #include "tst_qfile.moc"
@@ -2632,6 +2632,58 @@ void tst_QSortFilterProxyModel::sortStable()
     QCOMPARE(lastItemData, filterModel->index(2,0, firstRoot).data());
 }
 
+void tst_QSortFilterProxyModel::sortKeyCaching()
+{
+    QSortFilterProxyModel proxy;
+    QVERIFY(!proxy.isSortKeyCachingEnabled());
+    QSignalSpy spy(&proxy, &QSortFilterProxyModel::sortKeyCachingEnabledChanged);
+    proxy.setSortKeyCachingEnabled(true);
+    QVERIFY(proxy.isSortKeyCachingEnabled());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toBool(), true);
+    proxy.setSortKeyCachingEnabled(true);
+    QCOMPARE(spy.count(), 1);
+
+    // enough rows for the keys to be computed in parallel
+    QStringList strings;
+    const QStringList words = {
+        QStringLiteral("apple"), QStringLiteral("Apple"), QString::fromUtf8("\xc3\xa4pfel"),
+        QStringLiteral("zebra"), QString::fromUtf8("\xc3\xb6l"), QStringLiteral("test 9"),
+        QStringLiteral("test_19"), QString(), QStringLiteral("42")
+    };
+    for (int i = 0; i < 5000; ++i)
+        strings.append(words.at(i * 7 % words.size()) + QString::number(i % 13));
+    strings.append(QString());
+    QStandardItemModel model;
+    for (const QString &string : qAsConst(strings))
+        model.appendRow(new QStandardItem(string));
+
+    QSortFilterProxyModel reference;
+    reference.setSourceModel(&model);
+    reference.setSortLocaleAware(true);
+    proxy.setSourceModel(&model);
+    proxy.setSortLocaleAware(true);
+
+    const auto column = [](const QAbstractItemModel &model) {
+        QStringList result;
+        for (int row = 0; row < model.rowCount(); ++row)
+            result.append(model.index(row, 0).data().toString());
+        return result;
+    };
+    for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder }) {
+        reference.sort(0, order);
+        proxy.sort(0, order);
+        QCOMPARE(column(proxy), column(reference));
+    }
+
+    // data that are not strings are sorted by lessThan()
+    model.item(0)->setData(42, Qt::DisplayRole);
+    model.item(1)->setData(7, Qt::DisplayRole);
+    reference.sort(0);
+    proxy.sort(0);
+    QCOMPARE(column(proxy), column(reference));
+}
+
 void tst_QSortFilterProxyModel::hiddenColumns()
 {
     class MyStandardItemModel : public QStandardItemModel
@@ -89,6 +89,7 @@ private slots:
     void recursiveSignalEmission();
     void signalBlocking();
     void blockingQueuedConnection();
+    void batchedConnection();
     void childEvents();
     void installEventFilter();
     void deleteSelfInSlot();
@@ -3068,6 +3069,74 @@ private:
     EventList events;
 };
 
+void tst_QObject::batchedConnection()
+{
+    const auto batched = Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection);
+
+    QObject sender;
+    QObject receiver;
+    EventSpy spy;
+    receiver.installEventFilter(&spy);
+
+    QStringList received;
+    connect(&sender, &QObject::objectNameChanged, &receiver,
+            [&received](const QString &name) { received.append(name); }, batched);
+
+    QStringList expected;
+    for (int i = 0; i < 100; ++i) {
+        expected.append(QString::number(i));
+        sender.setObjectName(expected.last());
+    }
+    QVERIFY(received.isEmpty());
+
+    // all emissions are delivered, in order, by a single event
+    QCoreApplication::processEvents();
+    QCOMPARE(received, expected);
+    QCOMPARE(spy.eventList().count(), 1);
+    QCOMPARE(spy.eventList().first().second, QEvent::MetaCall);
+
+    // the emissions after the delivery start a new batch
+    received.clear();
+    spy.clear();
+    sender.setObjectName("last");
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QStringList("last"));
+    QCOMPARE(spy.eventList().count(), 1);
+
+    // deleting the receiver discards the pending calls
+    SenderObject sender2;
+    ReceiverObject *receiver2 = new ReceiverObject;
+    QVERIFY(connect(&sender2, SIGNAL(signal1()), receiver2, SLOT(slot1()), batched));
+    sender2.emitSignal1();
+    sender2.emitSignal1();
+    delete receiver2;
+    QCoreApplication::processEvents();
+
+    // a slot deleting the receiver stops the delivery of the batch
+    QObject *receiver3 = new QObject;
+    int calls = 0;
+    connect(&sender, &QObject::objectNameChanged, receiver3, [&] {
+        ++calls;
+        delete receiver3;
+    }, batched);
+    sender.setObjectName("a");
+    sender.setObjectName("b");
+    QCoreApplication::processEvents();
+    QCOMPARE(calls, 1);
+
+    // emissions from other threads are batched as well
+    received.clear();
+    QThread *thread = QThread::create([&sender] {
+        for (int i = 0; i < 1000; ++i)
+            sender.setObjectName(QString::number(i));
+    });
+    thread->start();
+    QVERIFY(thread->wait());
+    delete thread;
+    QTRY_COMPARE(received.count(), 1000);
+    QCOMPARE(received.last(), QString::number(999));
+}
+
 void tst_QObject::childEvents()
 {
     EventSpy::EventList expected;
@@ -35,6 +35,7 @@ QT_WARNING_DISABLE_DEPRECATED
 #include "qjsonvalue.h"
 #include "qjsondocument.h"
 #include "qregularexpression.h"
+#include <private/qjsonparser_p.h>
 #include <limits>
 
 #define INVALID_UNICODE "\xCE\xBA\xE1"
@@ -148,6 +149,9 @@ private Q_SLOTS:
     void parseErrorOffset_data();
     void parseErrorOffset();
 
+    void indexedParser_data();
+    void indexedParser();
+
     void implicitValueType();
     void implicitDocumentType();
 
@@ -3075,6 +3079,86 @@ void tst_QtJson::parseErrorOffset()
     QCOMPARE(error.offset, errorOffset);
 }
 
+void tst_QtJson::indexedParser_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("empty-array") << QByteArray("[]");
+    QTest::newRow("empty-object") << QByteArray("{ }");
+    QTest::newRow("literals") << QByteArray("[null,true, false ,\tnull\r\n]");
+    QTest::newRow("numbers") << QByteArray("[0,-1,1.5,-2.5e10,1E-3,9223372036854775807,1e300,-0]");
+    QTest::newRow("nested") << QByteArray("{\"a\":[{\"b\":{}},[[]],{\"c\":[1,{\"d\":null}]}]}");
+    QTest::newRow("duplicate-keys") << QByteArray("{\"b\":1,\"a\":2,\"b\":3}");
+    QTest::newRow("structurals-in-string") << QByteArray("[\"{[:,]}\", \"a b\"]");
+    QTest::newRow("escapes") << QByteArray(R"(["\"", "\\", "\\\"", "a\nb", "\u00e9\ud83d\ude00", "\/"])");
+    QTest::newRow("escaped-key") << QByteArray(R"({"a\"b": 1, "c\\": "d\\"})");
+    QTest::newRow("utf8") << QByteArray("{\"" UNICODE_DJE "\":\"\xc3\xa9\xf0\x9f\x98\x80\"}");
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf[1]");
+
+    QTest::newRow("literal-garbage") << QByteArray("[nullx]");
+    QTest::newRow("short-literal") << QByteArray("[tru]");
+    QTest::newRow("number-garbage") << QByteArray("[1.5.3]");
+    QTest::newRow("number-then-string") << QByteArray("[1\"a\"]");
+    QTest::newRow("missing-separator") << QByteArray("[1 2]");
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" \"b\":1}");
+    QTest::newRow("trailing-comma") << QByteArray("{\"a\":1,}");
+    QTest::newRow("unterminated-string") << QByteArray("[\"abc]");
+    QTest::newRow("unterminated-escape") << QByteArray("[\"abc\\\"]");
+    QTest::newRow("invalid-escape") << QByteArray("[\"\\u12\"]");
+    QTest::newRow("invalid-utf8") << QByteArray("[\"" INVALID_UNICODE "\"]");
+    QTest::newRow("invalid-utf8-after-end") << QByteArray("[1] \xff");
+    QTest::newRow("string-at-end") << QByteArray("[\"a\"");
+    QTest::newRow("garbage-at-end") << QByteArray("{} x");
+    QTest::newRow("second-document") << QByteArray("[] []");
+    QTest::newRow("top-level-scalar") << QByteArray("1");
+    QTest::newRow("backslash-outside-string") << QByteArray("[\\\"a\"]");
+
+    QByteArray deep(2048, '[');
+    deep += QByteArray(2048, ']');
+    QTest::newRow("deep-nesting") << deep;
+
+    // long strings and runs of backslashes crossing the 64-byte blocks
+    QByteArray large = "[";
+    for (int i = 0; i < 200; ++i) {
+        large += '"';
+        large += QByteArray(i % 70, 'x');
+        large += QByteArray(i % 7, '\\');
+        if (i % 7 % 2)
+            large += '\\';
+        large += "\", ";
+        large += QByteArray::number(i * 1.25);
+        large += ", \"\xc3\xa9";
+        large += QByteArray(i % 65, ' ');
+        large += "\",{\"k\":[true,false,null]},";
+    }
+    large += "0]";
+    QTest::newRow("large") << large;
+}
+
+void tst_QtJson::indexedParser()
+{
+    QFETCH(QByteArray, json);
+
+    // shift the document over the SIMD block boundaries
+    for (int shift = 0; shift < 66; ++shift) {
+        const QByteArray padded = QByteArray(shift, ' ') + json;
+        QJsonParseError sequentialError;
+        QJsonPrivate::Parser sequentialParser(padded.constData(), padded.size());
+        const QCborValue sequential = sequentialParser.parse(&sequentialError,
+                                      QJsonPrivate::Parser::Strategy::Sequential);
+        QJsonParseError indexedError;
+        QJsonPrivate::Parser indexedParser(padded.constData(), padded.size());
+        const QCborValue indexed = indexedParser.parse(&indexedError,
+                                   QJsonPrivate::Parser::Strategy::Indexed);
+
+        QCOMPARE(indexedError.error, sequentialError.error);
+        QCOMPARE(indexedError.offset, sequentialError.offset);
+        QCOMPARE(indexed, sequential);
+        QCOMPARE(indexed.toCbor(), sequential.toCbor());
+    }
+}
+
 void tst_QtJson::implicitValueType()
 {
     QJsonObject rootObject{
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qjsonlazydocument
+QT = core-private testlib
+SOURCES = tst_qjsonlazydocument.cpp
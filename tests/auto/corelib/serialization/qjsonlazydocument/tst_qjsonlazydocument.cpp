@@ -0,0 +1,252 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qflatmap_p.h>
+#include <qbytearray.h>
+#include <qstring.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtCore/private/qjsonlazydocument_p.h>
+
+class tst_QJsonLazyDocument : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void navigation();
+    void scalars();
+    void duplicateKeys();
+    void escapedKeys();
+    void toJsonValue_data();
+    void toJsonValue();
+    void errors_data();
+    void errors();
+    void fromFile();
+    void copies();
+};
+
+static const char document[] = R"({
+    "name": "qt",
+    "version": 6,
+    "ratio": 0.5,
+    "big": 12345678901234,
+    "enabled": true,
+    "disabled": false,
+    "nothing": null,
+    "list": [1, "two", [3], {"four": 4}, null],
+    "nested": {"a": {"b": {"c": "deep"}}},
+    "empty": {},
+    "none": []
+})";
+
+void tst_QJsonLazyDocument::navigation()
+{
+    QJsonParseError error;
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(document, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(!doc.isNull());
+    QVERIFY(doc.isObject());
+    QVERIFY(!doc.isArray());
+
+    const QJsonLazyValue root = doc.root();
+    QCOMPARE(root.size(), 11);
+    QCOMPARE(root.keys(), QJsonDocument::fromJson(document).object().keys());
+    QVERIFY(root.contains("list"));
+    QVERIFY(!root.contains("missing"));
+    QVERIFY(root["missing"].isUndefined());
+
+    const QJsonLazyValue list = doc["list"];
+    QVERIFY(list.isArray());
+    QCOMPARE(list.size(), 5);
+    QCOMPARE(list[0].toInt(), 1);
+    QCOMPARE(list[1].toString(), QStringLiteral("two"));
+    QCOMPARE(list[2][0].toInt(), 3);
+    QCOMPARE(list[3]["four"].toInt(), 4);
+    QVERIFY(list[4].isNull());
+    QVERIFY(list[5].isUndefined());
+    QVERIFY(list[-1].isUndefined());
+    QVERIFY(list["key"].isUndefined());
+
+    QCOMPARE(doc["nested"]["a"]["b"]["c"].toString(), QStringLiteral("deep"));
+    QCOMPARE(doc["empty"].size(), 0);
+    QVERIFY(doc["empty"].isObject());
+    QCOMPARE(doc["none"].size(), 0);
+    QVERIFY(doc["none"].isArray());
+    QVERIFY(doc["name"]["x"].isUndefined());
+    QCOMPARE(doc["name"].size(), 0);
+}
+
+void tst_QJsonLazyDocument::scalars()
+{
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(document);
+
+    QCOMPARE(doc["name"].type(), QJsonValue::String);
+    QCOMPARE(doc["name"].toString(), QStringLiteral("qt"));
+    QCOMPARE(doc["name"].toInt(-1), -1);
+
+    QCOMPARE(doc["version"].type(), QJsonValue::Double);
+    QCOMPARE(doc["version"].toInt(), 6);
+    QCOMPARE(doc["version"].toDouble(), 6.);
+    QCOMPARE(doc["ratio"].toDouble(), 0.5);
+    QCOMPARE(doc["ratio"].toInt(-1), -1);
+    QCOMPARE(doc["big"].toInteger(), Q_INT64_C(12345678901234));
+    QCOMPARE(doc["version"].toString(QStringLiteral("x")), QStringLiteral("x"));
+
+    QCOMPARE(doc["enabled"].type(), QJsonValue::Bool);
+    QCOMPARE(doc["enabled"].toBool(), true);
+    QCOMPARE(doc["disabled"].toBool(true), false);
+    QCOMPARE(doc["nothing"].type(), QJsonValue::Null);
+    QCOMPARE(doc["nothing"].toBool(true), true);
+}
+
+void tst_QJsonLazyDocument::duplicateKeys()
+{
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(R"({"b": 1, "a": 2, "b": 3})");
+    QCOMPARE(doc.root().size(), 2);
+    QCOMPARE(doc.root().keys(), QStringList({ "a", "b" }));
+    QCOMPARE(doc["b"].toInt(), 3);
+}
+
+void tst_QJsonLazyDocument::escapedKeys()
+{
+    const QJsonLazyDocument doc =
+            QJsonLazyDocument::fromJson(R"({"a\"b": 1, "\u00e9": "\u00e9\n", "": 3})");
+    QVERIFY(!doc.isNull());
+    QCOMPARE(doc["a\"b"].toInt(), 1);
+    QCOMPARE(doc[QString(QChar(0xe9))].toString(), QString(QChar(0xe9)) + QLatin1Char('\n'));
+    QCOMPARE(doc[QString()].toInt(), 3);
+    QCOMPARE(doc[""].toInt(), 3);
+}
+
+void tst_QJsonLazyDocument::toJsonValue_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("object") << QByteArray(document);
+    QTest::newRow("array") << QByteArray("[1, [2, [3, {\"x\": \"\\u0041\"}]], \"s\", -0.25e2]");
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf {\"k\": [true]}");
+}
+
+void tst_QJsonLazyDocument::toJsonValue()
+{
+    QFETCH(QByteArray, json);
+
+    const QJsonDocument eager = QJsonDocument::fromJson(json);
+    const QJsonLazyDocument lazy = QJsonLazyDocument::fromJson(json);
+    QVERIFY(!eager.isNull());
+    QVERIFY(!lazy.isNull());
+
+    const QJsonValue value = lazy.root().toJsonValue();
+    if (eager.isObject()) {
+        QCOMPARE(value.toObject(), eager.object());
+        for (const QString &key : eager.object().keys())
+            QCOMPARE(lazy[key].toJsonValue(), eager.object().value(key));
+    } else {
+        QCOMPARE(value.toArray(), eager.array());
+        for (qsizetype i = 0; i < eager.array().size(); ++i)
+            QCOMPARE(lazy[i].toJsonValue(), eager.array().at(i));
+    }
+}
+
+void tst_QJsonLazyDocument::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("scalar") << QByteArray("1");
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\": 1");
+    QTest::newRow("unterminated-array") << QByteArray("[1, 2");
+    QTest::newRow("unterminated-string") << QByteArray("[\"abc]");
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}");
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]");
+    QTest::newRow("trailing-comma") << QByteArray("[1, ]");
+    QTest::newRow("mismatched") << QByteArray("[1}");
+    QTest::newRow("non-string-key") << QByteArray("{1: 2}");
+    QTest::newRow("illegal-literal") << QByteArray("[nul]");
+    QTest::newRow("illegal-number") << QByteArray("[1.2.3]");
+    QTest::newRow("garbage-at-end") << QByteArray("{} {}");
+    QTest::newRow("invalid-utf8") << QByteArray("[\"\xff\"]");
+    QTest::newRow("deep-nesting") << QByteArray(1025, '[') + QByteArray(1025, ']');
+}
+
+void tst_QJsonLazyDocument::errors()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError expected;
+    QVERIFY(QJsonDocument::fromJson(json, &expected).isNull());
+
+    QJsonParseError error;
+    const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(json, &error);
+    QVERIFY(doc.isNull());
+    QVERIFY(doc.root().isUndefined());
+    QCOMPARE(error.error, expected.error);
+    QCOMPARE(error.offset, expected.offset);
+}
+
+void tst_QJsonLazyDocument::fromFile()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(document);
+    file.close();
+
+    QJsonParseError error;
+    QJsonLazyDocument doc = QJsonLazyDocument::fromFile(file.fileName(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(doc["list"][3]["four"].toInt(), 4);
+
+    // values keep the mapping alive
+    const QJsonLazyValue nested = doc["nested"]["a"];
+    doc = QJsonLazyDocument();
+    QCOMPARE(nested["b"]["c"].toString(), QStringLiteral("deep"));
+
+    QVERIFY(QJsonLazyDocument::fromFile(file.fileName() + ".missing", &error).isNull());
+    QCOMPARE(error.error, QJsonParseError::IllegalValue);
+}
+
+void tst_QJsonLazyDocument::copies()
+{
+    QJsonLazyDocument doc = QJsonLazyDocument::fromJson(document);
+    QJsonLazyDocument copy = doc;
+    QJsonLazyValue value = copy["list"];
+    QJsonLazyValue moved = std::move(value);
+    QVERIFY(value.isUndefined());
+    QCOMPARE(moved.size(), 5);
+
+    QJsonLazyDocument other;
+    other.swap(copy);
+    QVERIFY(copy.isNull());
+    QCOMPARE(other["version"].toInt(), 6);
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonLazyDocument)
+#include "tst_qjsonlazydocument.moc"
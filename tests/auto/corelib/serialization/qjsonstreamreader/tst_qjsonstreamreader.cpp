@@ -0,0 +1,419 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qjsonstreamreader.h>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tokens_data();
+    void tokens();
+    void tokensIncremental_data() { tokens_data(); }
+    void tokensIncremental();
+    void tokensSequentialDevice_data() { tokens_data(); }
+    void tokensSequentialDevice();
+    void tokensBuffer_data() { tokens_data(); }
+    void tokensBuffer();
+    void values();
+    void trailingScalar();
+    void containerDepth();
+    void errors_data();
+    void errors();
+    void deepNesting();
+    void clear();
+    void largeStream();
+};
+
+// A sequential device that only returns the data fed to it so far.
+class SequentialDevice : public QIODevice
+{
+public:
+    SequentialDevice() { open(ReadOnly); }
+
+    bool isSequential() const override { return true; }
+    void feed(const QByteArray &data) { pending += data; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 n = qMin<qint64>(maxSize, pending.size());
+        memcpy(data, pending.constData(), n);
+        pending.remove(0, n);
+        return n;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray pending;
+};
+
+static QString tokenString(const QJsonStreamReader &reader)
+{
+    switch (reader.tokenType()) {
+    case QJsonStreamReader::StartArray:
+        return QStringLiteral("[");
+    case QJsonStreamReader::EndArray:
+        return QStringLiteral("]");
+    case QJsonStreamReader::StartObject:
+        return QStringLiteral("{");
+    case QJsonStreamReader::EndObject:
+        return QStringLiteral("}");
+    case QJsonStreamReader::Name:
+        return QLatin1String("name:") + reader.text();
+    case QJsonStreamReader::String:
+        return QLatin1String("s:") + reader.text();
+    case QJsonStreamReader::Number:
+        return reader.isInteger() ? QLatin1String("i:") + QString::number(reader.toInteger())
+                                  : QLatin1String("d:") + QString::number(reader.toDouble());
+    case QJsonStreamReader::Bool:
+        return reader.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    case QJsonStreamReader::Null:
+        return QStringLiteral("null");
+    default:
+        return QStringLiteral("unexpected %1").arg(reader.tokenType());
+    }
+}
+
+// Reads tokens until the reader runs out of data, appending them to tokens.
+static QJsonStreamReader::TokenType readAvailable(QJsonStreamReader &reader, QStringList &tokens)
+{
+    while (true) {
+        const QJsonStreamReader::TokenType type = reader.readNext();
+        if (type == QJsonStreamReader::Incomplete || type == QJsonStreamReader::NoToken
+                || type == QJsonStreamReader::Invalid) {
+            return type;
+        }
+        tokens << tokenString(reader);
+    }
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("empty-array") << QByteArray("[]") << QStringList{ "[", "]" };
+    QTest::newRow("empty-object") << QByteArray(" { } ") << QStringList{ "{", "}" };
+    QTest::newRow("array")
+            << QByteArray("[1, -2.5, \"x\", true, false, null]")
+            << QStringList{ "[", "i:1", "d:-2.5", "s:x", "true", "false", "null", "]" };
+    QTest::newRow("object")
+            << QByteArray("{\"a\": 1, \"\": [], \"c\" : {\"d\":null}}")
+            << QStringList{ "{", "name:a", "i:1", "name:", "[", "]",
+                            "name:c", "{", "name:d", "null", "}", "}" };
+    QTest::newRow("nested-arrays")
+            << QByteArray("[[[]],[[1]]]")
+            << QStringList{ "[", "[", "[", "]", "]", "[", "[", "i:1", "]", "]", "]" };
+    QTest::newRow("escapes")
+            << QByteArray("[\"a\\\"b\\\\\", \"\\u00e9\\n\", \"\\\\\"]")
+            << QStringList{ "[", QString::fromUtf8("s:a\"b\\"),
+                            QString::fromUtf8("s:\xc3\xa9\n"), "s:\\", "]" };
+    QTest::newRow("utf8")
+            << QByteArray("{\"\xc3\xa9t\xc3\xa9\":\"\xe2\x82\xac\"}")
+            << QStringList{ "{", QString::fromUtf8("name:\xc3\xa9t\xc3\xa9"),
+                            QString::fromUtf8("s:\xe2\x82\xac"), "}" };
+    QTest::newRow("ndjson")
+            << QByteArray("{\"id\":1}\n{\"id\":2}\n[3]\n")
+            << QStringList{ "{", "name:id", "i:1", "}", "{", "name:id", "i:2", "}",
+                            "[", "i:3", "]" };
+    QTest::newRow("top-level-scalars")
+            << QByteArray("1 \"two\" 3.5 true null\n")
+            << QStringList{ "i:1", "s:two", "d:3.5", "true", "null" };
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QStringList, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QStringList tokens;
+    QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::NoToken);
+    QCOMPARE(tokens, expected);
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+}
+
+void tst_QJsonStreamReader::tokensIncremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QStringList, expected);
+
+    // a number at the very end of added data is only complete once more
+    // data follows
+    json += ' ';
+
+    QJsonStreamReader reader;
+    QStringList tokens;
+    for (char c : qAsConst(json)) {
+        reader.addData(QByteArray(1, c));
+        const QJsonStreamReader::TokenType type = readAvailable(reader, tokens);
+        QVERIFY(type != QJsonStreamReader::Invalid);
+    }
+    QCOMPARE(tokens, expected);
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::tokensSequentialDevice()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QStringList, expected);
+
+    SequentialDevice device;
+    QJsonStreamReader reader(&device);
+    QStringList tokens;
+    for (qsizetype i = 0; i < json.size(); i += 3) {
+        device.feed(json.mid(i, 3));
+        QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::Incomplete);
+    }
+    QVERIFY(!reader.atEnd());
+
+    // closing the device ends a trailing number or literal
+    device.close();
+    QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::NoToken);
+    QCOMPARE(tokens, expected);
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::tokensBuffer()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QStringList, expected);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QStringList tokens;
+    QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::NoToken);
+    QCOMPARE(tokens, expected);
+}
+
+void tst_QJsonStreamReader::values()
+{
+    QJsonStreamReader reader(QByteArray(
+            "[\"s\", 42, 1.5, 1e300, 9007199254740993, true, null]"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.value(), QJsonValue(QJsonValue::Undefined));
+    QVERIFY(reader.text().isNull());
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.value(), QJsonValue("s"));
+    QCOMPARE(reader.toInteger(), 0);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), 42);
+    QCOMPARE(reader.toDouble(), 42.);
+    QCOMPARE(reader.value(), QJsonValue(42));
+    QVERIFY(reader.text().isNull());
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(!reader.isInteger());
+    QCOMPARE(reader.toDouble(), 1.5);
+    QCOMPARE(reader.toInteger(), 1);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toDouble(), 1e300);
+
+    // integers are read like QJsonDocument reads them
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(),
+             QJsonDocument::fromJson("[9007199254740993]").array().at(0));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+    QVERIFY(reader.toBool());
+    QCOMPARE(reader.value(), QJsonValue(true));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Null);
+    QCOMPARE(reader.value(), QJsonValue(QJsonValue::Null));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+}
+
+void tst_QJsonStreamReader::trailingScalar()
+{
+    // without a device, more data may always follow
+    QJsonStreamReader reader;
+    reader.addData("12");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Incomplete);
+    QVERIFY(!reader.atEnd());
+    reader.addData("3");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Incomplete);
+    reader.addData("\n");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 123);
+    QCOMPARE(reader.currentOffset(), 0);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QVERIFY(reader.atEnd());
+
+    // a string ends with its closing quote
+    reader.addData("\"abc\"");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), QLatin1String("abc"));
+    QCOMPARE(reader.currentOffset(), 4);
+
+    // a random-access device ends at its end
+    QByteArray data("[1] fals");
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader bufferReader(&buffer);
+    QStringList tokens;
+    QCOMPARE(readAvailable(bufferReader, tokens), QJsonStreamReader::Invalid);
+    QCOMPARE(tokens, QStringList({ "[", "i:1", "]" }));
+    QCOMPARE(bufferReader.error(), QJsonParseError::IllegalValue);
+    QCOMPARE(bufferReader.currentOffset(), 5);
+}
+
+void tst_QJsonStreamReader::containerDepth()
+{
+    QJsonStreamReader reader(QByteArray("[{\"a\":[1]}]"));
+    const int depths[] = { 1, 2, 2, 3, 3, 2, 1, 0 };
+    for (int depth : depths) {
+        reader.readNext();
+        QCOMPARE(reader.containerDepth(), depth);
+    }
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<int>("tokens");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+    QTest::addColumn<qint64>("offset");
+
+    QTest::newRow("missing-comma") << QByteArray("[1 2]") << 2
+                                   << QJsonParseError::MissingValueSeparator << qint64(3);
+    QTest::newRow("missing-colon") << QByteArray("{\"a\" 1}") << 2
+                                   << QJsonParseError::MissingNameSeparator << qint64(5);
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\":1]") << 3
+                                         << QJsonParseError::UnterminatedObject << qint64(6);
+    QTest::newRow("trailing-comma-array") << QByteArray("[1,]") << 2
+                                          << QJsonParseError::MissingObject << qint64(3);
+    QTest::newRow("trailing-comma-object") << QByteArray("{\"a\":1,}") << 3
+                                           << QJsonParseError::MissingObject << qint64(7);
+    QTest::newRow("non-string-key") << QByteArray("{1:2}") << 1
+                                    << QJsonParseError::UnterminatedObject << qint64(1);
+    QTest::newRow("stray-close") << QByteArray("]") << 0
+                                 << QJsonParseError::MissingObject << qint64(0);
+    QTest::newRow("bad-literal") << QByteArray("[tru ]") << 1
+                                 << QJsonParseError::IllegalValue << qint64(2);
+    QTest::newRow("bad-number") << QByteArray("[1.2.3 ]") << 1
+                                << QJsonParseError::IllegalNumber << qint64(4);
+    QTest::newRow("bad-escape") << QByteArray("[\"\\uZZZZ\" ]") << 1
+                                << QJsonParseError::IllegalEscapeSequence << qint64(4);
+    QTest::newRow("second-error-after-valid-value") << QByteArray("{} , {}") << 2
+                                                    << QJsonParseError::IllegalValue << qint64(3);
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(int, tokens);
+    QFETCH(QJsonParseError::ParseError, error);
+    QFETCH(qint64, offset);
+
+    QJsonStreamReader reader(json);
+    QStringList read;
+    QCOMPARE(readAvailable(reader, read), QJsonStreamReader::Invalid);
+    QCOMPARE(read.size(), tokens);
+    QVERIFY(reader.hasError());
+    QCOMPARE(reader.error(), error);
+    QVERIFY(!reader.errorString().isEmpty());
+    QCOMPARE(reader.currentOffset(), offset);
+    QVERIFY(reader.atEnd());
+
+    // the error is sticky
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), error);
+}
+
+void tst_QJsonStreamReader::deepNesting()
+{
+    QJsonStreamReader reader(QByteArray(2048, '['));
+    QStringList tokens;
+    QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::Invalid);
+    QCOMPARE(tokens.size(), 1024);
+    QCOMPARE(reader.error(), QJsonParseError::DeepNesting);
+}
+
+void tst_QJsonStreamReader::clear()
+{
+    QJsonStreamReader reader(QByteArray("[1 2]"));
+    QStringList tokens;
+    QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::Invalid);
+
+    reader.clear();
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(reader.containerDepth(), 0);
+    reader.addData("{}");
+    tokens.clear();
+    QCOMPARE(readAvailable(reader, tokens), QJsonStreamReader::NoToken);
+    QCOMPARE(tokens, QStringList({ "{", "}" }));
+}
+
+void tst_QJsonStreamReader::largeStream()
+{
+    // many records, with strings longer than the read size of the reader
+    const QString longString(40000, QLatin1Char('x'));
+    QByteArray json;
+    for (int i = 0; i < 100; ++i) {
+        QJsonObject record{ { "id", i }, { "text", i % 10 ? QString::number(i) : longString } };
+        json += QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+    }
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    int records = 0;
+    while (reader.readNext() == QJsonStreamReader::StartObject) {
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+        QCOMPARE(reader.toInteger(), records);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+        QCOMPARE(reader.text(), QLatin1String("text"));
+        QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+        QCOMPARE(reader.text(), records % 10 ? QString::number(records) : longString);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+        ++records;
+    }
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(records, 100);
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
@@ -0,0 +1,267 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qjsonstreamreader.h>
+#include <QtCore/qjsonstreamwriter.h>
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void scalars_data();
+    void scalars();
+    void containers();
+    void jsonValue_data();
+    void jsonValue();
+    void multipleValues();
+    void device();
+    void roundTrip();
+};
+
+void tst_QJsonStreamWriter::scalars_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("string") << QJsonValue("hello");
+    QTest::newRow("escaped-string") << QJsonValue(QString::fromUtf8("\"\\\n\t\x01\xc3\xa9"));
+    QTest::newRow("empty-string") << QJsonValue("");
+    QTest::newRow("int") << QJsonValue(-42);
+    QTest::newRow("large-int") << QJsonValue(qint64(1) << 53);
+    QTest::newRow("double") << QJsonValue(0.1);
+    QTest::newRow("small-double") << QJsonValue(-1.5e-300);
+    QTest::newRow("infinity") << QJsonValue(qInf());
+    QTest::newRow("true") << QJsonValue(true);
+    QTest::newRow("false") << QJsonValue(false);
+    QTest::newRow("null") << QJsonValue(QJsonValue::Null);
+}
+
+// The element of a one-element array, as QJsonDocument writes it.
+static QByteArray documentJson(const QJsonValue &value)
+{
+    const QByteArray json = QJsonDocument(QJsonArray{ value }).toJson(QJsonDocument::Compact);
+    return json.mid(1, json.size() - 2);
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QFETCH(QJsonValue, value);
+    const QByteArray expected = documentJson(value) + '\n';
+
+    QByteArray data;
+    {
+        QJsonStreamWriter writer(&data);
+        writer.writeValue(value);
+    }
+    QCOMPARE(data, expected);
+
+    data.clear();
+    {
+        QJsonStreamWriter writer(&data);
+        switch (value.type()) {
+        case QJsonValue::String:
+            writer.writeValue(value.toString());
+            break;
+        case QJsonValue::Double:
+            if (value.isDouble() && value.toDouble() == value.toInteger())
+                writer.writeValue(value.toInteger());
+            else
+                writer.writeValue(value.toDouble());
+            break;
+        case QJsonValue::Bool:
+            writer.writeValue(value.toBool());
+            break;
+        default:
+            writer.writeValue(nullptr);
+            break;
+        }
+    }
+    QCOMPARE(data, expected);
+}
+
+void tst_QJsonStreamWriter::containers()
+{
+    QByteArray data;
+    QJsonStreamWriter writer(&data);
+    writer.writeStartObject();
+    QCOMPARE(writer.containerDepth(), 1);
+    writer.writeName("list");
+    writer.writeStartArray();
+    QCOMPARE(writer.containerDepth(), 2);
+    writer.writeValue(1);
+    writer.writeValue(QLatin1String("two"));
+    writer.writeStartArray();
+    writer.writeEndArray();
+    writer.writeStartObject();
+    writer.writeEndObject();
+    writer.writeEndArray();
+    writer.writeName("");
+    writer.writeValue(false);
+    writer.writeName("nested");
+    writer.writeStartObject();
+    writer.writeName("a");
+    writer.writeValue(nullptr);
+    writer.writeEndObject();
+    QVERIFY(data.isEmpty());
+    writer.writeEndObject();
+    QCOMPARE(writer.containerDepth(), 0);
+
+    QCOMPARE(data, QByteArray("{\"list\":[1,\"two\",[],{}],\"\":false,\"nested\":{\"a\":null}}\n"));
+}
+
+void tst_QJsonStreamWriter::jsonValue_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("array") << QJsonValue(QJsonArray{ 1, "x", QJsonArray{ true }, QJsonObject{} });
+    QTest::newRow("object") << QJsonValue(QJsonObject{ { "b", 1.5 }, { "a", QJsonArray{} } });
+}
+
+void tst_QJsonStreamWriter::jsonValue()
+{
+    QFETCH(QJsonValue, value);
+
+    QByteArray data;
+    QJsonStreamWriter writer(&data);
+    writer.writeStartArray();
+    writer.writeValue(value);
+    writer.writeValue(value);
+    writer.writeEndArray();
+
+    const QJsonDocument doc(QJsonArray{ value, value });
+    QCOMPARE(data, doc.toJson(QJsonDocument::Compact) + '\n');
+
+    data.clear();
+    writer.writeValue(QJsonValue(QJsonValue::Undefined));
+    QCOMPARE(data, QByteArray("null\n"));
+}
+
+void tst_QJsonStreamWriter::multipleValues()
+{
+    QByteArray data;
+    QJsonStreamWriter writer(&data);
+    writer.writeStartArray();
+    writer.writeEndArray();
+    writer.writeValue(1);
+    writer.writeStartObject();
+    writer.writeEndObject();
+    QCOMPARE(data, QByteArray("[]\n1\n{}\n"));
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QJsonStreamWriter writer(&buffer);
+    QCOMPARE(writer.device(), &buffer);
+
+    writer.writeStartArray();
+    writer.writeValue(1);
+    QVERIFY(buffer.data().isEmpty());
+    QVERIFY(writer.flush());
+    QCOMPARE(buffer.data(), QByteArray("[1"));
+    writer.writeEndArray();
+    QCOMPARE(buffer.data(), QByteArray("[1]\n"));
+    QVERIFY(!writer.hasError());
+
+    // large values are written out before the top-level value ends
+    writer.writeStartArray();
+    for (int i = 0; i < 10000; ++i)
+        writer.writeValue(i);
+    QVERIFY(buffer.data().size() > 4);
+    writer.writeEndArray();
+
+    // a device that does not accept the data
+    QBuffer readOnly;
+    QVERIFY(readOnly.open(QIODevice::ReadOnly));
+    writer.setDevice(&readOnly);
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): ReadOnly device");
+    writer.writeValue(true);
+    QVERIFY(writer.hasError());
+    QVERIFY(!writer.flush());
+}
+
+void tst_QJsonStreamWriter::roundTrip()
+{
+    const QJsonObject object{
+        { "name", QString::fromUtf8("\xe2\x82\xac \"quoted\"") },
+        { "values", QJsonArray{ 1, -0.25, 1e100, true, QJsonValue::Null } },
+        { "nested", QJsonObject{ { "empty", QJsonArray{} } } }
+    };
+
+    QByteArray data;
+    {
+        QJsonStreamWriter writer(&data);
+        for (int i = 0; i < 3; ++i)
+            writer.writeValue(object);
+    }
+
+    // copy every token read to a second writer
+    QByteArray copy;
+    QJsonStreamReader reader(data);
+    QJsonStreamWriter writer(&copy);
+    while (true) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::StartArray:
+            writer.writeStartArray();
+            continue;
+        case QJsonStreamReader::EndArray:
+            writer.writeEndArray();
+            continue;
+        case QJsonStreamReader::StartObject:
+            writer.writeStartObject();
+            continue;
+        case QJsonStreamReader::EndObject:
+            writer.writeEndObject();
+            continue;
+        case QJsonStreamReader::Name:
+            writer.writeName(reader.text());
+            continue;
+        case QJsonStreamReader::String:
+        case QJsonStreamReader::Number:
+        case QJsonStreamReader::Bool:
+        case QJsonStreamReader::Null:
+            writer.writeValue(reader.value());
+            continue;
+        default:
+            break;
+        }
+        break;
+    }
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(copy, data);
+
+    QCOMPARE(data.count('\n'), 3);
+    const QByteArray first = data.left(data.indexOf('\n'));
+    QCOMPARE(QJsonDocument::fromJson(first).object(), object);
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
@@ -5,6 +5,9 @@ SUBDIRS = \
     qcborstreamwriter \
     qcborvalue \
     qcborvalue_json \
+    qjsonlazydocument \
+    qjsonstreamreader \
+    qjsonstreamwriter \
     qdatastream \
     qdatastream_core_pixmap \
     qtextstream \
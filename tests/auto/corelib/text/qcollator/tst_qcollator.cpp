@@ -30,6 +30,8 @@
 
 #include <qlocale.h>
 #include <qcollator.h>
+#include <qrandom.h>
+#include <qthreadpool.h>
 #include <private/qglobal_p.h>
 
 #include <cstring>
@@ -45,6 +47,11 @@ private Q_SLOTS:
     void compare();
 
     void state();
+
+    void sortKeys_data();
+    void sortKeys();
+    void sort_data();
+    void sort();
 };
 
 static bool dpointer_is_null(QCollator &c)
@@ -242,6 +249,102 @@ void tst_QCollator::state()
 
 }
 
+static QStringList stringsToSort(int count)
+{
+    // few enough different strings to have many duplicates
+    static const char *const words[] = {
+        "apple", "Apple", "APPLE", "\xc3\xa4pfel", "\xc3\x84pfel", "zebra", "Zebra",
+        "\xc3\xa5s", "\xc3\xb6l", "test 9", "test 19", "test_19", "test.19", "test,19",
+        "42", "4", "-", "", "\xe6\x97\xa5\xe6\x9c\xac", "\xce\xb1\xce\xb2\xce\xb3"
+    };
+    QRandomGenerator rng(count);
+    QStringList strings;
+    strings.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QString string = QString::fromUtf8(words[rng.bounded(int(std::size(words)))]);
+        if (i % 3)
+            string += QString::number(rng.bounded(100));
+        strings.append(string);
+    }
+    return strings;
+}
+
+void tst_QCollator::sortKeys_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("useThreadPool");
+
+    for (const char *locale : { "C", "en_US", "sv_SE" }) {
+        for (int count : { 0, 1, 100, 5000 }) {
+            QTest::addRow("%s-%d", locale, count) << QString::fromLatin1(locale) << count << false;
+            QTest::addRow("%s-%d-pool", locale, count) << QString::fromLatin1(locale) << count << true;
+        }
+    }
+}
+
+void tst_QCollator::sortKeys()
+{
+    QFETCH(QString, locale);
+    QFETCH(int, count);
+    QFETCH(bool, useThreadPool);
+#ifdef Q_OS_DARWIN
+    if (locale == QLatin1String("C"))
+        QSKIP("Sort keys are not supported with the C locale on Darwin");
+#endif
+
+    QCollator collator((QLocale(locale)));
+    const QStringList strings = stringsToSort(count);
+    QThreadPool threadPool;
+    const QList<QCollatorSortKey> keys =
+            collator.sortKeys(strings, useThreadPool ? &threadPool : nullptr);
+    QCOMPARE(keys.size(), strings.size());
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(keys.at(i).compare(collator.sortKey(strings.at(i))), 0);
+    for (int i = 1; i < count; ++i) {
+        const QString &s1 = strings.at(i - 1);
+        const QString &s2 = strings.at(i);
+        if (s1.isEmpty() || s2.isEmpty())
+            continue;
+        QCOMPARE(qBound(-1, keys.at(i - 1).compare(keys.at(i)), 1),
+                 qBound(-1, collator.compare(s1, s2), 1));
+    }
+}
+
+void tst_QCollator::sort_data()
+{
+    sortKeys_data();
+    // enough strings to sort in several runs, which then get merged
+    for (int count : { 13000, 20000 })
+        QTest::addRow("en_US-%d-pool", count) << QStringLiteral("en_US") << count << true;
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(QString, locale);
+    QFETCH(int, count);
+    QFETCH(bool, useThreadPool);
+
+    QCollator collator((QLocale(locale)));
+    QStringList strings = stringsToSort(count);
+    QStringList expected = strings;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(3);
+    collator.sort(strings, useThreadPool ? &threadPool : nullptr);
+    QCOMPARE(strings, expected);
+
+    // and honors the options of the collator
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.setNumericMode(true);
+    expected = stringsToSort(count);
+    std::stable_sort(expected.begin(), expected.end(), collator);
+    strings = stringsToSort(count);
+    collator.sort(strings, useThreadPool ? &threadPool : nullptr);
+    QCOMPARE(strings, expected);
+}
+
 QTEST_APPLESS_MAIN(tst_QCollator)
 
 #include "tst_qcollator.moc"
@@ -89,6 +89,8 @@ private slots:
     void doubleToString();
     void strtod_data();
     void strtod();
+    void cLocaleNumberFormatting();
+    void cLocaleNumberRoundTrip();
     void long_long_conversion_data();
     void long_long_conversion();
     void long_long_conversion_extra();
@@ -1296,6 +1298,86 @@ void tst_QLocale::strtod()
     QCOMPARE(actualOk, ok);
 }
 
+static QList<double> numbersToFormat()
+{
+    QList<double> numbers = {
+        0.0, -0.0, 1.0, -1.0, 0.1, 0.5, 1.5, 2.5, 10.0, 100.0, 123456.0, 1234567.0,
+        1e-5, 1e-4, 0.001, 1e15, 1e16, 1e17, 1e21, 1e22, 9.999999e22, 1e100, 1e-100,
+        123e-20, 0.3, 2.0 / 3.0, M_PI, -M_E, 4503599627370496.5, 9007199254740993.0,
+        std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::min(), std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::epsilon(),
+        qInf(), -qInf(), qQNaN()
+    };
+
+    // and random ones, of all magnitudes
+    QRandomGenerator rng(1234);
+    for (int i = 0; i < 2000; ++i) {
+        double d;
+        do {
+            const quint64 bits = rng.generate64();
+            memcpy(&d, &bits, sizeof(d));
+        } while (!qIsFinite(d));
+        numbers.append(d);
+        numbers.append(double(rng.bounded(1000000)) / 100);
+    }
+    return numbers;
+}
+
+void tst_QLocale::cLocaleNumberFormatting()
+{
+    // QString::number() and QByteArray::number() have their own code for the
+    // C locale; it must give the same results as QLocale::toString()
+    const QLocale c = QLocale::c();
+    const char formats[] = { 'e', 'E', 'f', 'F', 'g', 'G' };
+    const int precisions[] = { QLocale::FloatingPointShortest, -1, 0, 1, 2, 6, 12, 17, 25 };
+
+    for (double d : numbersToFormat()) {
+        for (char format : formats) {
+            for (int precision : precisions) {
+                const QString expected = c.toString(d, format, precision);
+                const QString actual = QString::number(d, format, precision);
+                if (actual != expected) {
+                    qDebug("%a formatted as '%c' with precision %d", d, format, precision);
+                    QCOMPARE(actual, expected);
+                }
+                QCOMPARE(QByteArray::number(d, format, precision), expected.toLatin1());
+            }
+        }
+    }
+
+    // results too long for the fast path's internal buffer
+    QCOMPARE(QString::number(1e300, 'f', 2), c.toString(1e300, 'f', 2));
+    QCOMPARE(QByteArray::number(-1e300, 'f', 2), c.toString(-1e300, 'f', 2).toLatin1());
+    QCOMPARE(QString::number(0.1, 'f', 100), c.toString(0.1, 'f', 100));
+}
+
+void tst_QLocale::cLocaleNumberRoundTrip()
+{
+    for (double d : numbersToFormat()) {
+        if (!qIsFinite(d))
+            continue;
+
+        const QByteArray shortest = QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
+        bool ok = false;
+        const double parsed = shortest.toDouble(&ok);
+        QVERIFY2(ok, shortest.constData());
+        QVERIFY2(memcmp(&parsed, &d, sizeof(d)) == 0 || (d == 0 && parsed == 0),
+                 shortest.constData());
+
+        // these have more digits than needed, which must be rounded correctly
+        for (char format : { 'e', 'f' }) {
+            const QByteArray formatted = QByteArray::number(d, format, 25);
+            ok = false;
+            QCOMPARE(formatted.toDouble(&ok), std::strtod(formatted.constData(), nullptr));
+            QVERIFY(ok || std::abs(d) < 1e-25);
+            ok = false;
+            QCOMPARE(QString::fromLatin1(formatted).toDouble(&ok),
+                     std::strtod(formatted.constData(), nullptr));
+        }
+    }
+}
+
 void tst_QLocale::long_long_conversion_data()
 {
     QTest::addColumn<QString>("locale_name");
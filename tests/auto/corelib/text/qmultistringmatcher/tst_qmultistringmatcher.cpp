@@ -0,0 +1,366 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qmultistringmatcher.h>
+#include <QtCore/qrandom.h>
+
+#include <algorithm>
+
+Q_DECLARE_METATYPE(Qt::CaseSensitivity)
+
+using Match = QMultiStringMatcher::Match;
+
+static QString toString(const Match &match)
+{
+    return QString::fromLatin1("%1+%2:%3").arg(match.position).arg(match.length).arg(match.pattern);
+}
+
+static QStringList toStrings(const QList<Match> &matches)
+{
+    QStringList result;
+    for (const Match &match : matches)
+        result.append(toString(match));
+    return result;
+}
+
+static QList<Match> sorted(QList<Match> matches)
+{
+    std::sort(matches.begin(), matches.end(), [](const Match &lhs, const Match &rhs) {
+        if (lhs.position != rhs.position)
+            return lhs.position < rhs.position;
+        if (lhs.length != rhs.length)
+            return lhs.length > rhs.length;
+        return lhs.pattern < rhs.pattern;
+    });
+    return matches;
+}
+
+// the obvious way: one QString::indexOf() pass per pattern
+static QList<Match> referenceMatches(const QStringList &patterns, const QString &str,
+                                     Qt::CaseSensitivity cs)
+{
+    QList<Match> matches;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        if (pattern.isEmpty())
+            continue;
+        for (qsizetype pos = str.indexOf(pattern, 0, cs); pos >= 0; pos = str.indexOf(pattern, pos + 1, cs))
+            matches.append({ pos, pattern.size(), i });
+    }
+    return sorted(matches);
+}
+
+static QList<Match> referenceMatches(const QByteArrayList &patterns, const QByteArray &data,
+                                     Qt::CaseSensitivity cs)
+{
+    const auto fold = [cs](char c) {
+        return cs == Qt::CaseInsensitive && c >= 'A' && c <= 'Z' ? char(c | 0x20) : c;
+    };
+    QList<Match> matches;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QByteArray &pattern = patterns.at(i);
+        if (pattern.isEmpty())
+            continue;
+        for (qsizetype pos = 0; pos + pattern.size() <= data.size(); ++pos) {
+            qsizetype j = 0;
+            while (j < pattern.size() && fold(data.at(pos + j)) == fold(pattern.at(j)))
+                ++j;
+            if (j == pattern.size())
+                matches.append({ pos, pattern.size(), i });
+        }
+    }
+    return sorted(matches);
+}
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructed();
+    void patterns();
+    void copyAndSwap();
+    void indexIn_data();
+    void indexIn();
+    void allMatches_data();
+    void allMatches();
+    void from();
+    void byteArrays();
+    void caseInsensitiveByteArrays();
+    void random_data();
+    void random();
+};
+
+void tst_QMultiStringMatcher::defaultConstructed()
+{
+    QMultiStringMatcher matcher;
+    QCOMPARE(matcher.patternCount(), 0);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(!matcher.indexIn(u"foo").isValid());
+    QVERIFY(!matcher.indexIn("foo").isValid());
+    QVERIFY(matcher.allMatches(u"foo").isEmpty());
+
+    const Match invalid;
+    QVERIFY(!invalid.isValid());
+    QCOMPARE(invalid.position, -1);
+    QCOMPARE(invalid.pattern, -1);
+}
+
+void tst_QMultiStringMatcher::patterns()
+{
+    const QStringList patterns = { QStringLiteral("foo"), QString(), QStringLiteral("bär") };
+    QMultiStringMatcher matcher(patterns, Qt::CaseInsensitive);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.patternCount(), 3);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+
+    QMultiStringMatcher fromUtf8(QByteArrayList{ "foo", QByteArray(), "b\xc3\xa4r" });
+    QCOMPARE(fromUtf8.patterns(), patterns);
+    QCOMPARE(fromUtf8.caseSensitivity(), Qt::CaseSensitive);
+
+    // empty patterns never match
+    QCOMPARE(toStrings(matcher.allMatches(u"BÄR food")),
+             QStringList({ "0+3:2", "4+3:0" }));
+}
+
+void tst_QMultiStringMatcher::copyAndSwap()
+{
+    QMultiStringMatcher matcher({ QStringLiteral("abc") });
+    QMultiStringMatcher copy = matcher;
+    QCOMPARE(copy.indexIn(u"xabc").position, 1);
+
+    QMultiStringMatcher other({ QStringLiteral("x") });
+    other.swap(copy);
+    QCOMPARE(copy.indexIn(u"xabc").position, 0);
+    QCOMPARE(other.indexIn(u"xabc").position, 1);
+
+    copy = std::move(other);
+    QCOMPARE(copy.indexIn(u"xabc").position, 1);
+    other = matcher;
+    QCOMPARE(other.patterns(), matcher.patterns());
+}
+
+void tst_QMultiStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<qsizetype>("position");
+    QTest::addColumn<qsizetype>("length");
+    QTest::addColumn<qsizetype>("pattern");
+
+    const QStringList words = { "he", "she", "his", "hers" };
+    QTest::newRow("none") << words << Qt::CaseSensitive << "abcdef"
+                          << qsizetype(-1) << qsizetype(0) << qsizetype(-1);
+    QTest::newRow("empty-haystack") << words << Qt::CaseSensitive << QString()
+                                    << qsizetype(-1) << qsizetype(0) << qsizetype(-1);
+    QTest::newRow("single") << words << Qt::CaseSensitive << "xxhixxhis"
+                            << qsizetype(6) << qsizetype(3) << qsizetype(2);
+    QTest::newRow("leftmost") << words << Qt::CaseSensitive << "ushers"
+                              << qsizetype(1) << qsizetype(3) << qsizetype(1);
+    QTest::newRow("longest") << QStringList{ "bc", "abcd", "ab" } << Qt::CaseSensitive << "xabcd"
+                             << qsizetype(1) << qsizetype(4) << qsizetype(1);
+    QTest::newRow("duplicates") << QStringList{ "x", "ab", "ab" } << Qt::CaseSensitive << "-ab-"
+                                << qsizetype(1) << qsizetype(2) << qsizetype(1);
+    QTest::newRow("case-sensitive") << words << Qt::CaseSensitive << "SHE said hi"
+                                    << qsizetype(-1) << qsizetype(0) << qsizetype(-1);
+    QTest::newRow("case-insensitive") << words << Qt::CaseInsensitive << "SHE said hi"
+                                      << qsizetype(0) << qsizetype(3) << qsizetype(1);
+    QTest::newRow("case-insensitive-non-latin1")
+            << QStringList{ QStringLiteral("ωΔ") } << Qt::CaseInsensitive
+            << QStringLiteral("--Ωδ") << qsizetype(2) << qsizetype(2) << qsizetype(0);
+    QTest::newRow("surrogates")
+            << QStringList{ QStringLiteral("\U0001F600") } << Qt::CaseSensitive
+            << QStringLiteral("\U0001F601\U0001F600") << qsizetype(2) << qsizetype(2) << qsizetype(0);
+    QTest::newRow("end") << QStringList{ "abc" } << Qt::CaseSensitive << "xxabc"
+                         << qsizetype(2) << qsizetype(3) << qsizetype(0);
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, haystack);
+    QFETCH(qsizetype, position);
+    QFETCH(qsizetype, length);
+    QFETCH(qsizetype, pattern);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    const Match match = matcher.indexIn(haystack);
+    QCOMPARE(match.isValid(), position >= 0);
+    QCOMPARE(match.position, position);
+    QCOMPARE(match.length, length);
+    QCOMPARE(match.pattern, pattern);
+}
+
+void tst_QMultiStringMatcher::allMatches_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QStringList>("matches");
+
+    const QStringList words = { "he", "she", "his", "hers" };
+    QTest::newRow("none") << words << Qt::CaseSensitive << "abcdef" << QStringList();
+    QTest::newRow("overlapping") << words << Qt::CaseSensitive << "ushers"
+                                 << QStringList{ "1+3:1", "2+4:3", "2+2:0" };
+    QTest::newRow("repeated") << QStringList{ "aa" } << Qt::CaseSensitive << "aaaa"
+                              << QStringList{ "0+2:0", "1+2:0", "2+2:0" };
+    QTest::newRow("nested") << QStringList{ "a", "abc", "b", "bc" } << Qt::CaseSensitive << "abc"
+                            << QStringList{ "0+3:1", "0+1:0", "1+2:3", "1+1:2" };
+    QTest::newRow("duplicates") << QStringList{ "ab", "x", "ab" } << Qt::CaseSensitive << "abab"
+                                << QStringList{ "0+2:0", "0+2:2", "2+2:0", "2+2:2" };
+    QTest::newRow("case-insensitive-variants")
+            << QStringList{ "AB", "ab" } << Qt::CaseInsensitive << "aB"
+            << QStringList{ "0+2:0", "0+2:1" };
+}
+
+void tst_QMultiStringMatcher::allMatches()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, haystack);
+    QFETCH(QStringList, matches);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    QCOMPARE(toStrings(matcher.allMatches(haystack)), matches);
+    QCOMPARE(toStrings(matcher.allMatches(haystack.toUtf8())), matches);
+}
+
+void tst_QMultiStringMatcher::from()
+{
+    const QMultiStringMatcher matcher({ QStringLiteral("ab"), QStringLiteral("b") });
+    const QString haystack = QStringLiteral("abab");
+
+    QCOMPARE(toString(matcher.indexIn(haystack, 0)), QLatin1String("0+2:0"));
+    QCOMPARE(toString(matcher.indexIn(haystack, 1)), QLatin1String("1+1:1"));
+    QCOMPARE(toString(matcher.indexIn(haystack, 2)), QLatin1String("2+2:0"));
+    QCOMPARE(toString(matcher.indexIn(haystack, -1)), QLatin1String("3+1:1"));
+    QCOMPARE(toString(matcher.indexIn(haystack, -100)), QLatin1String("0+2:0"));
+    QVERIFY(!matcher.indexIn(haystack, 4).isValid());
+    QVERIFY(!matcher.indexIn(haystack, 100).isValid());
+
+    QCOMPARE(toStrings(matcher.allMatches(haystack, 1)), QStringList({ "1+1:1", "2+2:0", "3+1:1" }));
+    QCOMPARE(toStrings(matcher.allMatches(haystack, -2)), QStringList({ "2+2:0", "3+1:1" }));
+    QVERIFY(matcher.allMatches(haystack, 4).isEmpty());
+}
+
+void tst_QMultiStringMatcher::byteArrays()
+{
+    // byte positions and lengths count UTF-8 code units
+    const QMultiStringMatcher matcher({ QStringLiteral("über"), QStringLiteral("€") });
+    const QByteArray data = "5\xe2\x82\xac f\xc3\xbcr \xc3\xbc" "ber";
+    QCOMPARE(toStrings(matcher.allMatches(data)), QStringList({ "1+3:1", "10+5:0" }));
+    QCOMPARE(toStrings(matcher.allMatches(QString::fromUtf8(data))), QStringList({ "1+1:1", "7+4:0" }));
+    QCOMPARE(toString(matcher.indexIn(QByteArrayView(data), 4)), QLatin1String("10+5:0"));
+
+    const QMultiStringMatcher utf8Matcher(QByteArrayList{ "\xc3\xbc" "ber", "\xe2\x82\xac" });
+    QCOMPARE(toStrings(utf8Matcher.allMatches(data)), QStringList({ "1+3:1", "10+5:0" }));
+}
+
+void tst_QMultiStringMatcher::caseInsensitiveByteArrays()
+{
+    // only US-ASCII letters are folded in byte arrays
+    const QMultiStringMatcher matcher({ QStringLiteral("ü"), QStringLiteral("Ab") }, Qt::CaseInsensitive);
+    QCOMPARE(toStrings(matcher.allMatches(QByteArray("aB \xc3\x9c \xc3\xbc"))),
+             QStringList({ "0+2:1", "6+2:0" }));
+    QCOMPARE(toStrings(matcher.allMatches(QStringLiteral("aB Ü ü"))),
+             QStringList({ "0+2:1", "3+1:0", "5+1:0" }));
+}
+
+void tst_QMultiStringMatcher::random_data()
+{
+    QTest::addColumn<QString>("alphabet");
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<int>("maxPatternLength");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QString ascii = QStringLiteral("abcAB -");
+    const QString mixed = QStringLiteral("aAbéÉΩωＡａĀā ");
+    for (Qt::CaseSensitivity cs : { Qt::CaseSensitive, Qt::CaseInsensitive }) {
+        const char *suffix = cs == Qt::CaseSensitive ? "-cs" : "-ci";
+        QTest::addRow("ascii-few%s", suffix) << ascii << 3 << 4 << cs;
+        QTest::addRow("ascii-short%s", suffix) << ascii << 40 << 2 << cs;
+        QTest::addRow("ascii-many%s", suffix) << ascii << 200 << 6 << cs;
+        QTest::addRow("mixed-few%s", suffix) << mixed << 3 << 5 << cs;
+        QTest::addRow("mixed-many%s", suffix) << mixed << 100 << 6 << cs;
+    }
+}
+
+void tst_QMultiStringMatcher::random()
+{
+    QFETCH(QString, alphabet);
+    QFETCH(int, patternCount);
+    QFETCH(int, maxPatternLength);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    QRandomGenerator rng(patternCount * 31 + maxPatternLength + int(cs));
+    const auto randomString = [&](int length) {
+        QString s;
+        for (int i = 0; i < length; ++i)
+            s += alphabet.at(rng.bounded(int(alphabet.size())));
+        return s;
+    };
+
+    for (int round = 0; round < 20; ++round) {
+        QStringList patterns;
+        for (int i = 0; i < patternCount; ++i) {
+            // long runs of unrelated text exercise the filter skipping over it
+            patterns.append(randomString(1 + rng.bounded(maxPatternLength)));
+        }
+        QString haystack = randomString(rng.bounded(300));
+        haystack += QString(rng.bounded(100), u'z') + randomString(rng.bounded(40));
+
+        const QMultiStringMatcher matcher(patterns, cs);
+        const QList<Match> expected = referenceMatches(patterns, haystack, cs);
+        QCOMPARE(toStrings(matcher.allMatches(haystack)), toStrings(expected));
+        QCOMPARE(toString(matcher.indexIn(haystack)),
+                 toString(expected.isEmpty() ? Match() : expected.first()));
+
+        const qsizetype from = rng.bounded(int(haystack.size()) + 1);
+        QList<Match> expectedFrom;
+        for (const Match &match : expected) {
+            if (match.position >= from)
+                expectedFrom.append(match);
+        }
+        QCOMPARE(toString(matcher.indexIn(haystack, from)),
+                 toString(expectedFrom.isEmpty() ? Match() : expectedFrom.first()));
+
+        QByteArrayList utf8Patterns;
+        for (const QString &pattern : patterns)
+            utf8Patterns.append(pattern.toUtf8());
+        const QByteArray utf8 = haystack.toUtf8();
+        QCOMPARE(toStrings(matcher.allMatches(utf8)),
+                 toStrings(referenceMatches(utf8Patterns, utf8, cs)));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_qmultistringmatcher.moc"
@@ -36,6 +36,9 @@
 #include <qobject.h>
 #include <qregularexpression.h>
 #include <qthread.h>
+#include <qthreadpool.h>
+
+#include <QtCore/private/qregularexpression_p.h>
 
 Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
 Q_DECLARE_METATYPE(QRegularExpression::MatchType)
@@ -78,6 +81,13 @@ private slots:
     void QStringAndQStringRefEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void compiledPatternCache();
+    void compiledPatternCacheCapacity();
+    void compiledPatternCacheThreadSafety();
+    void jitStackPool();
+    void matchBatch_data();
+    void matchBatch();
+    void matchBatchInvalid();
 
     void wildcard_data();
     void wildcard();
@@ -2150,6 +2160,343 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::compiledPatternCache()
+{
+    QRegularExpressionCache::clear();
+    QRegularExpressionCache::resetStatistics();
+
+    QRegularExpression re1("a(b)(?<name>c)");
+    QVERIFY(re1.isValid());
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 1u);
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 0u);
+    QCOMPARE(QRegularExpressionCache::statistics().count, 1);
+
+    // same pattern, same options: the compiled pattern is shared
+    QRegularExpression re2("a(b)(?<name>c)");
+    QVERIFY(re2.isValid());
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 1u);
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 1u);
+    QCOMPARE(re2.captureCount(), 2);
+    QCOMPARE(re2.namedCaptureGroups(), QStringList({ QString(), QString(), "name" }));
+
+    // different options: compiled separately
+    QRegularExpression re3("a(b)(?<name>c)", QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(re3.isValid());
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 2u);
+    QCOMPARE(QRegularExpressionCache::statistics().count, 2);
+    QVERIFY(re3.match("xABCx").hasMatch());
+    QVERIFY(!re2.match("xABCx").hasMatch());
+
+    // compilation errors are cached too
+    QRegularExpression invalid1("a(b");
+    QVERIFY(!invalid1.isValid());
+    QRegularExpression invalid2("a(b");
+    QVERIFY(!invalid2.isValid());
+    QCOMPARE(invalid2.errorString(), invalid1.errorString());
+    QCOMPARE(invalid2.patternErrorOffset(), invalid1.patternErrorOffset());
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 3u);
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 2u);
+
+    // changing the pattern of a copy doesn't affect the original
+    QRegularExpression re4 = re1;
+    re4.setPattern("a(b)");
+    QVERIFY(re4.isValid());
+    QCOMPARE(re4.captureCount(), 1);
+    QCOMPARE(re1.captureCount(), 2);
+
+    // compiled patterns outlive the cache entries
+    QRegularExpressionCache::clear();
+    QCOMPARE(QRegularExpressionCache::statistics().count, 0);
+    QRegularExpressionMatch match = re1.match("xabcx");
+    QVERIFY(match.hasMatch());
+    QCOMPARE(match.captured("name"), QStringLiteral("c"));
+    QCOMPARE(match.capturedStart(), 1);
+
+    QRegularExpressionCache::resetStatistics();
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 0u);
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 0u);
+}
+
+void tst_QRegularExpression::compiledPatternCacheCapacity()
+{
+    const qsizetype oldCapacity = QRegularExpressionCache::capacity();
+    auto restoreCapacity = qScopeGuard([oldCapacity] {
+        QRegularExpressionCache::setCapacity(oldCapacity);
+    });
+
+    QRegularExpressionCache::clear();
+    QRegularExpressionCache::setCapacity(2);
+    QRegularExpressionCache::resetStatistics();
+    QCOMPARE(QRegularExpressionCache::capacity(), 2);
+    QCOMPARE(QRegularExpressionCache::statistics().capacity, 2);
+
+    QVERIFY(QRegularExpression("one").isValid());
+    QVERIFY(QRegularExpression("two").isValid());
+    QVERIFY(QRegularExpression("one").isValid());
+    QVERIFY(QRegularExpression("three").isValid()); // evicts "two"
+    QCOMPARE(QRegularExpressionCache::statistics().count, 2);
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 1u);
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 3u);
+
+    QVERIFY(QRegularExpression("one").isValid());
+    QVERIFY(QRegularExpression("two").isValid());
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 2u);
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 4u);
+
+    // a capacity of 0 disables the cache
+    QRegularExpressionCache::setCapacity(0);
+    QCOMPARE(QRegularExpressionCache::statistics().count, 0);
+    QRegularExpressionCache::resetStatistics();
+    for (int i = 0; i < 3; ++i) {
+        QRegularExpression re("t(w)o");
+        QCOMPARE(re.match("one two").captured(1), QStringLiteral("w"));
+    }
+    QCOMPARE(QRegularExpressionCache::statistics().count, 0);
+    QCOMPARE(QRegularExpressionCache::statistics().hits, 0u);
+    QCOMPARE(QRegularExpressionCache::statistics().misses, 3u);
+
+    QRegularExpressionCache::setCapacity(-1);
+    QCOMPARE(QRegularExpressionCache::capacity(), 0);
+}
+
+class CompilerThread : public QThread
+{
+public:
+    explicit CompilerThread(const QStringList &patterns, QObject *parent = nullptr)
+        : QThread(parent),
+          m_patterns(patterns)
+    {
+    }
+
+    int failures = 0;
+
+private:
+    static const int COMPILE_ITERATIONS = 20;
+
+    void run() override
+    {
+        for (int i = 0; i < COMPILE_ITERATIONS; ++i) {
+            for (const QString &pattern : m_patterns) {
+                // each pattern is of the form "(\d+)-<n>", for n in 0..9
+                QRegularExpression re(pattern);
+                const QString subject = QStringLiteral("x123-") + pattern.back();
+                if (re.match(subject).captured(1) != QLatin1String("123"))
+                    ++failures;
+            }
+        }
+    }
+
+    const QStringList &m_patterns;
+};
+
+void tst_QRegularExpression::compiledPatternCacheThreadSafety()
+{
+    QStringList patterns;
+    for (int i = 0; i < 10; ++i)
+        patterns.append(QLatin1String("(\\d+)-") + QString::number(i));
+
+    const qsizetype oldCapacity = QRegularExpressionCache::capacity();
+    auto restoreCapacity = qScopeGuard([oldCapacity] {
+        QRegularExpressionCache::setCapacity(oldCapacity);
+    });
+
+    // a capacity smaller than the number of patterns makes the threads
+    // race on evictions, too
+    for (int capacity : { 4, 64 }) {
+        QRegularExpressionCache::clear();
+        QRegularExpressionCache::setCapacity(capacity);
+        QRegularExpressionCache::resetStatistics();
+
+        const int threadCount = qMax(QThread::idealThreadCount(), 4);
+        QList<CompilerThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            CompilerThread *thread = new CompilerThread(patterns);
+            thread->start();
+            threads.push_back(thread);
+        }
+
+        int failures = 0;
+        for (CompilerThread *thread : qAsConst(threads)) {
+            thread->wait();
+            failures += thread->failures;
+        }
+        qDeleteAll(threads);
+
+        QCOMPARE(failures, 0);
+        const QRegularExpressionCache::Statistics statistics = QRegularExpressionCache::statistics();
+        QCOMPARE(statistics.hits + statistics.misses, quint64(threadCount * 20 * patterns.size()));
+        QVERIFY(statistics.count <= capacity);
+    }
+}
+
+class JitStackThread : public QThread
+{
+public:
+    void run() override
+    {
+        // this pattern causes enough backtracking to need a JIT stack
+        // bigger than the default one (see pcreJitStackUsage)
+        QRegularExpression re("(?(R)a*(?1)|((?R))b)");
+        re.match("aaaaaaabcde");
+    }
+};
+
+void tst_QRegularExpression::jitStackPool()
+{
+    const qsizetype oldStartSize = QRegularExpressionJitStackPool::stackStartSize();
+    const qsizetype oldMaximumSize = QRegularExpressionJitStackPool::stackMaximumSize();
+    const qsizetype oldCapacity = QRegularExpressionJitStackPool::capacity();
+    auto restore = qScopeGuard([=] {
+        QRegularExpressionJitStackPool::setStackSize(oldStartSize, oldMaximumSize);
+        QRegularExpressionJitStackPool::setCapacity(oldCapacity);
+    });
+
+    QTest::ignoreMessage(QtWarningMsg, "QRegularExpressionJitStackPool::setStackSize: invalid sizes 2048, 1024");
+    QRegularExpressionJitStackPool::setStackSize(2048, 1024);
+    QCOMPARE(QRegularExpressionJitStackPool::stackStartSize(), oldStartSize);
+    QCOMPARE(QRegularExpressionJitStackPool::stackMaximumSize(), oldMaximumSize);
+
+    QRegularExpressionJitStackPool::setStackSize(64 * 1024, 256 * 1024);
+    QCOMPARE(QRegularExpressionJitStackPool::stackStartSize(), 64 * 1024);
+    QCOMPARE(QRegularExpressionJitStackPool::stackMaximumSize(), 256 * 1024);
+    QCOMPARE(QRegularExpressionJitStackPool::count(), 0);
+
+    QRegularExpressionJitStackPool::setCapacity(1);
+    QCOMPARE(QRegularExpressionJitStackPool::capacity(), 1);
+
+    // Each thread that needs a JIT stack gives it back to the pool when it
+    // exits; the next thread reuses it. Whether a stack is needed at all
+    // depends on the JIT being enabled.
+    for (int i = 0; i < 3; ++i) {
+        JitStackThread thread;
+        thread.start();
+        QVERIFY(thread.wait());
+        QVERIFY(QRegularExpressionJitStackPool::count() <= 1);
+    }
+
+    // several threads at once: only as many as the capacity are kept
+    {
+        QList<JitStackThread *> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.append(new JitStackThread);
+            threads.last()->start();
+        }
+        for (JitStackThread *thread : qAsConst(threads))
+            QVERIFY(thread->wait());
+        qDeleteAll(threads);
+        QVERIFY(QRegularExpressionJitStackPool::count() <= 1);
+    }
+
+    QRegularExpressionJitStackPool::clear();
+    QCOMPARE(QRegularExpressionJitStackPool::count(), 0);
+
+    // a capacity of 0 disables the pool
+    QRegularExpressionJitStackPool::setCapacity(0);
+    JitStackThread thread;
+    thread.start();
+    QVERIFY(thread.wait());
+    QCOMPARE(QRegularExpressionJitStackPool::count(), 0);
+}
+
+void tst_QRegularExpression::matchBatch_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<int>("capturedGroupCount");
+    QTest::addColumn<bool>("useThreadPool");
+
+    for (bool useThreadPool : { false, true }) {
+        const char *suffix = useThreadPool ? "-threadpool" : "";
+        QTest::addRow("plain%s", suffix) << "fox" << 1 << useThreadPool;
+        QTest::addRow("groups%s", suffix) << "(\\w+) (\\d+)(x)?" << 4 << useThreadPool;
+        QTest::addRow("fewer-groups%s", suffix) << "(\\w+) (\\d+)" << 2 << useThreadPool;
+        QTest::addRow("more-groups%s", suffix) << "(\\w+)" << 5 << useThreadPool;
+        QTest::addRow("empty-match%s", suffix) << "\\d*" << 1 << useThreadPool;
+        QTest::addRow("anchored%s", suffix) << "^the" << 1 << useThreadPool;
+    }
+}
+
+void tst_QRegularExpression::matchBatch()
+{
+    QFETCH(QString, pattern);
+    QFETCH(int, capturedGroupCount);
+    QFETCH(bool, useThreadPool);
+
+    const QStringList samples = {
+        "the quick fox 123",
+        "the quick fox 123x",
+        "abc",
+        "",
+        "the lazy dog 9",
+        "über 42",
+        QString(),
+        "🦊 fox 7",
+    };
+    // enough subjects for the thread pool to be used
+    QStringList storage;
+    for (int i = 0; i < 5000; ++i)
+        storage.append(samples.at(i % samples.size()) + QString(i % 3, QLatin1Char(' ')));
+    storage[100] = QString();
+    QList<QStringView> subjects;
+    for (const QString &string : qAsConst(storage))
+        subjects.append(string);
+
+    const QRegularExpression re(pattern);
+    QVERIFY(re.isValid());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+
+    const qsizetype size = subjects.size() * capturedGroupCount;
+    QList<qsizetype> starts(size, -2);
+    QList<qsizetype> lengths(size, -2);
+    const qsizetype matched = re.matchBatch(subjects.constData(), subjects.size(),
+                                            starts.data(), lengths.data(), capturedGroupCount,
+                                            QRegularExpression::NoMatchOption,
+                                            useThreadPool ? &pool : nullptr);
+
+    qsizetype expectedMatched = 0;
+    for (qsizetype i = 0; i < subjects.size(); ++i) {
+        const QRegularExpressionMatch match = re.match(subjects.at(i));
+        QVERIFY(match.isValid());
+        if (match.hasMatch())
+            ++expectedMatched;
+        for (int group = 0; group < capturedGroupCount; ++group) {
+            const qsizetype index = i * capturedGroupCount + group;
+            if (match.hasMatch() && group <= match.lastCapturedIndex()
+                    && match.capturedStart(group) != -1) {
+                QCOMPARE(starts.at(index), match.capturedStart(group));
+                QCOMPARE(lengths.at(index), match.capturedLength(group));
+            } else {
+                QCOMPARE(starts.at(index), -1);
+                QCOMPARE(lengths.at(index), 0);
+            }
+        }
+    }
+    QCOMPARE(matched, expectedMatched);
+
+    // nothing to match
+    QCOMPARE(re.matchBatch(subjects.constData(), 0, starts.data(), lengths.data()), 0);
+}
+
+void tst_QRegularExpression::matchBatchInvalid()
+{
+    const QStringView subjects[] = { u"abc", u"(abc" };
+    qsizetype starts[4] = { -2, -2, -2, -2 };
+    qsizetype lengths[4] = { -2, -2, -2, -2 };
+
+    const QRegularExpression invalid("(abc");
+    QTest::ignoreMessage(QtWarningMsg, "QRegularExpression::matchBatch(): called on an invalid QRegularExpression object");
+    QCOMPARE(invalid.matchBatch(subjects, 2, starts, lengths, 2), 0);
+    for (int i = 0; i < 4; ++i) {
+        QCOMPARE(starts[i], -1);
+        QCOMPARE(lengths[i], 0);
+    }
+
+    const QRegularExpression re("abc");
+    QTest::ignoreMessage(QtWarningMsg, "QRegularExpression::matchBatch: capturedGroupCount must be positive");
+    QCOMPARE(re.matchBatch(subjects, 2, starts, lengths, 0), 0);
+}
+
 void tst_QRegularExpression::wildcard_data()
 {
     QTest::addColumn<QString>("pattern");
@@ -598,6 +598,8 @@ private slots:
     void toHtmlEscaped();
     void operatorGreaterWithQLatin1String();
     void compareQLatin1Strings();
+    void compareCaseInsensitiveLong_data();
+    void compareCaseInsensitiveLong();
     void fromQLatin1StringWithLength();
     void assignQLatin1String();
     void assignQChar();
@@ -6844,6 +6846,53 @@ void tst_QString::compareQLatin1Strings()
     QVERIFY(!(subab >= subabc));
 }
 
+void tst_QString::compareCaseInsensitiveLong_data()
+{
+    QTest::addColumn<QString>("alphabet");
+
+    QTest::newRow("ascii") << QStringLiteral("aBcYz09-_ @[`{");
+    QTest::newRow("latin1") << QStringLiteral("aBz-\u00e9\u00c9\u00fc\u00dc\u00d7\u00f7\u00de\u00fe");
+    QTest::newRow("unicode") << QStringLiteral("aBz-\u00e9\u03a3\u03c3\u0416\u0436\u2000\uff21\uff41");
+}
+
+void tst_QString::compareCaseInsensitiveLong()
+{
+    // exercise the vectorized comparisons with all lengths and positions of
+    // the first difference, against comparing the case-folded strings
+    QFETCH(QString, alphabet);
+    const bool isLatin1 = std::all_of(alphabet.cbegin(), alphabet.cend(),
+                                      [](QChar c) { return c.unicode() < 0x100; });
+    const auto sign = [](int x) { return x < 0 ? -1 : x > 0 ? 1 : 0; };
+
+    QRandomGenerator rng(int(alphabet.size()));
+    const auto randomChar = [&]() { return alphabet.at(rng.bounded(int(alphabet.size()))); };
+    for (int length = 0; length < 70; ++length) {
+        QString lhs;
+        for (int i = 0; i < length; ++i)
+            lhs += randomChar();
+        for (int pos = -1; pos < length; ++pos) {
+            QString rhs = lhs;
+            for (QChar &c : rhs)
+                c = rng.bounded(2) ? c.toUpper() : c.toLower();
+            if (pos >= 0)
+                rhs[pos] = randomChar();
+            if (rng.bounded(4) == 0)
+                rhs.chop(rng.bounded(int(rhs.size()) + 1));
+
+            const int expected = sign(lhs.toCaseFolded().compare(rhs.toCaseFolded()));
+            QCOMPARE(sign(lhs.compare(rhs, Qt::CaseInsensitive)), expected);
+            QCOMPARE(sign(rhs.compare(lhs, Qt::CaseInsensitive)), -expected);
+            if (isLatin1) {
+                const QByteArray lhsLatin1 = lhs.toLatin1();
+                const QByteArray rhsLatin1 = rhs.toLatin1();
+                QCOMPARE(sign(lhs.compare(QLatin1String(rhsLatin1), Qt::CaseInsensitive)), expected);
+                QCOMPARE(sign(QLatin1String(lhsLatin1).compare(QLatin1String(rhsLatin1),
+                                                               Qt::CaseInsensitive)), expected);
+            }
+        }
+    }
+}
+
 void tst_QString::fromQLatin1StringWithLength()
 {
     QLatin1String latin1foo("foobar", 3);
@@ -29,6 +29,8 @@
 
 #include <QtTest/QtTest>
 
+#include <qcborstreamwriter.h>
+#include <qcborvalue.h>
 #include <qstringconverter.h>
 #include <qthreadpool.h>
 
@@ -57,6 +59,9 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8LongMixed_data();
+    void utf8LongMixed();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1421,6 +1426,98 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+void tst_QStringConverter::utf8LongMixed_data()
+{
+    QTest::addColumn<QList<QByteArray>>("pieces");
+    QTest::addColumn<bool>("valid");
+
+    const QList<QByteArray> twoBytes = {
+        "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82", " ", ", ",
+        "\xce\xb1\xce\xb2", "\xc2\x80", "\xdf\xbf", "\xc3\x9f"
+    };
+    const QList<QByteArray> threeBytes = {
+        "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xe3\x80\x82", "\xe2\x82\xac",
+        "\xe0\xa0\x80", "\xed\x9f\xbf", "\xee\x80\x80", "\xef\xbf\xbf"
+    };
+    const QList<QByteArray> ascii = { "a", "Qt ", "0123456789" };
+    const QList<QByteArray> fourBytes = { "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf" };
+    // each followed by an ASCII character, see utf8LongMixed()
+    const QList<QByteArray> invalid = {
+        "\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xe0\x9f\xbf", "\xed\xa0\x80",
+        "\xed\xbf\xbf", "\x80", "\xbf\xbf", "\xe4\xb8", "\xc2", "\xf8\x88\x80\x80\x80",
+        "\xf4\x90\x80\x80", "\xff"
+    };
+
+    QTest::newRow("two-bytes") << twoBytes << true;
+    QTest::newRow("three-bytes") << threeBytes << true;
+    QTest::newRow("two-three-bytes") << twoBytes + threeBytes << true;
+    QTest::newRow("mixed") << twoBytes + threeBytes + ascii << true;
+    QTest::newRow("four-bytes") << twoBytes + threeBytes + fourBytes << true;
+    QTest::newRow("invalid") << twoBytes + threeBytes + invalid << false;
+}
+
+// Checks long runs of multi-byte characters, which are handled in blocks by
+// the SIMD code, against the same characters converted one at a time.
+void tst_QStringConverter::utf8LongMixed()
+{
+    QFETCH(QList<QByteArray>, pieces);
+    QFETCH(bool, valid);
+
+    // pick pieces pseudo-randomly and decode them individually
+    QByteArray text;
+    QString expected;
+    QByteArray expectedEncoded;
+    uint state = 1;
+    for (int i = 0; i < 300; ++i) {
+        state = state * 1103515245 + 12345;
+        QByteArray piece = pieces.at((state >> 16) % pieces.size());
+        // an invalid sequence followed by a continuation byte could
+        // resynchronize differently
+        if (!valid)
+            piece += '-';
+        const QString decoded = QString::fromUtf8(piece);
+        text += piece;
+        expected += decoded;
+        expectedEncoded += decoded.toUtf8();
+    }
+
+    for (int offset = 0; offset < 16; ++offset) {
+        const QByteArray data = QByteArray(offset, 'x') + text;
+        const QString string = QString(offset, u'x') + expected;
+
+        QCOMPARE(QString::fromUtf8(data), string);
+
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QCOMPARE(QString(decoder(data)), string);
+        QCOMPARE(decoder.hasError(), !valid);
+
+        // errors split between chunks may be reported differently
+        if (valid) {
+            QStringDecoder chunked(QStringDecoder::Utf8);
+            QString decoded;
+            for (qsizetype i = 0; i < data.size(); i += 37)
+                decoded += chunked(data.mid(i, 37));
+            QCOMPARE(decoded, string);
+        }
+
+        const QByteArray encoded = QByteArray(offset, 'x') + expectedEncoded;
+        QCOMPARE(string.toUtf8(), encoded);
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        QCOMPARE(QByteArray(encoder(string)), encoded);
+        QVERIFY(!encoder.hasError());
+        if (valid)
+            QCOMPARE(encoded, data);
+
+        // QCborValue validates UTF-8 text strings
+        QByteArray cbor;
+        QCborStreamWriter writer(&cbor);
+        writer.appendTextString(data.constData(), data.size());
+        QCborParserError error;
+        QCborValue::fromCbor(cbor, &error);
+        QCOMPARE(error.error == QCborError::NoError, valid);
+    }
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
@@ -11,6 +11,7 @@ SUBDIRS = \
     qcollator \
     qlatin1string \
     qlocale \
+    qmultistringmatcher \
     qregularexpression \
     qstring \
     qstring_no_cast_from_bytearray \
@@ -39,6 +39,7 @@
 
 #ifdef Q_OS_UNIX
 #include <pthread.h>
+#include <sched.h>
 #endif
 #if defined(Q_OS_WIN)
 #include <windows.h>
@@ -64,6 +65,7 @@ private slots:
     void isRunning();
     void setPriority();
     void setStackSize();
+    void setCpuAffinity();
     void exit();
     void start();
     void terminate();
@@ -408,6 +410,40 @@ void tst_QThread::setStackSize()
     QCOMPARE(thread.stackSize(), 0u);
 }
 
+class CurrentCpu_Thread : public QThread
+{
+public:
+    int cpu = -1;
+    void run() override
+    {
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+        cpu = sched_getcpu();
+#endif
+    }
+};
+
+void tst_QThread::setCpuAffinity()
+{
+    CurrentCpu_Thread thread;
+    QVERIFY(thread.cpuAffinity().isEmpty());
+    thread.setCpuAffinity({ 0, 2 });
+    QCOMPARE(thread.cpuAffinity(), QList<int>({ 0, 2 }));
+    thread.setCpuAffinity({});
+    QVERIFY(thread.cpuAffinity().isEmpty());
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    // pin the thread to a CPU we are allowed to run on
+    const int cpu = sched_getcpu();
+    QVERIFY(cpu >= 0);
+    thread.setCpuAffinity({ cpu });
+    thread.start();
+    QVERIFY(thread.wait(five_minutes));
+    QCOMPARE(thread.cpu, cpu);
+#else
+    QSKIP("CPU affinity is only supported on Linux");
+#endif
+}
+
 void tst_QThread::exit()
 {
     Exit_Thread thread;
@@ -34,6 +34,7 @@
 
 #ifdef Q_OS_UNIX
 #include <unistd.h>
+#include <sched.h>
 #endif
 
 typedef void (*FunctionPointer)();
@@ -100,6 +101,8 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing();
+    void cpuAffinity();
 
 private:
     QMutex m_functionTestMutex;
@@ -1282,5 +1285,68 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    pool.setWorkStealingEnabled(true);
+    QVERIFY(pool.isWorkStealingEnabled());
+
+    // every runnable starts two more from within the pool, up to depth 10
+    QAtomicInt count;
+    std::function<void(int)> fork = [&](int depth) {
+        count.ref();
+        if (depth == 0)
+            return;
+        pool.start([&fork, depth] { fork(depth - 1); });
+        pool.start([&fork, depth] { fork(depth - 1); });
+    };
+
+    for (int i = 0; i < 10; ++i) {
+        count.storeRelaxed(0);
+        pool.start([&fork] { fork(10); });
+        QVERIFY(pool.waitForDone(5 * 60 * 1000));
+        QCOMPARE(count.loadRelaxed(), (1 << 11) - 1);
+    }
+}
+
+void tst_QThreadPool::cpuAffinity()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QVERIFY(pool.cpuAffinity().isEmpty());
+    QVERIFY(!pool.isNumaAffinityEnabled());
+    pool.setNumaAffinityEnabled(true);
+    QVERIFY(pool.isNumaAffinityEnabled());
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    const int cpu = sched_getcpu();
+    QVERIFY(cpu >= 0);
+
+    // restricting the pool also moves the threads it already has
+    QAtomicInt wrongCpu;
+    QSemaphore semaphore;
+    pool.start([&] {
+        semaphore.acquire();
+        if (sched_getcpu() != cpu)
+            wrongCpu.ref();
+    });
+    pool.setCpuAffinity({ cpu });
+    QCOMPARE(pool.cpuAffinity(), QList<int>({ cpu }));
+    semaphore.release();
+
+    for (int i = 0; i < 100; ++i) {
+        pool.start([&wrongCpu, cpu] {
+            if (sched_getcpu() != cpu)
+                wrongCpu.ref();
+        });
+    }
+    QVERIFY(pool.waitForDone(5 * 60 * 1000));
+    QCOMPARE(wrongCpu.loadRelaxed(), 0);
+#else
+    QSKIP("CPU affinity is only supported on Linux");
+#endif
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qarenaallocator
+QT = core-private testlib
+SOURCES = tst_qarenaallocator.cpp
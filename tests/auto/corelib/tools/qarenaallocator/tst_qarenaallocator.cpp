@@ -0,0 +1,210 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qflatmap_p.h>
+#include <qbytearray.h>
+#include <qstring.h>
+
+#include <QArenaAllocator>
+#include <QTest>
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QThread>
+
+#include <memory>
+
+class tst_QArenaAllocator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void scopes();
+    void containers();
+    void growing();
+    void escapingData();
+    void largeAllocations();
+    void otherThreads();
+};
+
+void tst_QArenaAllocator::scopes()
+{
+    QCOMPARE(QArenaAllocator::current(), nullptr);
+    QArenaAllocator arena;
+    QCOMPARE(arena.bytesAllocated(), 0);
+    QCOMPARE(arena.blockCount(), 0);
+    {
+        QArenaAllocator::Scope scope(&arena);
+        QCOMPARE(QArenaAllocator::current(), &arena);
+        {
+            QArenaAllocator inner;
+            QArenaAllocator::Scope innerScope(&inner);
+            QCOMPARE(QArenaAllocator::current(), &inner);
+            {
+                QArenaAllocator::Scope heapScope(nullptr);
+                QCOMPARE(QArenaAllocator::current(), nullptr);
+                QList<int> list(100);
+                QCOMPARE(inner.bytesAllocated(), 0);
+            }
+            QCOMPARE(QArenaAllocator::current(), &inner);
+        }
+        QCOMPARE(QArenaAllocator::current(), &arena);
+    }
+    QCOMPARE(QArenaAllocator::current(), nullptr);
+    QCOMPARE(arena.bytesAllocated(), 0);
+}
+
+void tst_QArenaAllocator::containers()
+{
+    QArenaAllocator arena;
+    QArenaAllocator::Scope scope(&arena);
+
+    QList<int> list(100, 42);
+    const qsizetype afterList = arena.bytesAllocated();
+    QVERIFY(afterList >= qsizetype(100 * sizeof(int)));
+    QCOMPARE(arena.blockCount(), 1);
+
+    QString string = QStringLiteral("Hello, ") + QString::number(42);
+    QByteArray bytes = string.toUtf8();
+    const qsizetype afterStrings = arena.bytesAllocated();
+    QVERIFY(afterStrings > afterList);
+
+    QHash<QString, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QString::number(i), i);
+    QVERIFY(arena.bytesAllocated() > afterStrings);
+
+    QCOMPARE(list.at(99), 42);
+    QCOMPARE(string, QStringLiteral("Hello, 42"));
+    QCOMPARE(bytes, QByteArray("Hello, 42"));
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(QString::number(i)), i);
+}
+
+void tst_QArenaAllocator::growing()
+{
+    QArenaAllocator arena;
+    QString string;
+    QList<QByteArray> list;
+    {
+        QArenaAllocator::Scope scope(&arena);
+        for (int i = 0; i < 1000; ++i) {
+            string += QLatin1Char('a' + i % 26);
+            list.append(QByteArray::number(i));
+        }
+    }
+    QVERIFY(arena.blockCount() > 1);
+
+    // growing outside of the scope moves the data to the heap
+    const qsizetype bytes = arena.bytesAllocated();
+    for (int i = 1000; i < 2000; ++i) {
+        string += QLatin1Char('a' + i % 26);
+        list.append(QByteArray::number(i));
+    }
+    QCOMPARE(arena.bytesAllocated(), bytes);
+
+    QCOMPARE(string.size(), 2000);
+    QCOMPARE(list.size(), 2000);
+    for (int i = 0; i < 2000; ++i) {
+        QCOMPARE(string.at(i), QLatin1Char('a' + i % 26));
+        QCOMPARE(list.at(i), QByteArray::number(i));
+    }
+}
+
+void tst_QArenaAllocator::escapingData()
+{
+    QString string;
+    QList<int> list;
+    QHash<int, QString> hash;
+    {
+        QArenaAllocator arena;
+        QArenaAllocator::Scope scope(&arena);
+        QString local = QString::number(12345);
+        QList<int> localList = { 1, 2, 3 };
+        QHash<int, QString> localHash;
+        for (int i = 0; i < 50; ++i)
+            localHash.insert(i, QString::number(i));
+
+        // shared copies keep the arena's blocks alive
+        string = local;
+        list = localList;
+        hash = localHash;
+    }
+    QCOMPARE(string, QStringLiteral("12345"));
+    QCOMPARE(list, QList<int>({ 1, 2, 3 }));
+    for (int i = 0; i < 50; ++i)
+        QCOMPARE(hash.value(i), QString::number(i));
+
+    // detaching works as usual
+    QString copy = string;
+    copy[0] = QLatin1Char('x');
+    QCOMPARE(string, QStringLiteral("12345"));
+    QCOMPARE(copy, QStringLiteral("x2345"));
+    hash.insert(100, QStringLiteral("hundred"));
+    QCOMPARE(hash.size(), 51);
+}
+
+void tst_QArenaAllocator::largeAllocations()
+{
+    QArenaAllocator arena;
+    QArenaAllocator::Scope scope(&arena);
+    QByteArray large(1024 * 1024, 'x');
+    QCOMPARE(arena.bytesAllocated(), 0);
+    QCOMPARE(large.count('x'), 1024 * 1024);
+}
+
+void tst_QArenaAllocator::otherThreads()
+{
+    QArenaAllocator arena;
+    QArenaAllocator::Scope scope(&arena);
+    QString fromArena = QString::number(42);
+    const qsizetype bytes = arena.bytesAllocated();
+
+    QString fromThread;
+    QArenaAllocator *currentInThread = &arena;
+    std::unique_ptr<QThread> thread(QThread::create([&]() {
+        // the scope doesn't apply to other threads
+        currentInThread = QArenaAllocator::current();
+        fromThread = QString::number(1234567);
+        // releasing arena data from another thread is fine
+        QString copy = fromArena;
+        fromArena = QString();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCOMPARE(currentInThread, nullptr);
+    QCOMPARE(arena.bytesAllocated(), bytes);
+    QCOMPARE(fromThread, QStringLiteral("1234567"));
+}
+
+QTEST_APPLESS_MAIN(tst_QArenaAllocator)
+#include "tst_qarenaallocator.moc"
@@ -0,0 +1,200 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qflatmap_p.h>
+#include <qbytearray.h>
+#include <qstring.h>
+
+#include <private/qconcurrenthash_p.h>
+#include <QTest>
+
+#include <QString>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void basics();
+    void growing();
+    void snapshot();
+    void clear();
+    void concurrentReadWrite();
+    void concurrentInsertRemove();
+};
+
+void tst_QConcurrentHash::basics()
+{
+    QConcurrentHash<QString, int> h;
+    QVERIFY(h.isEmpty());
+    QVERIFY(!h.contains(QStringLiteral("foo")));
+    QCOMPARE(h.value(QStringLiteral("foo")), 0);
+    QCOMPARE(h.value(QStringLiteral("foo"), -1), -1);
+
+    QVERIFY(h.insert(QStringLiteral("foo"), 1));
+    QVERIFY(!h.insert(QStringLiteral("foo"), 2));
+    QCOMPARE(h.value(QStringLiteral("foo")), 2);
+    QVERIFY(!h.tryInsert(QStringLiteral("foo"), 3));
+    QCOMPARE(h.value(QStringLiteral("foo")), 2);
+    QVERIFY(h.tryInsert(QStringLiteral("bar"), 3));
+    QCOMPARE(h.size(), 2);
+
+    QCOMPARE(h.take(QStringLiteral("foo")), 2);
+    QCOMPARE(h.take(QStringLiteral("foo")), 0);
+    QVERIFY(!h.contains(QStringLiteral("foo")));
+    QVERIFY(h.remove(QStringLiteral("bar")));
+    QVERIFY(!h.remove(QStringLiteral("bar")));
+    QVERIFY(h.isEmpty());
+
+    // a single shard works as well
+    QConcurrentHash<int, int> single(1);
+    for (int i = 0; i < 100; ++i)
+        single.insert(i, i);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(single.value(i, -1), i);
+}
+
+void tst_QConcurrentHash::growing()
+{
+    QConcurrentHash<int, int> h(4);
+    for (int i = 0; i < 10000; ++i)
+        QVERIFY(h.insert(i, i * 2));
+    QCOMPARE(h.size(), 10000);
+    for (int i = 0; i < 10000; ++i)
+        QCOMPARE(h.value(i, -1), i * 2);
+
+    // removing and inserting reuses the deleted buckets
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 10000; i += 2)
+            QVERIFY(h.remove(i));
+        for (int i = 0; i < 10000; i += 2)
+            QVERIFY(h.insert(i, round));
+    }
+    QCOMPARE(h.size(), 10000);
+    QCOMPARE(h.value(42), 9);
+    QCOMPARE(h.value(43), 86);
+}
+
+void tst_QConcurrentHash::snapshot()
+{
+    QConcurrentHash<int, QString> h;
+    for (int i = 0; i < 100; ++i)
+        h.insert(i, QString::number(i));
+    h.remove(50);
+    const QHash<int, QString> copy = h.snapshot();
+    QCOMPARE(copy.size(), 99);
+    QVERIFY(!copy.contains(50));
+    for (auto it = copy.cbegin(); it != copy.cend(); ++it)
+        QCOMPARE(it.value(), QString::number(it.key()));
+
+    h.insert(50, QStringLiteral("fifty"));
+    QVERIFY(!copy.contains(50));
+}
+
+void tst_QConcurrentHash::clear()
+{
+    QConcurrentHash<int, int> h;
+    for (int i = 0; i < 1000; ++i)
+        h.insert(i, i);
+    h.clear();
+    QVERIFY(h.isEmpty());
+    QVERIFY(!h.contains(1));
+    QVERIFY(h.snapshot().isEmpty());
+    QVERIFY(h.insert(1, 1));
+    QCOMPARE(h.value(1), 1);
+}
+
+// readers must never see a value that wasn't written for their key
+void tst_QConcurrentHash::concurrentReadWrite()
+{
+    enum { KeyCount = 1000, Iterations = 20000 };
+    QConcurrentHash<int, QString> h(8);
+    for (int i = 0; i < KeyCount; ++i)
+        h.insert(i, QString::number(i));
+
+    QAtomicInt stop = 0;
+    QAtomicInt failures = 0;
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back(QThread::create([&h, &stop, &failures]() {
+            int i = 0;
+            while (!stop.loadRelaxed()) {
+                const int key = i++ % KeyCount;
+                const QString value = h.value(key);
+                if (!value.isNull() && !value.startsWith(QString::number(key)))
+                    failures.ref();
+            }
+        }));
+        readers.back()->start();
+    }
+
+    for (int i = 0; i < Iterations; ++i) {
+        const int key = i % KeyCount;
+        if (i % 3 == 0)
+            h.remove(key);
+        else
+            h.insert(key, QString::number(key) + QLatin1Char('-') + QString::number(i));
+    }
+    stop.storeRelaxed(1);
+    for (auto &thread : readers)
+        QVERIFY(thread->wait());
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentHash::concurrentInsertRemove()
+{
+    enum { ThreadCount = 4, KeysPerThread = 5000 };
+    QConcurrentHash<int, int> h(16);
+    std::vector<std::unique_ptr<QThread>> writers;
+    for (int t = 0; t < ThreadCount; ++t) {
+        writers.emplace_back(QThread::create([&h, t]() {
+            const int first = t * KeysPerThread;
+            for (int i = first; i < first + KeysPerThread; ++i)
+                h.insert(i, i);
+            for (int i = first; i < first + KeysPerThread; i += 2)
+                h.remove(i);
+        }));
+        writers.back()->start();
+    }
+    for (auto &thread : writers)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(h.size(), ThreadCount * KeysPerThread / 2);
+    const QHash<int, int> copy = h.snapshot();
+    QCOMPARE(copy.size(), ThreadCount * KeysPerThread / 2);
+    for (int i = 0; i < ThreadCount * KeysPerThread; ++i)
+        QCOMPARE(h.contains(i), i % 2 == 1);
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentHash)
+#include "tst_qconcurrenthash.moc"
@@ -0,0 +1,315 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qflatmap_p.h>
+#include <qbytearray.h>
+#include <qstring.h>
+
+#include <private/qflathash_p.h>
+#include <QTest>
+
+#include <QHash>
+#include <QString>
+
+#include <algorithm>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void constructing();
+    void insertion();
+    void removal();
+    void take();
+    void iterators();
+    void implicitSharing();
+    void reserveAndSqueeze();
+    void tombstones();
+    void collisions();
+    void compareWithQHash();
+};
+
+void tst_QFlatHash::constructing()
+{
+    using Hash = QFlatHash<int, QByteArray>;
+    Hash empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QCOMPARE(empty.capacity(), 0);
+    QCOMPARE(empty.begin(), empty.end());
+    QCOMPARE(empty.constBegin(), empty.constEnd());
+    QVERIFY(!empty.contains(1));
+    QCOMPARE(empty.value(1), QByteArray());
+
+    const Hash h{ { 1, "een" }, { 2, "twee" }, { 3, "dree" } };
+    QCOMPARE(h.size(), 3);
+    QCOMPARE(h.value(1), "een");
+    QCOMPARE(h.value(2), "twee");
+    QCOMPARE(h.value(3), "dree");
+    QCOMPARE(h.value(4, "vier"), "vier");
+    QCOMPARE(h[3], "dree");
+    QCOMPARE(h.key("twee"), 2);
+    QCOMPARE(h.key("nix", -1), -1);
+
+    Hash copy = h;
+    QCOMPARE(copy, h);
+    Hash moved = std::move(copy);
+    QCOMPARE(moved, h);
+    QVERIFY(copy.isEmpty());
+    copy = moved;
+    QCOMPARE(copy, h);
+    copy[4] = "vier";
+    QVERIFY(copy != h);
+    copy.swap(moved);
+    QCOMPARE(copy, h);
+    QCOMPARE(moved.size(), 4);
+}
+
+void tst_QFlatHash::insertion()
+{
+    QFlatHash<QString, int> h;
+    auto it = h.insert(QStringLiteral("foo"), 1);
+    QCOMPARE(it.key(), QStringLiteral("foo"));
+    QCOMPARE(it.value(), 1);
+    it = h.insert(QStringLiteral("foo"), 2);
+    QCOMPARE(h.size(), 1);
+    QCOMPARE(*it, 2);
+    h[QStringLiteral("bar")] = 3;
+    ++h[QStringLiteral("bar")];
+    QCOMPARE(h.value(QStringLiteral("bar")), 4);
+    it = h.emplace(QStringLiteral("baz"), 5);
+    QCOMPARE(it.value(), 5);
+    QCOMPARE(h.size(), 3);
+    QCOMPARE(h.count(QStringLiteral("baz")), 1);
+    QCOMPARE(h.count(QStringLiteral("nix")), 0);
+
+    // growing keeps everything
+    for (int i = 0; i < 1000; ++i)
+        h.insert(QString::number(i), i);
+    QCOMPARE(h.size(), 1003);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(h.value(QString::number(i), -1), i);
+    QCOMPARE(h.value(QStringLiteral("foo")), 2);
+
+    // inserting with a key from the hash itself
+    QFlatHash<QString, int> self;
+    self.insert(QStringLiteral("0"), 0);
+    for (int i = 1; i < 100; ++i)
+        self.insert(self.constBegin().key() + QString::number(i), i);
+    QCOMPARE(self.size(), 100);
+}
+
+void tst_QFlatHash::removal()
+{
+    QFlatHash<int, int> h;
+    for (int i = 0; i < 100; ++i)
+        h.insert(i, i * 2);
+    QVERIFY(h.remove(42));
+    QVERIFY(!h.remove(42));
+    QVERIFY(!h.contains(42));
+    QCOMPARE(h.size(), 99);
+
+    for (auto it = h.begin(); it != h.end(); ) {
+        if (it.key() % 2)
+            it = h.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(h.size(), 49);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(h.contains(i), i % 2 == 0 && i != 42);
+
+    h.clear();
+    QVERIFY(h.isEmpty());
+    QVERIFY(!h.contains(0));
+    QVERIFY(h.capacity() > 0);
+    h.insert(1, 1);
+    QCOMPARE(h.size(), 1);
+}
+
+void tst_QFlatHash::take()
+{
+    QFlatHash<int, QString> h{ { 1, QStringLiteral("one") }, { 2, QStringLiteral("two") } };
+    QCOMPARE(h.take(1), QStringLiteral("one"));
+    QCOMPARE(h.take(1), QString());
+    QCOMPARE(h.size(), 1);
+    QCOMPARE(h.value(2), QStringLiteral("two"));
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> h;
+    for (int i = 0; i < 50; ++i)
+        h.insert(i, -i);
+
+    QList<int> keys;
+    for (auto it = h.constBegin(); it != h.constEnd(); ++it) {
+        QCOMPARE(it.value(), -it.key());
+        keys.append(it.key());
+    }
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys.size(), 50);
+    for (int i = 0; i < 50; ++i)
+        QCOMPARE(keys.at(i), i);
+
+    QList<int> sortedKeys = h.keys();
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+    QCOMPARE(sortedKeys, keys);
+    QCOMPARE(h.values().size(), 50);
+
+    for (int &v : h)
+        v = 1;
+    QCOMPARE(std::count(h.cbegin(), h.cend(), 1), 50);
+
+    auto it = h.find(7);
+    QVERIFY(it != h.end());
+    QCOMPARE(it.key(), 7);
+    QVERIFY(h.find(70) == h.end());
+    QVERIFY(std::as_const(h).find(70) == h.constEnd());
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, int> a{ { 1, 1 }, { 2, 2 } };
+    QFlatHash<int, int> b = a;
+    QVERIFY(a.isSharedWith(b));
+    QVERIFY(!a.isDetached());
+
+    // reading doesn't detach
+    QCOMPARE(std::as_const(b).value(1), 1);
+    QVERIFY(a.isSharedWith(b));
+
+    b[3] = 3;
+    QVERIFY(!a.isSharedWith(b));
+    QVERIFY(a.isDetached());
+    QVERIFY(b.isDetached());
+    QCOMPARE(a.size(), 2);
+    QCOMPARE(b.size(), 3);
+
+    QFlatHash<int, int> c = a;
+    QVERIFY(c.remove(1));
+    QVERIFY(a.contains(1));
+    QVERIFY(!c.contains(1));
+
+    c = a;
+    c.clear();
+    QCOMPARE(a.size(), 2);
+    QVERIFY(c.isEmpty());
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> h;
+    h.reserve(1000);
+    const qsizetype capacity = h.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        h.insert(i, i);
+    QCOMPARE(h.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        h.remove(i);
+    QCOMPARE(h.capacity(), capacity);
+    QFlatHash<int, int> copy = h;
+    h.squeeze();
+    QVERIFY(h.capacity() < capacity);
+    QCOMPARE(h, copy);
+    QCOMPARE(copy.capacity(), capacity);
+
+    h.reserve(5000);
+    QVERIFY(h.capacity() >= 5000);
+    QCOMPARE(h, copy);
+}
+
+void tst_QFlatHash::tombstones()
+{
+    // inserting and removing keys must not grow the table without bound
+    QFlatHash<int, int> h;
+    for (int i = 0; i < 100; ++i)
+        h.insert(i, i);
+    const qsizetype capacity = h.capacity();
+    for (int i = 100; i < 100000; ++i) {
+        h.insert(i, i);
+        h.remove(i - 100);
+    }
+    QCOMPARE(h.size(), 100);
+    QVERIFY(h.capacity() <= 2 * capacity);
+    for (int i = 99900; i < 100000; ++i)
+        QCOMPARE(h.value(i, -1), i);
+}
+
+struct BadKey
+{
+    int value;
+    bool operator==(const BadKey &other) const { return value == other.value; }
+};
+
+static size_t qHash(const BadKey &key, size_t seed = 0)
+{
+    // all keys share the same group and control byte
+    return (key.value & 1) ^ seed;
+}
+
+void tst_QFlatHash::collisions()
+{
+    QFlatHash<BadKey, int> h;
+    for (int i = 0; i < 200; ++i)
+        h.insert(BadKey{i}, i);
+    QCOMPARE(h.size(), 200);
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(h.value(BadKey{i}, -1), i);
+    for (int i = 0; i < 200; i += 3)
+        QVERIFY(h.remove(BadKey{i}));
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(h.contains(BadKey{i}), i % 3 != 0);
+}
+
+void tst_QFlatHash::compareWithQHash()
+{
+    QHash<quint32, quint32> reference;
+    QFlatHash<quint32, quint32> h;
+    quint32 state = 1;
+    for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245 + 12345;
+        const quint32 key = (state >> 8) % 4096;
+        if (state & 0x10) {
+            reference.insert(key, quint32(i));
+            h.insert(key, quint32(i));
+        } else {
+            QCOMPARE(h.remove(key), reference.remove(key));
+        }
+        QCOMPARE(h.size(), reference.size());
+    }
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(h.value(it.key()), it.value());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
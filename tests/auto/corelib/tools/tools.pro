@@ -3,14 +3,17 @@ SUBDIRS=\
     collections \
     containerapisymmetry \
     qalgorithms \
+    qarenaallocator \
     qarraydata \
     qbitarray \
     qcache \
     qcommandlineparser \
+    qconcurrenthash \
     qcontiguouscache \
     qcryptographichash \
     qeasingcurve \
     qexplicitlyshareddatapointer \
+    qflathash \
     qflatmap \
     qfreelist \
     qhash \
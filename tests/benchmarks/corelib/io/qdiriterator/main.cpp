@@ -52,12 +52,14 @@ class tst_qdiriterator : public QObject
 {
     Q_OBJECT
 
-    void data();
+    void data(bool prefetchColumn = false);
 private slots:
     void posix();
     void posix_data() { data(); }
     void diriterator();
     void diriterator_data() { data(); }
+    void diriteratorMetadata();
+    void diriteratorMetadata_data() { data(true); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
@@ -65,7 +67,7 @@ private slots:
 };
 
 
-void tst_qdiriterator::data()
+void tst_qdiriterator::data(bool prefetchColumn)
 {
 #if defined(Q_OS_WIN)
     const char *qtdir = "C:\\depot\\qt\\main";
@@ -80,6 +82,12 @@ void tst_qdiriterator::data()
     QTest::addColumn<QByteArray>("dirpath");
     QByteArray ba = QByteArray(qtdir) + "/src/corelib";
     QByteArray ba1 = ba + "/io";
+    if (prefetchColumn) {
+        QTest::addColumn<bool>("prefetch");
+        QTest::newRow(ba + " (stat later)") << ba << false;
+        QTest::newRow(ba + " (PrefetchMetadata)") << ba << true;
+        return;
+    }
     QTest::newRow(ba) << ba;
     //QTest::newRow(ba1) << ba1;
 }
@@ -205,6 +213,29 @@ void tst_qdiriterator::diriterator()
     qDebug() << count;
 }
 
+void tst_qdiriterator::diriteratorMetadata()
+{
+    QFETCH(QByteArray, dirpath);
+    QFETCH(bool, prefetch);
+
+    QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories;
+    if (prefetch)
+        flags |= QDirIterator::PrefetchMetadata;
+
+    qint64 size = 0;
+    QBENCHMARK {
+        qint64 s = 0;
+        QDirIterator dir(dirpath, QDir::Files, flags);
+        while (dir.hasNext()) {
+            dir.next();
+            const QFileInfo info = dir.fileInfo();
+            s += info.size() + (info.lastModified().isValid() ? 1 : 0);
+        }
+        size = s;
+    }
+    qDebug() << size;
+}
+
 void tst_qdiriterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
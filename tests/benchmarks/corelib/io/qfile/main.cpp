@@ -30,6 +30,7 @@
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
+#include <QFuture>
 
 #include <private/qfsfileengine_p.h>
 
@@ -107,6 +108,9 @@ private slots:
     void readBigFile_posix();
     void readBigFile_Win32();
 
+    void readSmallFilesAsync_data();
+    void readSmallFilesAsync();
+
 private:
     void readBigFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -562,6 +566,50 @@ void tst_qfile::readSmallFiles_data(BenchmarkType type, QIODevice::OpenModeFlag
 
 }
 
+void tst_qfile::readSmallFilesAsync_data()
+{
+    QTest::addColumn<bool>("async");
+
+    QTest::newRow("readAll()") << false;
+    QTest::newRow("readAllAsync()") << true;
+}
+
+void tst_qfile::readSmallFilesAsync()
+{
+    QFETCH(bool, async);
+
+    createSmallFiles();
+
+    QDir dir(tmpDirName);
+    const QStringList files = dir.entryList(QDir::NoDotAndDotDot|QDir::NoSymLinks|QDir::Files);
+    QList<QFile *> fileList;
+    for (const QString &file : files) {
+        QFile *f = new QFile(tmpDirName + QLatin1Char('/') + file);
+        f->open(QIODevice::ReadOnly);
+        fileList.append(f);
+    }
+
+    qint64 total = 0;
+    if (async) {
+        QBENCHMARK {
+            const QList<QByteArray> contents = QFile::readAllAsync(fileList).results();
+            for (const QByteArray &content : contents)
+                total += content.size();
+        }
+    } else {
+        QBENCHMARK {
+            for (QFile *file : qAsConst(fileList)) {
+                file->seek(0);
+                total += file->readAll().size();
+            }
+        }
+    }
+    QVERIFY(total > 0);
+
+    qDeleteAll(fileList);
+    removeSmallFiles();
+}
+
 void tst_qfile::createSmallFiles()
 {
     QDir dir = QDir::temp();
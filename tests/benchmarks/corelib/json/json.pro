@@ -1,4 +1,4 @@
-QT = core testlib
+QT = core-private testlib
 CONFIG += benchmark
 CONFIG -= app_bundle
 
@@ -28,7 +28,10 @@
 
 #include <QtTest>
 #include <qjsondocument.h>
+#include <qjsonarray.h>
 #include <qjsonobject.h>
+#include <private/qjsonlazydocument_p.h>
+#include <private/qjsonparser_p.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -45,6 +48,10 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseStrategy_data();
+    void parseStrategy();
+    void readFewValues_data();
+    void readFewValues();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -117,6 +124,83 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+// something resembling a large structured log
+static QByteArray generateLog()
+{
+    QByteArray log = "[\n";
+    for (int i = 0; i < 100000; ++i) {
+        log += "  {\"timestamp\": \"2020-12-08T10:15:" + QByteArray::number(i % 60)
+                + ".123Z\", \"level\": \"info\", \"pid\": " + QByteArray::number(i)
+                + ", \"message\": \"request served in " + QByteArray::number(i * 0.37)
+                + " ms, path \\\"/api/v1/items\\\"\", \"tags\": [\"http\", \"api\"],"
+                  " \"ok\": true, \"user\": null},\n";
+    }
+    log += "  {}\n]\n";
+    return log;
+}
+
+void BenchmarkQtJson::parseStrategy_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonPrivate::Parser::Strategy>("strategy");
+
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    const QByteArray testJson = file.readAll();
+
+    const QByteArray log = generateLog();
+
+    QTest::newRow("test.json-sequential") << testJson << QJsonPrivate::Parser::Strategy::Sequential;
+    QTest::newRow("test.json-indexed") << testJson << QJsonPrivate::Parser::Strategy::Indexed;
+    QTest::newRow("log-sequential") << log << QJsonPrivate::Parser::Strategy::Sequential;
+    QTest::newRow("log-indexed") << log << QJsonPrivate::Parser::Strategy::Indexed;
+}
+
+void BenchmarkQtJson::parseStrategy()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonPrivate::Parser::Strategy, strategy);
+
+    QBENCHMARK {
+        QJsonPrivate::Parser parser(json.constData(), json.size());
+        QJsonParseError error;
+        const QCborValue value = parser.parse(&error, strategy);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+    }
+}
+
+void BenchmarkQtJson::readFewValues_data()
+{
+    QTest::addColumn<bool>("lazy");
+
+    QTest::newRow("QJsonDocument") << false;
+    QTest::newRow("QJsonLazyDocument") << true;
+}
+
+void BenchmarkQtJson::readFewValues()
+{
+    QFETCH(bool, lazy);
+    const QByteArray log = generateLog();
+
+    QBENCHMARK {
+        QString message;
+        qint64 pid;
+        if (lazy) {
+            const QJsonLazyDocument doc = QJsonLazyDocument::fromJson(log);
+            message = doc[50000]["message"].toString();
+            pid = doc[99999]["pid"].toInteger();
+        } else {
+            const QJsonArray array = QJsonDocument::fromJson(log).array();
+            message = array.at(50000)["message"].toString();
+            pid = array.at(99999)["pid"].toInteger();
+        }
+        QCOMPARE(pid, 99999);
+        QVERIFY(!message.isEmpty());
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
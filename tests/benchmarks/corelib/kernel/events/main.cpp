@@ -30,6 +30,14 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#ifdef Q_OS_LINUX
+#  include <private/qeventdispatcher_unix_p.h>
+#  if QT_CONFIG(epoll)
+#    include <sys/eventfd.h>
+#    include <sys/resource.h>
+#  endif
+#endif
+
 class PingPong : public QObject
 {
 public:
@@ -83,6 +91,34 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class EventCounter : public QObject
+{
+public:
+    void expect(int count) { m_remaining = count; }
+
+protected:
+    bool event(QEvent *e) override;
+
+private:
+    int m_remaining = 0;
+};
+
+bool EventCounter::event(QEvent *e)
+{
+    if (e->type() != QEvent::User)
+        return QObject::event(e);
+    if (--m_remaining == 0)
+        QTestEventLoop::instance().exitLoop();
+    return true;
+}
+
+class SignalEmitter : public QObject
+{
+    Q_OBJECT
+signals:
+    void valueChanged(int value, const QString &text);
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -96,6 +132,12 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void postEventContended_data();
+    void postEventContended();
+    void queuedSignal_data();
+    void queuedSignal();
+    void socketNotifierWakeup_data();
+    void socketNotifierWakeup();
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +211,166 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::postEventContended_data()
+{
+    QTest::addColumn<int>("eventsPerProducer");
+    QTest::newRow("100 events per producer") << 100;
+    QTest::newRow("10000 events per producer") << 10000;
+}
+
+void EventsBench::postEventContended()
+{
+    QFETCH(int, eventsPerProducer);
+    const int producerCount = 16;
+
+    EventCounter receiver;
+    QBENCHMARK {
+        receiver.expect(producerCount * eventsPerProducer);
+
+        // all producers post to the main thread at the same time
+        QSemaphore start;
+        QList<QThread *> producers;
+        for (int i = 0; i < producerCount; ++i) {
+            producers.append(QThread::create([&] {
+                start.acquire();
+                for (int j = 0; j < eventsPerProducer; ++j)
+                    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+            }));
+            producers.last()->start();
+        }
+        start.release(producerCount);
+
+        QTestEventLoop::instance().enterLoop(60);
+        for (QThread *producer : qAsConst(producers))
+            producer->wait();
+        qDeleteAll(producers);
+    }
+    QVERIFY(!QTestEventLoop::instance().timeout());
+}
+
+void EventsBench::queuedSignal_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("queued") << false;
+    QTest::newRow("batched") << true;
+}
+
+void EventsBench::queuedSignal()
+{
+    QFETCH(bool, batched);
+    const int emissions = 100000;
+
+    SignalEmitter emitter;
+    QObject receiver;
+    int remaining = 0;
+    const auto type = batched ? Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)
+                              : Qt::QueuedConnection;
+    QObject::connect(&emitter, &SignalEmitter::valueChanged, &receiver,
+                     [&remaining](int, const QString &) {
+                         if (--remaining == 0)
+                             QTestEventLoop::instance().exitLoop();
+                     }, type);
+
+    const QString text = QStringLiteral("value");
+    QBENCHMARK {
+        remaining = emissions;
+
+        // another thread emits to the main thread
+        QScopedPointer<QThread> producer(QThread::create([&] {
+            for (int i = 0; i < emissions; ++i)
+                emit emitter.valueChanged(i, text);
+        }));
+        producer->start();
+
+        QTestEventLoop::instance().enterLoop(60);
+        producer->wait();
+    }
+    QVERIFY(!QTestEventLoop::instance().timeout());
+}
+
+void EventsBench::socketNotifierWakeup_data()
+{
+    QTest::addColumn<bool>("useEpoll");
+    QTest::addColumn<int>("notifierCount");
+
+    for (int count : { 10, 1000, 10000 }) {
+        QTest::addRow("poll, %d notifiers", count) << false << count;
+        QTest::addRow("epoll, %d notifiers", count) << true << count;
+    }
+}
+
+void EventsBench::socketNotifierWakeup()
+{
+#if defined(Q_OS_LINUX) && QT_CONFIG(epoll)
+    QFETCH(bool, useEpoll);
+    QFETCH(int, notifierCount);
+
+    // every notifier watches its own descriptor
+    const rlim_t neededFds = rlim_t(notifierCount) + 64;
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < neededFds) {
+        limit.rlim_cur = qMin(limit.rlim_max, neededFds);
+        setrlimit(RLIMIT_NOFILE, &limit);
+        getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (limit.rlim_cur < neededFds)
+        QSKIP("Not enough file descriptors available");
+
+    const int wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    QVERIFY(wakeFd >= 0);
+
+    // the backend is chosen when the dispatcher is created
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", useEpoll ? "1" : "0");
+    QThread thread;
+    thread.setEventDispatcher(new QEventDispatcherUNIX);
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+    thread.start();
+
+    QObject context;
+    context.moveToThread(&thread);
+
+    QSemaphore activated;
+    QList<int> idleFds;
+    QList<QSocketNotifier *> notifiers;
+    auto cleanup = qScopeGuard([&] {
+        QMetaObject::invokeMethod(&context, [&] { qDeleteAll(notifiers); },
+                                  Qt::BlockingQueuedConnection);
+        thread.quit();
+        thread.wait();
+
+        for (int fd : qAsConst(idleFds))
+            qt_safe_close(fd);
+        qt_safe_close(wakeFd);
+    });
+
+    QMetaObject::invokeMethod(&context, [&] {
+        for (int i = 1; i < notifierCount; ++i) {
+            const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fd < 0)
+                break;
+            idleFds.append(fd);
+            notifiers.append(new QSocketNotifier(fd, QSocketNotifier::Read));
+        }
+
+        QSocketNotifier *wakeNotifier = new QSocketNotifier(wakeFd, QSocketNotifier::Read);
+        connect(wakeNotifier, &QSocketNotifier::activated, [&] {
+            eventfd_t value;
+            eventfd_read(wakeFd, &value);
+            activated.release();
+        });
+        notifiers.append(wakeNotifier);
+    }, Qt::BlockingQueuedConnection);
+    QCOMPARE(notifiers.size(), notifierCount);
+
+    QBENCHMARK {
+        eventfd_write(wakeFd, 1);
+        activated.acquire();
+    }
+#else
+    QSKIP("This benchmark requires epoll(7)");
+#endif
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
@@ -6,7 +6,8 @@ SUBDIRS = \
         qobject \
         qvariant \
         qcoreapplication \
-        qtimer_vs_qmetaobject
+        qtimer_vs_qmetaobject \
+        timers
 
 !qtHaveModule(widgets): SUBDIRS -= \
     qmetaobject \
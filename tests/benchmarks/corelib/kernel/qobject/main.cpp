@@ -32,6 +32,33 @@
 #include <qcoreapplication.h>
 #include <qdatetime.h>
 
+#if defined(__GLIBC__)
+// count every allocation of the process, passing them on to glibc
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+static QBasicAtomicInteger<qint64> allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+extern "C" void *malloc(size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    return __libc_realloc(ptr, size);
+}
+#endif
+
 enum {
     CreationDeletionBenckmarkConstant = 34567,
     SignalsAndSlotsBenchmarkConstant = 456789
@@ -45,6 +72,8 @@ private slots:
     void signal_slot_benchmark_data();
     void signal_many_receivers();
     void signal_many_receivers_data();
+    void signal_allocations();
+    void signal_allocations_data();
     void qproperty_benchmark_data();
     void qproperty_benchmark();
     void dynamic_property_benchmark();
@@ -198,6 +227,39 @@ void QObjectBenchmark::signal_many_receivers()
     }
 }
 
+void QObjectBenchmark::signal_allocations_data()
+{
+    QTest::addColumn<Qt::ConnectionType>("type");
+    QTest::newRow("direct") << Qt::DirectConnection;
+    QTest::newRow("queued") << Qt::QueuedConnection;
+}
+
+void QObjectBenchmark::signal_allocations()
+{
+#if defined(__GLIBC__)
+    QFETCH(Qt::ConnectionType, type);
+    Object sender;
+    Object receiver;
+    QObject::connect(&sender, &Object::valueChanged, &receiver, &Object::setValue, type);
+
+    // leave out what is only allocated the first time
+    sender.emitValueChanged(0, 0.5);
+    QCoreApplication::processEvents();
+
+    // reports the allocations per emission, including the delivery
+    const int emissions = 1000;
+    const qint64 before = allocationCount.loadRelaxed();
+    for (int i = 0; i < emissions; ++i)
+        sender.emitValueChanged(i, 0.5);
+    QCoreApplication::processEvents();
+    const qint64 allocations = allocationCount.loadRelaxed() - before;
+
+    QTest::setBenchmarkResult(qreal(allocations) / emissions, QTest::Events);
+#else
+    QSKIP("Counting allocations needs glibc");
+#endif
+}
+
 void QObjectBenchmark::qproperty_benchmark_data()
 {
     QTest::addColumn<QByteArray>("name");
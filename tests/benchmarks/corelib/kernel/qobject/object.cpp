@@ -31,6 +31,8 @@ void Object::emitSignal0()
 { emit signal0(); }
 void Object::emitSignal1()
 { emit signal1(); }
+void Object::emitValueChanged(int value, double ratio)
+{ emit valueChanged(value, ratio); }
 
 
 void Object::slot0()
@@ -53,3 +55,5 @@ void Object::slot8()
 { }
 void Object::slot9()
 { }
+void Object::setValue(int, double)
+{ }
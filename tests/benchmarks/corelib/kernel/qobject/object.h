@@ -36,6 +36,7 @@ class Object : public QObject
 public:
     void emitSignal0();
     void emitSignal1();
+    void emitValueChanged(int value, double ratio);
 signals:
     void signal0();
     void signal1();
@@ -47,6 +48,7 @@ signals:
     void signal7();
     void signal8();
     void signal9();
+    void valueChanged(int value, double ratio);
 public slots:
     void slot0();
     void slot1();
@@ -58,6 +60,7 @@ public slots:
     void slot7();
     void slot8();
     void slot9();
+    void setValue(int value, double ratio);
 };
 
 #endif // OBJECT_H
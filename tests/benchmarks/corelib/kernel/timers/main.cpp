@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtCore>
+
+#include <qtest.h>
+
+#ifdef Q_OS_UNIX
+#  include <private/qeventdispatcher_unix_p.h>
+#endif
+
+class TimerReceiver : public QObject
+{
+public:
+    explicit TimerReceiver(int count)
+        : timers(new QBasicTimer[count]), count(count)
+    { }
+
+    void startAll(int baseInterval, int spread)
+    {
+        for (int i = 0; i < count; ++i) {
+            timers[i].start(baseInterval + (i * 7919) % spread, Qt::CoarseTimer, this);
+            indexes.insert(timers[i].timerId(), i);
+        }
+        pending = count;
+    }
+
+    void stopAll()
+    {
+        for (int i = 0; i < count; ++i)
+            timers[i].stop();
+        indexes.clear();
+    }
+
+    QSemaphore allFired;
+
+protected:
+    void timerEvent(QTimerEvent *e) override
+    {
+        timers[indexes.take(e->timerId())].stop();
+        if (--pending == 0)
+            allFired.release();
+    }
+
+private:
+    QScopedArrayPointer<QBasicTimer> timers;
+    QHash<int, int> indexes;
+    int count;
+    int pending = 0;
+};
+
+class TimersBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registerTimers_data();
+    void registerTimers();
+    void fireTimers_data();
+    void fireTimers();
+
+private:
+    void startThread(bool useTimerWheel);
+    void stopThread();
+
+    QThread *thread = nullptr;
+    QObject *context = nullptr;
+};
+
+void TimersBench::startThread(bool useTimerWheel)
+{
+    thread = new QThread;
+#ifdef Q_OS_UNIX
+    // the timer store is chosen when the dispatcher is created
+    qputenv("QT_EVENT_DISPATCHER_TIMER_WHEEL", useTimerWheel ? "1" : "0");
+    thread->setEventDispatcher(new QEventDispatcherUNIX);
+    qunsetenv("QT_EVENT_DISPATCHER_TIMER_WHEEL");
+#else
+    Q_UNUSED(useTimerWheel);
+#endif
+    thread->start();
+
+    context = new QObject;
+    context->moveToThread(thread);
+}
+
+void TimersBench::stopThread()
+{
+    thread->quit();
+    thread->wait();
+    delete context;
+    delete thread;
+}
+
+static void addRows()
+{
+    QTest::addColumn<bool>("useTimerWheel");
+    QTest::addColumn<int>("timerCount");
+
+    for (int count : { 1000, 10000 }) {
+        QTest::addRow("list, %d timers", count) << false << count;
+        QTest::addRow("wheel, %d timers", count) << true << count;
+    }
+}
+
+void TimersBench::registerTimers_data()
+{
+    addRows();
+}
+
+void TimersBench::registerTimers()
+{
+    QFETCH(bool, useTimerWheel);
+    QFETCH(int, timerCount);
+
+#ifndef Q_OS_UNIX
+    if (useTimerWheel)
+        QSKIP("The timer wheel is only available in the UNIX event dispatcher");
+#endif
+
+    startThread(useTimerWheel);
+    auto cleanup = qScopeGuard([this] { stopThread(); });
+
+    TimerReceiver *receiver = nullptr;
+    QMetaObject::invokeMethod(context, [&] { receiver = new TimerReceiver(timerCount); },
+                              Qt::BlockingQueuedConnection);
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(context, [&] {
+            receiver->startAll(1000, 60000);
+            receiver->stopAll();
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    QMetaObject::invokeMethod(context, [&] { delete receiver; }, Qt::BlockingQueuedConnection);
+}
+
+void TimersBench::fireTimers_data()
+{
+    addRows();
+}
+
+void TimersBench::fireTimers()
+{
+    QFETCH(bool, useTimerWheel);
+    QFETCH(int, timerCount);
+
+#ifndef Q_OS_UNIX
+    if (useTimerWheel)
+        QSKIP("The timer wheel is only available in the UNIX event dispatcher");
+#endif
+
+    startThread(useTimerWheel);
+    auto cleanup = qScopeGuard([this] { stopThread(); });
+
+    TimerReceiver *receiver = nullptr;
+    QMetaObject::invokeMethod(context, [&] { receiver = new TimerReceiver(timerCount); },
+                              Qt::BlockingQueuedConnection);
+
+    QBENCHMARK {
+        // coarse timers between 25 and 50 ms, each firing once
+        QMetaObject::invokeMethod(context, [&] { receiver->startAll(25, 25); },
+                                  Qt::BlockingQueuedConnection);
+        receiver->allFired.acquire();
+    }
+
+    QMetaObject::invokeMethod(context, [&] { delete receiver; }, Qt::BlockingQueuedConnection);
+}
+
+QTEST_MAIN(TimersBench)
+
+#include "main.moc"
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QCollator>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTest>
+
+#include <algorithm>
+
+class tst_QCollator : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sort_data();
+    void sort();
+};
+
+// Words made of Latin letters, some accented, so that collating them isn't
+// trivial.
+static QStringList randomWords(int count)
+{
+    static const char16_t letters[] = u"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                      u"äåéöüÄÅÖ";
+    const int letterCount = int(std::size(letters)) - 1;
+    QRandomGenerator rng(count);
+    QStringList words;
+    words.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QString word(3 + rng.bounded(10), Qt::Uninitialized);
+        for (QChar &c : word)
+            c = letters[rng.bounded(letterCount)];
+        words.append(word);
+    }
+    return words;
+}
+
+enum SortMethod { Compare, SortKeys, ParallelSortKeys };
+
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("method");
+
+    for (int count : { 10000, 1000000 }) {
+        QTest::addRow("%d-std::sort", count) << count << int(Compare);
+        QTest::addRow("%d-QCollator::sort", count) << count << int(SortKeys);
+        QTest::addRow("%d-QCollator::sort-parallel", count) << count << int(ParallelSortKeys);
+    }
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(int, count);
+    QFETCH(int, method);
+
+    const QCollator collator(QLocale(QLocale::Swedish, QLocale::Sweden));
+    const QStringList words = randomWords(count);
+    QStringList sorted;
+    QBENCHMARK {
+        sorted = words;
+        switch (method) {
+        case Compare:
+            std::sort(sorted.begin(), sorted.end(), collator);
+            break;
+        case SortKeys:
+            collator.sort(sorted);
+            break;
+        case ParallelSortKeys:
+            collator.sort(sorted, QThreadPool::globalInstance());
+            break;
+        }
+    }
+}
+
+QTEST_MAIN(tst_QCollator)
+
+#include "main.moc"
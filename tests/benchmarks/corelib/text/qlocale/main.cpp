@@ -37,6 +37,20 @@ private Q_SLOTS:
     void toUpper_QLocale_1();
     void toUpper_QLocale_2();
     void toUpper_QString();
+    void numberToString_QLocale_data() { numberToString_data(); }
+    void numberToString_QLocale();
+    void numberToString_QString_data() { numberToString_data(); }
+    void numberToString_QString();
+    void numberToString_QByteArray_data() { numberToString_data(); }
+    void numberToString_QByteArray();
+    void toDouble_QLocale_data() { toDouble_data(); }
+    void toDouble_QLocale();
+    void toDouble_QByteArray_data() { toDouble_data(); }
+    void toDouble_QByteArray();
+
+private:
+    void numberToString_data();
+    void toDouble_data();
 };
 
 static QString data()
@@ -65,6 +79,95 @@ void tst_QLocale::toUpper_QString()
     QBENCHMARK { LOOP(s.toUpper()) }
 }
 
+static QList<double> numbers()
+{
+    QList<double> result;
+    result.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+        result.append((i - 500) * 1234.56789 / (i + 1));
+    return result;
+}
+
+void tst_QLocale::numberToString_data()
+{
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+
+    QTest::newRow("shortest") << 'g' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("f-2") << 'f' << 2;
+    QTest::newRow("g-6") << 'g' << 6;
+    QTest::newRow("e-17") << 'e' << 17;
+}
+
+void tst_QLocale::numberToString_QLocale()
+{
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    const QList<double> values = numbers();
+    const QLocale c = QLocale::c();
+    QBENCHMARK {
+        for (double d : values)
+            c.toString(d, format, precision);
+    }
+}
+
+void tst_QLocale::numberToString_QString()
+{
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    const QList<double> values = numbers();
+    QBENCHMARK {
+        for (double d : values)
+            QString::number(d, format, precision);
+    }
+}
+
+void tst_QLocale::numberToString_QByteArray()
+{
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    const QList<double> values = numbers();
+    QBENCHMARK {
+        for (double d : values)
+            QByteArray::number(d, format, precision);
+    }
+}
+
+void tst_QLocale::toDouble_data()
+{
+    QTest::addColumn<QByteArrayList>("strings");
+
+    QByteArrayList shortest, fixed;
+    for (double d : numbers()) {
+        shortest.append(QByteArray::number(d, 'g', QLocale::FloatingPointShortest));
+        fixed.append(QByteArray::number(d, 'f', 2));
+    }
+    QTest::newRow("shortest") << shortest;
+    QTest::newRow("f-2") << fixed;
+}
+
+void tst_QLocale::toDouble_QLocale()
+{
+    QFETCH(QByteArrayList, strings);
+    QStringList values;
+    for (const QByteArray &s : qAsConst(strings))
+        values.append(QString::fromLatin1(s));
+    const QLocale c = QLocale::c();
+    QBENCHMARK {
+        for (const QString &s : qAsConst(values))
+            c.toDouble(s);
+    }
+}
+
+void tst_QLocale::toDouble_QByteArray()
+{
+    QFETCH(QByteArrayList, strings);
+    QBENCHMARK {
+        for (const QByteArray &s : qAsConst(strings))
+            s.toDouble();
+    }
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "main.moc"
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QMultiStringMatcher>
+#include <QRandomGenerator>
+#include <QStringMatcher>
+
+#include <qtest.h>
+
+Q_DECLARE_METATYPE(Qt::CaseSensitivity)
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+    QString log;
+    QStringList keywords;
+
+    void setupKeywords(int count);
+
+private slots:
+    void initTestCase();
+
+    void indexOf_data() { matchers_data(); }
+    void indexOf();
+    void stringMatcher_data() { matchers_data(); }
+    void stringMatcher();
+    void multiStringMatcher_data() { matchers_data(); }
+    void multiStringMatcher();
+    void multiStringMatcherUtf8_data() { matchers_data(); }
+    void multiStringMatcherUtf8();
+    void construction_data() { matchers_data(); }
+    void construction();
+
+private:
+    void matchers_data();
+};
+
+// Synthesizes about 256 kB of log lines, and 200 keywords that occur in
+// some of them.
+void tst_QMultiStringMatcher::initTestCase()
+{
+    QRandomGenerator rng(42);
+    const auto word = [&rng](int minLength, int maxLength) {
+        QString w;
+        const int length = minLength + rng.bounded(maxLength - minLength + 1);
+        for (int i = 0; i < length; ++i)
+            w += QLatin1Char('a' + rng.bounded(26));
+        return w;
+    };
+
+    for (int i = 0; i < 200; ++i)
+        keywords.append(word(5, 12));
+
+    const char *levels[] = { "debug", "info", "info", "info", "warning" };
+    while (log.size() < 256 * 1024) {
+        log += QString::fromLatin1("2021-01-%1 12:%2:%3 [%4] worker %5: ")
+                .arg(1 + rng.bounded(28), 2, 10, QLatin1Char('0'))
+                .arg(rng.bounded(60), 2, 10, QLatin1Char('0'))
+                .arg(rng.bounded(60), 2, 10, QLatin1Char('0'))
+                .arg(QLatin1String(levels[rng.bounded(5)]))
+                .arg(rng.bounded(32));
+        const int words = 4 + rng.bounded(8);
+        for (int i = 0; i < words; ++i) {
+            // one line in twenty mentions a keyword, the first ones more often
+            if (i == 0 && rng.bounded(20) == 0)
+                log += keywords.at(rng.bounded(1 + rng.bounded(int(keywords.size()))));
+            else
+                log += word(2, 9);
+            log += QLatin1Char(' ');
+        }
+        log += QString::fromLatin1("in %1 ms\n").arg(rng.bounded(1000));
+    }
+}
+
+void tst_QMultiStringMatcher::matchers_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 10, 200 }) {
+        QTest::addRow("%d-cs", count) << count << Qt::CaseSensitive;
+        QTest::addRow("%d-ci", count) << count << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QMultiStringMatcher::indexOf()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QStringList patterns = keywords.mid(0, count);
+
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QString &pattern : patterns) {
+            for (qsizetype pos = log.indexOf(pattern, 0, cs); pos >= 0;
+                 pos = log.indexOf(pattern, pos + 1, cs)) {
+                ++matches;
+            }
+        }
+    }
+    QVERIFY(matches > 0);
+}
+
+void tst_QMultiStringMatcher::stringMatcher()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QList<QStringMatcher> matchers;
+    for (const QString &pattern : keywords.mid(0, count))
+        matchers.append(QStringMatcher(pattern, cs));
+
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QStringMatcher &matcher : qAsConst(matchers)) {
+            for (qsizetype pos = matcher.indexIn(QStringView(log)); pos >= 0;
+                 pos = matcher.indexIn(QStringView(log), pos + 1)) {
+                ++matches;
+            }
+        }
+    }
+    QVERIFY(matches > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcher()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QMultiStringMatcher matcher(keywords.mid(0, count), cs);
+
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = matcher.allMatches(log).size();
+    }
+    QVERIFY(matches > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcherUtf8()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QMultiStringMatcher matcher(keywords.mid(0, count), cs);
+    const QByteArray utf8 = log.toUtf8();
+
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = matcher.allMatches(utf8).size();
+    }
+    QVERIFY(matches > 0);
+}
+
+void tst_QMultiStringMatcher::construction()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QStringList patterns = keywords.mid(0, count);
+
+    QBENCHMARK {
+        QMultiStringMatcher matcher(patterns, cs);
+        Q_UNUSED(matcher);
+    }
+}
+
+QTEST_MAIN(tst_QMultiStringMatcher)
+
+#include "main.moc"
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTest>
+#include <QThreadPool>
+
+#include <QtCore/private/qregularexpression_p.h>
+
+class tst_QRegularExpression : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructAndMatch_data();
+    void constructAndMatch();
+    void matchMany_data();
+    void matchMany();
+};
+
+void tst_QRegularExpression::constructAndMatch_data()
+{
+    QTest::addColumn<int>("cacheCapacity");
+
+    QTest::newRow("no-cache") << 0;
+    QTest::newRow("cache") << 128;
+}
+
+// A filter rebuilding its QRegularExpression whenever it's used, as item
+// models and user-facing search fields tend to do
+void tst_QRegularExpression::constructAndMatch()
+{
+    QFETCH(int, cacheCapacity);
+
+    const QStringList patterns = {
+        QStringLiteral("^\\s*(\\w+)\\s*=\\s*(.*)$"),
+        QStringLiteral("\\b(?:error|warning|fatal)\\b"),
+        QStringLiteral("(\\d{4})-(\\d{2})-(\\d{2})T(\\d{2}):(\\d{2})"),
+        QStringLiteral("^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\\.[A-Za-z]{2,}$"),
+        QStringLiteral(".*\\.(?:cpp|h|hpp|cxx)$"),
+    };
+    const QString subject = QStringLiteral("2021-03-14T15:09 warning: src/corelib/text/qstring.cpp");
+
+    const qsizetype oldCapacity = QRegularExpressionCache::capacity();
+    QRegularExpressionCache::clear();
+    QRegularExpressionCache::setCapacity(cacheCapacity);
+
+    int matches = 0;
+    QBENCHMARK {
+        for (const QString &pattern : patterns) {
+            const QRegularExpression re(pattern);
+            matches += re.match(subject).hasMatch();
+        }
+    }
+    QVERIFY(matches > 0);
+
+    QRegularExpressionCache::setCapacity(oldCapacity);
+}
+
+void tst_QRegularExpression::matchMany_data()
+{
+    QTest::addColumn<int>("mode");
+
+    QTest::newRow("match") << 0;
+    QTest::newRow("matchBatch") << 1;
+    QTest::newRow("matchBatch-threadpool") << 2;
+}
+
+// Extracting a field out of each line of a log
+void tst_QRegularExpression::matchMany()
+{
+    QFETCH(int, mode);
+
+    QStringList lines;
+    for (int i = 0; i < 100000; ++i) {
+        lines.append(QStringLiteral("10.0.%1.%2 - - [14/Mar/2021:15:09:26] \"GET /index.html HTTP/1.1\" %3 %4")
+                     .arg(i % 256).arg(i % 199).arg(i % 7 ? 200 : 404).arg(i * 37 % 10000));
+    }
+    QList<QStringView> subjects(lines.begin(), lines.end());
+
+    const QRegularExpression re(QStringLiteral("\" (\\d{3}) (\\d+)$"));
+    re.optimize();
+    QList<qsizetype> starts(subjects.size() * 3);
+    QList<qsizetype> lengths(subjects.size() * 3);
+
+    qsizetype matched = 0;
+    switch (mode) {
+    case 0:
+        QBENCHMARK {
+            matched = 0;
+            for (qsizetype i = 0; i < subjects.size(); ++i) {
+                const QRegularExpressionMatch match = re.match(subjects.at(i));
+                if (match.hasMatch()) {
+                    ++matched;
+                    starts[i * 3 + 1] = match.capturedStart(1);
+                    lengths[i * 3 + 1] = match.capturedLength(1);
+                }
+            }
+        }
+        break;
+    case 1:
+        QBENCHMARK {
+            matched = re.matchBatch(subjects.constData(), subjects.size(),
+                                    starts.data(), lengths.data(), 3);
+        }
+        break;
+    case 2:
+        QBENCHMARK {
+            matched = re.matchBatch(subjects.constData(), subjects.size(),
+                                    starts.data(), lengths.data(), 3,
+                                    QRegularExpression::NoMatchOption,
+                                    QThreadPool::globalInstance());
+        }
+        break;
+    }
+    QCOMPARE(matched, subjects.size());
+}
+
+QTEST_MAIN(tst_QRegularExpression)
+
+#include "main.moc"
@@ -48,6 +48,20 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data();
+    void toUtf8();
+
+    void compareCaseInsensitive_data();
+    void compareCaseInsensitive();
+    void compareLatin1CaseInsensitive_data() { compareCaseInsensitive_data(); }
+    void compareLatin1CaseInsensitive();
+    void latin1CompareCaseInsensitive_data() { compareCaseInsensitive_data(); }
+    void latin1CompareCaseInsensitive();
+    void indexOfCaseInsensitive_data() { compareCaseInsensitive_data(); }
+    void indexOfCaseInsensitive();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -187,6 +201,142 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    // about 64 kB of text in various scripts, with the spaces and
+    // punctuation usual for each
+    const auto corpus = [](const char *sentence) {
+        const QByteArray line = QByteArray(sentence) + '\n';
+        return line.repeated(64 * 1024 / line.size());
+    };
+    QTest::newRow("ascii")
+            << corpus("The quick brown fox jumps over the lazy dog, again and again.");
+    QTest::newRow("german")
+            << corpus("Zw\xc3\xb6lf Boxk\xc3\xa4mpfer jagen Viktor quer \xc3\xbc""ber den gro\xc3\x9f""en Sylter Deich.");
+    QTest::newRow("russian")
+            << corpus("\xd0\xa1\xd1\x8a\xd0\xb5\xd1\x88\xd1\x8c \xd0\xb6\xd0\xb5 \xd0\xb5\xd1\x89\xd1\x91 "
+                      "\xd1\x8d\xd1\x82\xd0\xb8\xd1\x85 \xd0\xbc\xd1\x8f\xd0\xb3\xd0\xba\xd0\xb8\xd1\x85 "
+                      "\xd1\x84\xd1\x80\xd0\xb0\xd0\xbd\xd1\x86\xd1\x83\xd0\xb7\xd1\x81\xd0\xba\xd0\xb8\xd1\x85 "
+                      "\xd0\xb1\xd1\x83\xd0\xbb\xd0\xbe\xd0\xba, \xd0\xb4\xd0\xb0 \xd0\xb2\xd1\x8b\xd0\xbf\xd0\xb5\xd0\xb9 "
+                      "\xd0\xb6\xd0\xb5 \xd1\x87\xd0\xb0\xd1\x8e.");
+    QTest::newRow("chinese")
+            << corpus("\xe6\x88\x91\xe8\x83\xbd\xe5\x90\x9e\xe4\xb8\x8b\xe7\x8e\xbb\xe7\x92\x83"
+                      "\xe8\x80\x8c\xe4\xb8\x8d\xe4\xbc\xa4\xe8\xba\xab\xe4\xbd\x93\xe3\x80\x82");
+    QTest::newRow("japanese-ascii")
+            << corpus("Qt 6.1 \xe3\x81\xae\xe3\x83\xaa\xe3\x83\xaa\xe3\x83\xbc\xe3\x82\xb9"
+                      "\xe3\x83\x8e\xe3\x83\xbc\xe3\x83\x88 (2021) \xe3\x82\x92\xe5\x8f\x82"
+                      "\xe7\x85\xa7\xe3\x81\x97\xe3\x81\xa6\xe3\x81\x8f\xe3\x81\xa0\xe3\x81\x95"
+                      "\xe3\x81\x84\xe3\x80\x82");
+    QTest::newRow("emoji")
+            << corpus("Release \xf0\x9f\x9a\x80 done \xf0\x9f\x8e\x89\xf0\x9f\x8e\x89 thanks \xf0\x9f\x99\x8f");
+}
+
+void tst_QString::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        QString::fromUtf8(utf8);
+    }
+}
+
+void tst_QString::toUtf8_data()
+{
+    fromUtf8_data();
+}
+
+void tst_QString::toUtf8()
+{
+    QFETCH(QByteArray, utf8);
+    const QString s = QString::fromUtf8(utf8);
+
+    QBENCHMARK {
+        s.toUtf8();
+    }
+}
+
+void tst_QString::compareCaseInsensitive_data()
+{
+    QTest::addColumn<QString>("lhs");
+    QTest::addColumn<QString>("rhs");
+
+    // pairs of strings that are equal, ignoring case
+    const auto addRow = [](const char *name, const QString &text) {
+        QTest::newRow(name) << text << text.toLower();
+    };
+    addRow("header-name", QStringLiteral("Content-Type"));
+    addRow("header-value", QStringLiteral("Application/JSON; Charset=UTF-8"));
+    addRow("ascii-1k", QStringLiteral("The Quick Brown Fox Jumps Over The Lazy Dog. ").repeated(22));
+    addRow("german-1k", QStringLiteral("Zw\u00f6lf Boxk\u00e4mpfer jagen Viktor quer \u00fcber den Sylter Deich. ").repeated(18));
+    addRow("russian-1k", QStringLiteral("\u0421\u044a\u0435\u0448\u044c \u0436\u0435 \u0435\u0449\u0451 "
+                                        "\u044d\u0442\u0438\u0445 \u041c\u044f\u0433\u043a\u0438\u0445 "
+                                        "\u0424\u0440\u0430\u043d\u0446\u0443\u0437\u0441\u043a\u0438\u0445 "
+                                        "\u0411\u0443\u043b\u043e\u043a. ").repeated(20));
+}
+
+void tst_QString::compareCaseInsensitive()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+
+    int result = -1;
+    QBENCHMARK {
+        result = lhs.compare(rhs, Qt::CaseInsensitive);
+    }
+    QCOMPARE(result, 0);
+}
+
+void tst_QString::compareLatin1CaseInsensitive()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+    const QByteArray latin1 = rhs.toLatin1();
+    if (QString::fromLatin1(latin1) != rhs)
+        QSKIP("Not representable in Latin-1");
+    const QLatin1String rhsLatin1(latin1);
+
+    int result = -1;
+    QBENCHMARK {
+        result = lhs.compare(rhsLatin1, Qt::CaseInsensitive);
+    }
+    QCOMPARE(result, 0);
+}
+
+void tst_QString::latin1CompareCaseInsensitive()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+    const QByteArray lhsData = lhs.toLatin1();
+    const QByteArray rhsData = rhs.toLatin1();
+    if (QString::fromLatin1(lhsData) != lhs)
+        QSKIP("Not representable in Latin-1");
+    const QLatin1String lhsLatin1(lhsData);
+    const QLatin1String rhsLatin1(rhsData);
+
+    int result = -1;
+    QBENCHMARK {
+        result = lhsLatin1.compare(rhsLatin1, Qt::CaseInsensitive);
+    }
+    QCOMPARE(result, 0);
+}
+
+void tst_QString::indexOfCaseInsensitive()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+    // find a short lowercase needle at the end of 64 copies of the original
+    const QString needle = QLatin1Char('|') + rhs.left(12);
+    const QString haystack = lhs.repeated(64) + needle + QLatin1Char('|');
+
+    qsizetype result = -1;
+    QBENCHMARK {
+        result = haystack.indexOf(needle, 0, Qt::CaseInsensitive);
+    }
+    QCOMPARE(result, haystack.size() - needle.size() - 1);
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
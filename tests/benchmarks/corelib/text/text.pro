@@ -2,7 +2,10 @@ TEMPLATE = subdirs
 SUBDIRS = \
         qbytearray \
         qchar \
+        qcollator \
         qlocale \
+        qmultistringmatcher \
+        qregularexpression \
         qstringbuilder \
         qstringlist
 
@@ -40,6 +40,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void fineGrainedTasks_data();
+    void fineGrainedTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +77,43 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::fineGrainedTasks_data()
+{
+    QTest::addColumn<bool>("workStealing");
+    QTest::addColumn<int>("depth");
+
+    for (int depth : { 10, 16 }) {
+        QTest::addRow("shared queue, %d tasks", (2 << depth) - 1) << false << depth;
+        QTest::addRow("work stealing, %d tasks", (2 << depth) - 1) << true << depth;
+    }
+}
+
+void tst_QThreadPool::fineGrainedTasks()
+{
+    QFETCH(bool, workStealing);
+    QFETCH(int, depth);
+
+    QThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    // every task starts two more from within the pool, like a recursive
+    // divide and conquer algorithm would
+    QAtomicInt count;
+    std::function<void(int)> fork = [&](int level) {
+        count.ref();
+        if (level == 0)
+            return;
+        threadPool.start([&fork, level] { fork(level - 1); });
+        threadPool.start([&fork, level] { fork(level - 1); });
+    };
+
+    QBENCHMARK {
+        count.storeRelaxed(0);
+        threadPool.start([&fork, depth] { fork(depth); });
+        threadPool.waitForDone();
+    }
+    QCOMPARE(count.loadRelaxed(), (2 << depth) - 1);
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
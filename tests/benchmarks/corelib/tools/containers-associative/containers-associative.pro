@@ -1,6 +1,6 @@
 TEMPLATE = app
 CONFIG += benchmark
-QT = core testlib
+QT = core-private testlib
 
 TARGET = tst_bench_containers-associative
 SOURCES += main.cpp
@@ -26,9 +26,12 @@
 **
 ****************************************************************************/
 #include <QString>
+#include <private/qflathash_p.h>
 
 #include <qtest.h>
 
+#include <unordered_map>
+
 class tst_associative_containers : public QObject
 {
     Q_OBJECT
@@ -37,6 +40,10 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void largeInsert_data();
+    void largeInsert();
+    void largeLookup_data();
+    void largeLookup();
 };
 
 template <typename T>
@@ -125,5 +132,159 @@ void tst_associative_containers::lookup()
     }
 }
 
+enum Container { Hash, FlatHash, StdUnorderedMap };
+
+static void largeData()
+{
+    QTest::addColumn<int>("container");
+    QTest::addColumn<bool>("stringKeys");
+    QTest::addColumn<int>("size");
+
+    const struct {
+        Container container;
+        const char *name;
+    } containers[] = {
+        { Hash, "QHash" },
+        { FlatHash, "QFlatHash" },
+        { StdUnorderedMap, "std::unordered_map" }
+    };
+
+    // string keys take about 100 bytes each, so don't go beyond 10M of them
+    for (int size : { 1000000, 10000000, 100000000 }) {
+        for (bool stringKeys : { false, true }) {
+            if (stringKeys && size > 10000000)
+                continue;
+            for (const auto &c : containers) {
+                QTest::addRow("%s-%s-%dM", c.name, stringKeys ? "string" : "int", size / 1000000)
+                        << int(c.container) << stringKeys << size;
+            }
+        }
+    }
+}
+
+template <typename Key> Key makeKey(int i);
+template <> int makeKey<int>(int i) { return i; }
+template <> QString makeKey<QString>(int i) { return QLatin1String("key-") + QString::number(i); }
+
+template <typename Key>
+static std::vector<Key> makeKeys(int size)
+{
+    std::vector<Key> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.push_back(makeKey<Key>(i));
+    return keys;
+}
+
+// a fixed pseudo-random sample of the keys, large enough to defeat the caches
+template <typename Key>
+static std::vector<Key> sampleKeys(const std::vector<Key> &keys)
+{
+    std::vector<Key> sample;
+    const size_t sampleSize = qMin(keys.size(), size_t(1000000));
+    sample.reserve(sampleSize);
+    quint32 state = 1;
+    for (size_t i = 0; i < sampleSize; ++i) {
+        state = state * 1103515245 + 12345;
+        sample.push_back(keys[(quint64(state) * keys.size()) >> 32]);
+    }
+    return sample;
+}
+
+template <typename T, typename Key>
+static void testLargeInsert(const std::vector<Key> &keys)
+{
+    QBENCHMARK {
+        T container;
+        for (size_t i = 0; i < keys.size(); ++i)
+            container[keys[i]] = int(i);
+    }
+}
+
+template <typename T, typename Key>
+static void testLargeLookup(const std::vector<Key> &keys)
+{
+    T container;
+    for (size_t i = 0; i < keys.size(); ++i)
+        container[keys[i]] = int(i);
+    const std::vector<Key> sample = sampleKeys(keys);
+
+    const T &c = container;
+    size_t found = 0;
+    QBENCHMARK {
+        for (const Key &key : sample)
+            found += c.find(key) != c.end();
+    }
+    QCOMPARE(found % sample.size(), size_t(0));
+}
+
+template <typename Key>
+static void runLargeInsert(Container container, int size)
+{
+    const std::vector<Key> keys = makeKeys<Key>(size);
+    switch (container) {
+    case Hash:
+        testLargeInsert<QHash<Key, int>>(keys);
+        break;
+    case FlatHash:
+        testLargeInsert<QFlatHash<Key, int>>(keys);
+        break;
+    case StdUnorderedMap:
+        testLargeInsert<std::unordered_map<Key, int>>(keys);
+        break;
+    }
+}
+
+template <typename Key>
+static void runLargeLookup(Container container, int size)
+{
+    const std::vector<Key> keys = makeKeys<Key>(size);
+    switch (container) {
+    case Hash:
+        testLargeLookup<QHash<Key, int>>(keys);
+        break;
+    case FlatHash:
+        testLargeLookup<QFlatHash<Key, int>>(keys);
+        break;
+    case StdUnorderedMap:
+        testLargeLookup<std::unordered_map<Key, int>>(keys);
+        break;
+    }
+}
+
+void tst_associative_containers::largeInsert_data()
+{
+    largeData();
+}
+
+void tst_associative_containers::largeInsert()
+{
+    QFETCH(int, container);
+    QFETCH(bool, stringKeys);
+    QFETCH(int, size);
+
+    if (stringKeys)
+        runLargeInsert<QString>(Container(container), size);
+    else
+        runLargeInsert<int>(Container(container), size);
+}
+
+void tst_associative_containers::largeLookup_data()
+{
+    largeData();
+}
+
+void tst_associative_containers::largeLookup()
+{
+    QFETCH(int, container);
+    QFETCH(bool, stringKeys);
+    QFETCH(int, size);
+
+    if (stringKeys)
+        runLargeLookup<QString>(Container(container), size);
+    else
+        runLargeLookup<int>(Container(container), size);
+}
+
 QTEST_MAIN(tst_associative_containers)
 #include "main.moc"
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qflatmap_p.h>
+#include <qbytearray.h>
+#include <qstring.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QString>
+#include <QTest>
+#include <QThread>
+#include <private/qconcurrenthash_p.h>
+
+#include <memory>
+#include <vector>
+
+// a cache shared by all threads, read nine times as often as written
+enum { KeyCount = 100000, TotalOperations = 2000000 };
+
+class MutexHash
+{
+public:
+    QString value(int key) const
+    {
+        QMutexLocker locker(&mutex);
+        return hash.value(key);
+    }
+    void insert(int key, const QString &value)
+    {
+        QMutexLocker locker(&mutex);
+        hash.insert(key, value);
+    }
+
+private:
+    mutable QMutex mutex;
+    QHash<int, QString> hash;
+};
+
+class ReadWriteLockHash
+{
+public:
+    QString value(int key) const
+    {
+        QReadLocker locker(&lock);
+        return hash.value(key);
+    }
+    void insert(int key, const QString &value)
+    {
+        QWriteLocker locker(&lock);
+        hash.insert(key, value);
+    }
+
+private:
+    mutable QReadWriteLock lock;
+    QHash<int, QString> hash;
+};
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readMostly_data();
+    void readMostly();
+};
+
+enum Container { Concurrent, Mutex, ReadWriteLock };
+
+void tst_QConcurrentHash::readMostly_data()
+{
+    QTest::addColumn<int>("container");
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2) {
+        QTest::addRow("QConcurrentHash-%d", threadCount) << int(Concurrent) << threadCount;
+        QTest::addRow("QMutex-%d", threadCount) << int(Mutex) << threadCount;
+        QTest::addRow("QReadWriteLock-%d", threadCount) << int(ReadWriteLock) << threadCount;
+    }
+}
+
+template <typename Hash>
+static void runReadMostly(int threadCount)
+{
+    Hash hash;
+    std::vector<QString> values;
+    values.reserve(KeyCount);
+    for (int i = 0; i < KeyCount; ++i) {
+        values.push_back(QString::number(i));
+        hash.insert(i, values.back());
+    }
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(QThread::create([&hash, &values, t, threadCount]() {
+                quint32 state = quint32(t) + 1;
+                for (int i = 0; i < TotalOperations / threadCount; ++i) {
+                    state = state * 1103515245 + 12345;
+                    const int key = int((state >> 8) % KeyCount);
+                    if (state % 10 == 0)
+                        hash.insert(key, values[key]);
+                    else
+                        hash.value(key);
+                }
+            }));
+            threads.back()->start();
+        }
+        for (auto &thread : threads)
+            thread->wait();
+    }
+}
+
+void tst_QConcurrentHash::readMostly()
+{
+    QFETCH(int, container);
+    QFETCH(int, threadCount);
+
+    switch (Container(container)) {
+    case Concurrent:
+        runReadMostly<QConcurrentHash<int, QString>>(threadCount);
+        break;
+    case Mutex:
+        runReadMostly<MutexHash>(threadCount);
+        break;
+    case ReadWriteLock:
+        runReadMostly<ReadWriteLockHash>(threadCount);
+        break;
+    }
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+#include "main.moc"
@@ -0,0 +1,5 @@
+CONFIG += benchmark
+QT = core-private testlib
+
+TARGET = tst_bench_qconcurrenthash
+SOURCES += main.cpp